@@ -13,6 +13,10 @@
 // ------------------------- Dependencies ------------------------- //
 
 #include "Player.h"
+#include "TranspositionTable.h"
+#include "Network.h"
+#include "Book.h"
+#include "Tablebase.h"
 
 // ------------------------- Types ------------------------- //
 
@@ -45,6 +49,13 @@ typedef struct
     
     Difficulty difficulty;     ///< AIs difficulty
 
+    TranspositionTable* table; ///< Positions searched so far this game, NULL for none
+    Network* network;          ///< Network to evaluate with, NULL for the hand written evaluation
+    Book* book;                ///< Opening book to play from, NULL for none
+    Tablebase* tablebase;      ///< Endgame tables to play and search with, NULL for none
+
+    uint64_t random;           ///< State of the xorshift generator behind the AI's random choices, never zero
+
 } AI;
 
 // ------------------------- Functions ------------------------- //
@@ -64,6 +75,36 @@ void SetDifficulty(AI* const ai, const Difficulty difficulty);
 /// Sets the player of the AI
 void SetAIPlayer(AI* const ai, const Player* const player);
 
+/// Returns the transposition table of the AI
+TranspositionTable* GetAITable(const AI* const ai);
+
+/// Sets the transposition table of the AI
+void SetAITable(AI* const ai, TranspositionTable* const table);
+
+/// Returns the network of the AI
+Network* GetAINetwork(const AI* const ai);
+
+/// Sets the network of the AI
+void SetAINetwork(AI* const ai, Network* const network);
+
+/// Returns the opening book of the AI
+Book* GetAIBook(const AI* const ai);
+
+/// Sets the opening book of the AI
+void SetAIBook(AI* const ai, Book* const book);
+
+/// Returns the endgame tables of the AI
+Tablebase* GetAITablebase(const AI* const ai);
+
+/// Sets the endgame tables of the AI
+void SetAITablebase(AI* const ai, Tablebase* const tablebase);
+
+/// Restarts the random choices of the AI from a seed
+void SeedAI(AI* const ai, const uint64_t seed);
+
+/// Gets the next random number of the AI
+uint64_t NextAIRandom(AI* const ai);
+
 #endif
 
 // EOF //
@@ -14,26 +14,27 @@
 
 #include "AI.h"
 #include "GameData.h"
+#include "Search.h"
 
 // ---------------------- Piece Values ----------------------- //
 
-/// Value for the King
-#define KINGVAL 100
+/// Value for the King in centipawns, more than every other piece together
+#define KINGVAL 10000
 
-/// Value for the Queen
-#define QUEENVAL 9
+/// Value for the Queen in centipawns
+#define QUEENVAL 900
 
-/// Value for the BISHOP
-#define BISHOPVAL 3
+/// Value for the BISHOP in centipawns
+#define BISHOPVAL 300
 
-/// Value for the Knight
-#define KNIGHTVAL 3
+/// Value for the Knight in centipawns
+#define KNIGHTVAL 300
 
-/// Value for the ROOK
-#define ROOKVAL 5
+/// Value for the ROOK in centipawns
+#define ROOKVAL 500
 
-/// Value for the Pawn
-#define PAWNVAL 1
+/// Value for the Pawn in centipawns
+#define PAWNVAL 100
 
 // ----------------------------- Types ------------------------- //
 
@@ -50,20 +51,56 @@ typedef struct
 
 } RankedMove;
 
+/*!
+ * \brief Search run on the player's time
+ * \details While the player thinks a thread searches the position after the reply the AI expects, filling the AI's table
+ * If the player makes that reply the result can be played right away, otherwise only what it left in the table is kept
+ */
+typedef struct
+{
+
+    pthread_t thread;            ///< Thread running the search
+    bool running;                ///< True from StartPonder until StopPonder
+    bool stop;                   ///< Set to stop the search
+
+    Position position[1];        ///< Position after the expected reply, the AI is to move
+    SearchLimits limits;         ///< Limits of the search, the budget along with the stop flag
+    SearchLimits budget;         ///< Normal budget of the AI, the result has to reach it without going past it to be played
+    TranspositionTable* table;   ///< Table of the AI
+
+    SearchResult result;         ///< Deepest finished iteration once stopped
+
+} Ponder;
+
 // ------------------------- Functions ------------------------- //
 
 /// Generates the best move for the AI based off the possible moves
-Move GenerateBestMove(const GameData* const data, const AI* const ai);
+Move GenerateBestMove(const GameData* const data, AI* const ai);
+
+/// Generates the best move for the AI, using the pondered move if the player played the expected reply
+Move GeneratePonderedMove(const GameData* const data, AI* const ai, const Ponder* const ponder);
+
+/// Starts searching the expected reply on the player's time
+bool StartPonder(Ponder* const ponder, const GameData* const data, AI* const ai);
 
-/// Calculates max value and best possible move for white
-uint32_t Max(const GameData* const data, const AI* const ai);
+/// Stops pondering
+void StopPonder(Ponder* const ponder);
 
-// Calculates min value and best possible move for min
-uint32_t Min(const GameData* const data, const AI* const ai);
+/// Generates the best move for the AI within the given budget
+Move GenerateLimitedMove(const GameData* const data, const AI* const ai, const SearchLimits limits);
 
-// evaluates total score for each of pieces
+/// Searches the best few moves for the AI, each with its own line and score
+uint8_t GenerateTopMoves(const GameData* const data, const AI* const ai, const uint8_t count, const SearchLimits limits, SearchResult* const lines);
+
+/// Gets the search budget for the difficulty of the AI
+SearchLimits GetSearchLimits(const AI* const ai);
+
+/// Evaluates the game for white in pawns
 double Evaluate(const GameData* const data);
 
+/// Evaluates the position for the side to move in centipawns
+int32_t EvaluatePosition(const Position* const position);
+
 // Determines and returns the predetermined values for each of the pieces on each team
 uint32_t GetPieceValue(const Piece piece);
 
@@ -0,0 +1,97 @@
+/*!
+ * \file Analysis.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the Analysis Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Search.h"
+#include "Settings.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Longest EPD or FEN line that is read, longer lines are reported as invalid
+#define ANALYSIS_LINE_MAX 1024
+
+/// Most moves a bm or am operation can list
+#define ANALYSIS_MAX_MOVES 16
+
+/// Longest id operation that is kept, longer ones are cut
+#define ANALYSIS_ID_MAX 64
+
+/// Longest record written for one position
+#define ANALYSIS_RECORD_MAX 512
+
+/// Milliseconds each position gets when neither a depth nor a time is given
+#define ANALYSIS_DEFAULT_TIME 1000
+
+// ------------------------- Types ------------------------- //
+
+/// Format the results are written in
+typedef enum
+{
+
+    AnalysisCSV,    ///< Comma separated values with a header line
+    AnalysisJSON    ///< One JSON object per line
+
+} AnalysisFormat;
+
+/*!
+ * \brief One line of an EPD file
+ * \details A FEN line is read the same way, it just has no operations
+ */
+typedef struct
+{
+
+    Position position[1];                ///< Position to analyze
+
+    char id[ANALYSIS_ID_MAX];            ///< Name from the id operation, empty if there is none
+
+    Move best[ANALYSIS_MAX_MOVES];       ///< Moves of the bm operation, one of them has to be found
+    uint8_t bestcount;                   ///< Number of bm moves
+    Move avoid[ANALYSIS_MAX_MOVES];      ///< Moves of the am operation, none of them may be played
+    uint8_t avoidcount;                  ///< Number of am moves
+
+} EPDLine;
+
+/*!
+ * \brief A batch analysis shared by its workers
+ * \details Each worker takes the next line of the input under the lock, searches it with its own table
+ * and writes its record under the lock as soon as it is done, so the records come out in the order they finish
+ */
+typedef struct
+{
+
+    FILE* input;                 ///< EPD or FEN lines
+    FILE* output;                ///< Records of each position
+    AnalysisFormat format;       ///< Format of the records
+    SearchLimits limits;         ///< Budget of each position, one thread each
+    size_t hash;                 ///< Table size of each worker in MB
+
+    pthread_mutex_t lock;        ///< Guards the files and the counters
+    size_t lines;                ///< Lines read so far, the number of a line is its place in the file
+    size_t positions;            ///< Positions analyzed
+    size_t passed;               ///< Positions whose bm or am test passed
+    size_t failed;               ///< Positions whose bm or am test failed
+    size_t invalid;              ///< Lines that weren't a legal position
+
+} Analysis;
+
+// ------------------------- Functions ------------------------- //
+
+/// Reads a line of an EPD or FEN file
+bool ParseEPDLine(const char* const line, EPDLine* const epd);
+
+/// Analyzes every position of a file on every core and writes a record for each
+bool RunAnalysis(const Settings* const settings, const char* const input, const char* const output, const AnalysisFormat format, const SearchLimits limits);
+
+#endif
+
+// EOF //
@@ -0,0 +1,53 @@
+/*!
+ * \file Bench.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes for the Bench Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Search.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Depth the scaling bench searches to when none is given
+#define BENCH_SCALING_DEPTH 9
+
+/// Depth the pruning bench searches to when none is given
+#define BENCH_PRUNING_DEPTH 8
+
+/// Size of the table each bench run gets in MB
+#define BENCH_TABLE_MB 64
+
+/// Depth the perft check counts to when none is given
+#define BENCH_PERFT_DEPTH 4
+
+/// Deepest perft count the check knows for every position
+#define BENCH_PERFT_MAX 5
+
+// ------------------------- Functions ------------------------- //
+
+/// Prints the time to depth of the bench positions from 1 to 32 threads
+void RunScalingBench(FILE* const file, const uint8_t depth);
+
+/// Prints the nodes and time to depth of the bench positions with each pruning technique on and off
+void RunPruningBench(FILE* const file, const uint8_t depth);
+
+/// Counts the leaf nodes of the perft positions and checks them and the move notation against known values
+bool RunPerftCheck(FILE* const file, const uint8_t depth);
+
+/// Checks the book keys of the Polyglot test positions against the keys the format publishes
+bool RunBookKeyCheck(FILE* const file);
+
+/// Generates the checked endgame tables into a directory and checks every entry and their longest distances
+bool RunTablebaseCheck(FILE* const file, const char* const directory, const uint8_t threads);
+
+#endif
+
+// EOF //
@@ -145,6 +145,23 @@
 /// Type for pieces
 typedef uint16_t Piece;
 
+/*!
+ * \brief Piece type enum
+ * \details Dense numbering of the piece IDs used to index per piece tables
+ */
+typedef enum
+{
+
+    PawnType = 0,
+    KnightType = 1,
+    BishopType = 2,
+    RookType = 3,
+    QueenType = 4,
+    KingType = 5,
+    NoType = 6
+
+} PieceType;
+
 /// Index type for accessing the board elements
 typedef uint8_t Index;
 
@@ -161,6 +178,11 @@ typedef struct
 
 } Board;
 
+// ------------------------- Tables ------------------------- //
+
+/// Dense type of every piece ID, NoType for anything that isn't a piece
+extern const uint8_t IDTypes[128];
+
 // ------------------------- FUNCTIONS ------------------------- //
 
 /// Generates a default board
@@ -199,6 +221,9 @@ uint8_t GetPieceID(const Piece piece);
 /// Gets the piece Number
 uint8_t GetPieceNumber(const Piece piece);
 
+/// Gets the piece ID for a dense type
+uint8_t GetTypeID(const PieceType type);
+
 /// Returns row number
 uint8_t GetRow(const Index index);
 
@@ -214,6 +239,19 @@ void PromptWhereTo();
 /// Creates a piece with ID and number
 Piece CreatePiece(bool isWhite, uint8_t PieceID, uint8_t PieceNum);
 
+/*!
+ * \brief Gets the dense type of a piece
+ * \details Inlined so the movegen and make/unmake paths get a single table load
+ * \param piece: Piece to get the type of
+ * \returns PieceType: Type of the piece, NoType if empty
+ */
+static inline PieceType GetPieceType(const Piece piece)
+{
+
+    return (PieceType)IDTypes[(piece >> 1) & 0x7f];
+
+}
+
 #endif
 
 // EOF //
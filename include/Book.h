@@ -0,0 +1,60 @@
+/*!
+ * \file Book.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the Book Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef BOOK_H
+#define BOOK_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Position.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Bytes in each entry of a book file, a big endian key, move, weight and learn value
+#define BOOK_ENTRY_SIZE 16
+
+/// Most moves a single position can have in the book
+#define BOOK_MAX_MOVES 64
+
+/// Polyglot key of the starting position, published with the format
+#define BOOK_START_KEY 0x463B96181691FC9Cull
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief Opening book mapped straight from its file
+ * \details Entries use the Polyglot layout and are sorted by key so a position is found with a binary search
+ * Nothing is read until a position is looked up, the pages that are never touched never leave the disk
+ */
+typedef struct
+{
+
+    const uint8_t* entries;      ///< Mapped entries of the file
+    size_t count;                ///< Number of entries
+    size_t size;                 ///< Bytes mapped
+
+} Book;
+
+// ------------------------- Functions ------------------------- //
+
+/// Maps a book file
+Book* CreateBook(const char* const path);
+
+/// Unmaps a book
+void DeleteBook(Book* const book);
+
+/// Gets the key a position is stored under in a book
+uint64_t GetBookKey(const Position* const position);
+
+/// Picks one of the book moves of a position by weight
+bool ProbeBook(const Book* const book, Position* const position, const uint64_t random, Move* const move);
+
+#endif
+
+// EOF //
@@ -53,6 +53,9 @@ bool IsInStalemate(const GameData* const data, Player* const player);
 /// Checks if there is enough material to win
 bool IsLackOfMaterial(Player* const player);
 
+/// Checks if the game has reached the endgame
+bool IsEndgame(const GameData* const data);
+
 /// Returns the number of valid moves
 uint32_t GetNumberOfValidMoves(const GameData* const data, Player* const player);
 
@@ -0,0 +1,89 @@
+/*!
+ * \file MoveOrder.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the MoveOrder Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef MOVEORDER_H
+#define MOVEORDER_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Position.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Plies that keep their own killer moves
+#define ORDER_MAX_PLY 64
+
+/// Killer moves kept for each ply
+#define ORDER_KILLERS 2
+
+/// History scores stay between plus and minus this
+#define HISTORY_MAX 16384
+
+// ------------------------- Scores ------------------------- //
+
+/// Score of the move stored in the table, always searched first
+#define ORDER_HASH_SCORE 1000000000
+
+/// Base score of captures and queen promotions, the MVV-LVA score is added on top
+#define ORDER_CAPTURE_SCORE 100000000
+
+/// Score of the first killer move, the second one scores one less
+#define ORDER_KILLER_SCORE 90000000
+
+/// Score of the move that last refuted the opponent's move
+#define ORDER_COUNTER_SCORE 80000000
+
+/// Base score of captures that lose material by exchange, searched after the quiet moves
+#define ORDER_LOSING_SCORE -50000000
+
+/// Score of promotions to anything but a queen, searched after every other move
+#define ORDER_UNDERPROMOTION_SCORE -100000000
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief What the search has learned about which moves cause cutoffs
+ * \details Killers are quiet moves that caused a cutoff at the same ply, history scores quiet moves by side, start and end
+ * and the counter moves are the quiet moves that last refuted each start and end of the previous move
+ */
+typedef struct
+{
+
+    Move killers[ORDER_MAX_PLY][ORDER_KILLERS];  ///< Quiet moves that caused a cutoff at each ply, newest first
+    int32_t history[2][64][64];                  ///< Butterfly history indexed by the side, start and end of quiet moves
+    Move counters[64][64];                       ///< Refutation of each start and end of the previous move
+
+} MoveOrder;
+
+// ------------------------- Functions ------------------------- //
+
+/// Forgets everything learned by earlier searches
+void ClearMoveOrder(MoveOrder* const order);
+
+/// Checks if two moves have the same squares and promotion
+bool IsSameMove(const Move first, const Move second);
+
+/// Checks if a move is neither a capture nor a promotion
+bool IsQuietMove(const Position* const position, const Move move);
+
+/// Gives every move in the list a score to be picked by
+void ScoreMoves(const MoveOrder* const order, const Position* const position, PositionMoveList* const list, const Move hashmove, const Move previous, const uint8_t ply);
+
+/// Moves the best scored move left at the index to the index and returns it
+Move PickMove(PositionMoveList* const list, const size_t index);
+
+/// Gets the material won by the capture once every exchange on its square is played out
+int32_t StaticExchangeEval(const Position* const position, const Move move);
+
+/// Rewards a quiet move that caused a cutoff and punishes the quiet moves tried before it
+void UpdateMoveOrder(MoveOrder* const order, const Position* const position, const Move best, const Move previous, const uint8_t ply, const uint8_t depth, const Move* const quiets, const size_t count);
+
+#endif
+
+// EOF //
@@ -13,15 +13,37 @@
 // ------------------------- Dependencies ------------------------- //
 
 #include "GameData.h"
+#include "ThreadPool.h"
 #include "main.h"
 
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief A move check running on the thread pool
+ * \details Holds its own copy of the game since checking a move plays it on the board, so checks can run side by side
+ */
+typedef struct
+{
+
+    GameData data;          ///< Copy of the game the move is checked in
+    Player* player;         ///< Player making the move, points into the copy
+    Move move;              ///< Move to check
+    bool valid;             ///< If the move is valid, set once the task is done
+
+    Task task;              ///< Pool task doing the check
+
+} CheckMove;
+
 // ------------------------- Functions ------------------------- //
 
 /// Sees if the move is valid
 bool IsValidMove(const GameData* const data, const Player* const player, const Move move);
 
-/// Move checker for threading
-void CreateCheckMoveThread(pthread_t* const thread, const GameData* const data, Player* const player, const Move move);
+/// Starts checking a move on the thread pool
+void SubmitCheckMove(CheckMove* const check, const GameData* const data, const Player* const player, const Move move);
+
+/// Waits for a move check and gets if the move is valid
+bool WaitCheckMove(CheckMove* const check);
 
 #endif
 
@@ -28,6 +28,8 @@ typedef struct
     Index start;    ///< Starting location of the piece
     Index end;      ///< Ending location of the piece
 
+    uint8_t promotion;     ///< Piece ID a pawn promotes to, EMPTY to ask the player
+
 } Move;
 
 /*!
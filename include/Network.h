@@ -0,0 +1,96 @@
+/*!
+ * \file Network.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the Network Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef NETWORK_H
+#define NETWORK_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Position.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Inputs of each half of the first layer, one per king square, piece type other than the king, relative color and square
+#define NETWORK_FEATURES (64 * 10 * 64)
+
+/// Neurons of each half of the first layer, a multiple of 32 so every vector loop comes out even
+#define NETWORK_HIDDEN 64
+
+/// Neurons of the second layer
+#define NETWORK_L2 32
+
+/// Largest value a clipped neuron can have
+#define NETWORK_CLIP 127
+
+/// Right shift that brings the second layer back to the scale of its inputs
+#define NETWORK_SHIFT 6
+
+/// The output divided by this is the score in centipawns
+#define NETWORK_SCALE 16
+
+/// First four bytes of a weights file
+#define NETWORK_MAGIC "UCNN"
+
+/// Version of the weights file format
+#define NETWORK_VERSION 1
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief First layer of the network for both sides
+ * \details Each half is the sum of the first layer weights of the active features seen from that side, indexed by color
+ * Moves only add and subtract the weights of the pieces that changed so the sum never has to be rebuilt unless a king moves
+ */
+typedef struct
+{
+
+    int16_t values[2][NETWORK_HIDDEN] __attribute__((aligned(32)));     ///< Sums of each side
+
+} Accumulator;
+
+/*!
+ * \brief Quantized weights of a HalfKP style network
+ * \details The first layer is int16, the rest are int8 with int32 biases
+ * Inputs are features relative to each side's king, the two halves are clipped and fed to the second layer with the side to move first
+ */
+typedef struct
+{
+
+    int16_t* features;                                                  ///< First layer weights, NETWORK_HIDDEN per feature
+    int16_t biases[NETWORK_HIDDEN] __attribute__((aligned(32)));        ///< First layer biases
+
+    int8_t hidden[NETWORK_L2][2 * NETWORK_HIDDEN] __attribute__((aligned(32)));  ///< Second layer weights
+    int32_t hiddenbiases[NETWORK_L2];                                   ///< Second layer biases
+
+    int8_t output[NETWORK_L2] __attribute__((aligned(32)));             ///< Output weights
+    int32_t outputbias;                                                 ///< Output bias
+
+} Network;
+
+// ------------------------- Functions ------------------------- //
+
+/// Loads a network from a weights file
+Network* CreateNetwork(const char* const path);
+
+/// Deletes a network
+void DeleteNetwork(Network* const network);
+
+/// Builds the accumulator of a position from scratch
+void RefreshAccumulator(const Network* const network, const Position* const position, Accumulator* const accumulator);
+
+/// Builds the accumulator after a move from the one before it
+void UpdateAccumulator(const Network* const network, const Position* const position, const Move move, const PositionUndo* const undo,
+    const Accumulator* const before, Accumulator* const after);
+
+/// Evaluates a position from its accumulator
+int32_t EvaluateNetwork(const Network* const network, const Accumulator* const accumulator, const bool isWhite);
+
+#endif
+
+// EOF //
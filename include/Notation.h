@@ -0,0 +1,44 @@
+/*!
+ * \file Notation.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the Notation Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef NOTATION_H
+#define NOTATION_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Position.h"
+
+// ------------------------- Sizes ------------------------- //
+
+/// Longest UCI move plus the terminator, eg "e7e8q"
+#define UCI_LENGTH 6
+
+/// Longest SAN move plus the terminator, eg "Qa1xb2+" or "exd8=Q#"
+#define SAN_LENGTH 8
+
+// ------------------------- Functions ------------------------- //
+
+/// Writes a move in UCI coordinate notation, returns the length
+uint8_t MoveToUCI(const Move move, char str[UCI_LENGTH]);
+
+/// Reads a UCI coordinate move, the piece is EMPTY if it isn't legal
+Move UCIToMove(Position* const position, const PositionMoveList* const legal, const char* const str);
+
+/// Writes a legal move in standard algebraic notation, returns the length
+uint8_t MoveToSAN(Position* const position, const PositionMoveList* const legal, const Move move, char str[SAN_LENGTH]);
+
+/// Reads a standard algebraic notation move, the piece is EMPTY if it isn't legal or is ambiguous
+Move SANToMove(Position* const position, const PositionMoveList* const legal, const char* const str);
+
+/// Print the movestack in standard algebraic notation to a file
+void fprintsanmovestack(FILE* const file, const MoveStack* const stack);
+
+#endif
+
+// EOF //
@@ -0,0 +1,68 @@
+/*!
+ * \file PawnTable.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the PawnTable Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef PAWNTABLE_H
+#define PAWNTABLE_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Position.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Entries in the pawn table of each thread, must be a power of two
+#define PAWN_TABLE_SIZE 4096
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief What is known about one pawn skeleton
+ * \details Only depends on the pawns so it stays valid for every position with the same pawn key
+ */
+typedef struct
+{
+
+    uint64_t key;                ///< Pawn key of the skeleton
+    int16_t midgame;             ///< Doubled, isolated, backward and passed pawn terms for white minus black
+    int16_t endgame;             ///< Same terms with their endgame weights
+    Bitboard passed[2];          ///< Passed pawns of each color
+
+} PawnEntry;
+
+/*!
+ * \brief Cache of pawn skeletons indexed by the pawn key
+ * \details Each thread has its own so nothing is shared or locked, a new skeleton always replaces the old one
+ */
+typedef struct
+{
+
+    PawnEntry entries[PAWN_TABLE_SIZE];      ///< Skeletons by the low bits of their key
+
+    uint64_t probes;                         ///< Lookups made
+    uint64_t hits;                           ///< Lookups that skipped the analysis
+
+} PawnTable;
+
+// ------------------------- Functions ------------------------- //
+
+/// Analyzes the pawn skeleton of a position from scratch
+void AnalyzePawns(const Position* const position, PawnEntry* const entry);
+
+/// Gets the skeleton of the position from the table of the calling thread, analyzing it if it isn't there
+const PawnEntry* ProbePawnTable(const Position* const position);
+
+/// Adds the pawn structure and king shelter terms of the position to the midgame and endgame scores
+void AddPawnScores(const Position* const position, int32_t* const midgame, int32_t* const endgame);
+
+/// Gets the pawn table of the calling thread
+PawnTable* GetPawnTable();
+
+#endif
+
+// EOF //
@@ -0,0 +1,24 @@
+/*!
+ * \file PieceSquare.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes for the PieceSquare Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef PIECESQUARE_H
+#define PIECESQUARE_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Player.h"
+
+// ------------------------- Functions ------------------------- //
+
+/// Gets the material and square value of a piece in the midgame or the endgame
+int32_t GetPieceSquareValue(const Piece piece, const Index index, const bool endgame);
+
+#endif
+
+// EOF //
@@ -15,6 +15,14 @@
 #include "Moves.h"
 #include "main.h"
 
+// ------------------------- Material ------------------------- //
+
+/// Bits each piece type takes up in the material signature
+#define SIGNATURE_BITS 4
+
+/// Phase weight of both players at the start of the game
+#define PHASE_MAX 24
+
 // ------------------------- Types ------------------------- //
 
 /*!
@@ -61,6 +69,10 @@ typedef struct
 
     Index pawn[8];                  ///< Location of the pawns      
 
+    uint8_t material[6];            ///< Number of pieces of each type still on the board, indexed by PieceType
+    uint32_t signature;             ///< Material signature, four bits per piece type from pawns up to queens
+    uint8_t phase;                  ///< Phase weight of the pieces still on the board, 12 at the start
+
     PlayerFlags flags;              ///< Flags for move ability 
 
 } Player;
@@ -103,6 +115,18 @@ Index GetPieceLoc(const Player* const player, const uint8_t pieceid, const uint8
 /// Sets the location of the piece assuming its found to the location
 void SetPieceLoc(Player* const player, const Piece piece, const Index location);
 
+/// Gets the number of pieces of a type still on the board
+uint8_t GetMaterialCount(const Player* const player, const uint8_t pieceid);
+
+/// Gets the material signature of the player
+uint32_t GetMaterialSignature(const Player* const player);
+
+/// Gets the phase weight of the pieces the player has left
+uint8_t GetPhase(const Player* const player);
+
+/// Gets how much a piece type counts towards the phase of the game
+uint8_t GetPhaseWeight(const PieceType type);
+
 /// Checks if the player is in check
 bool IsInCheck(const Player* const player);
 
@@ -0,0 +1,190 @@
+/*!
+ * \file Position.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the Position Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef POSITION_H
+#define POSITION_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "GameData.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Most moves that can be generated for one position
+#define MAX_MOVES 256
+
+// ------------------------- Castling Rights ------------------------- //
+
+/// White can castle with the rook on H1
+#define CASTLE_WHITE_KING 1
+
+/// White can castle with the rook on A1
+#define CASTLE_WHITE_QUEEN 2
+
+/// Black can castle with the rook on H8
+#define CASTLE_BLACK_KING 4
+
+/// Black can castle with the rook on A8
+#define CASTLE_BLACK_QUEEN 8
+
+// ------------------------- Macros ------------------------- //
+
+/// Gets the bitboard with only the bit for the index set
+#define SquareBit(index) ((Bitboard)1 << (index))
+
+/// Counts the number of squares in a bitboard
+#define CountSquares(bitboard) ((uint8_t)__builtin_popcountll(bitboard))
+
+/// Gets the lowest square in a non empty bitboard
+#define FirstSquare(bitboard) ((Index)__builtin_ctzll(bitboard))
+
+// ------------------------- Types ------------------------- //
+
+/// Set of squares, bit n is the square with index n
+typedef uint64_t Bitboard;
+
+/*!
+ * \brief Position struct for fast move generation
+ * \details Keeps the same grid of pieces as the board along with a bitboard per color and piece type
+ * Also stores the side to move, castling rights, en passant square and halfmove clock so the position stands on its own
+ * The hash and the running evaluation sums are updated as pieces are put down and taken off
+ */
+typedef struct
+{
+
+    Piece grid[64];              ///< Pieces on each square, same encoding as the board
+
+    Bitboard pieces[2][6];       ///< Squares of each piece type, indexed by color then type
+    Bitboard occupancy[2];       ///< Squares of all of the pieces of a color
+
+    bool isWhite;                ///< Side to move
+
+    uint8_t castling;            ///< Castling rights still available
+    Index enpassant;             ///< Square a pawn can capture en passant on, INDEX_MAX if none
+    uint8_t halfmove;            ///< Moves since the last capture or pawn move
+
+    uint64_t key;                ///< Zobrist hash of everything above, kept up to date by every move
+    uint64_t pawnkey;            ///< Zobrist hash of only the pawns, changes far less often than the key
+
+    int32_t midgame;             ///< Midgame material and square values for white minus black, kept up to date like the hash
+    int32_t endgame;             ///< Endgame material and square values for white minus black
+    uint8_t phase;               ///< Phase weights of the pieces on the board, PHASE_MAX at the start
+
+} Position;
+
+/*!
+ * \brief Everything needed to take a move back
+ * \details Filled by MakePositionMove and handed back to UnmakePositionMove
+ */
+typedef struct
+{
+
+    Piece captured;              ///< Piece that was captured, EMPTY if none
+
+    uint8_t castling;            ///< Castling rights before the move
+    Index enpassant;             ///< En passant square before the move
+    uint8_t halfmove;            ///< Halfmove clock before the move
+
+    uint64_t key;                ///< Hash before the move
+
+} PositionUndo;
+
+/*!
+ * \brief List of moves for a whole position
+ * \details Unlike the MoveList this holds every move of the side to move
+ */
+typedef struct
+{
+
+    Move move[MAX_MOVES];        ///< Moves in the order they were generated
+    int32_t score[MAX_MOVES];    ///< Ordering score of each move, only set by ScoreMoves
+    size_t size;                 ///< Size of list
+
+} PositionMoveList;
+
+// ------------------------- Functions ------------------------- //
+
+/// Sets the position to the starting position
+void ResetPosition(Position* const position);
+
+/// Builds the position from the game data with the given side to move
+void SetPositionFromGameData(Position* const position, const GameData* const data, const bool isWhite);
+
+/// Builds a position from a FEN or EPD string, returns what is left after the fields it read or NULL if it isn't valid
+const char* SetPositionFromFEN(Position* const position, const char* const fen);
+
+/// Builds a position from pieces and their squares with nothing else going on, returns false if it can't come up in a game
+bool SetPositionFromPieces(Position* const position, const Piece* const pieces, const Index* const squares, const uint8_t count, const bool isWhite);
+
+/// Computes the hash of the position from scratch
+uint64_t ComputePositionKey(const Position* const position);
+
+/// Computes the hash of only the pawns from scratch
+uint64_t ComputePawnKey(const Position* const position);
+
+/// Gets the squares a knight attacks
+Bitboard GetKnightAttacks(const Index index);
+
+/// Gets the squares a king attacks
+Bitboard GetKingAttacks(const Index index);
+
+/// Gets the squares a pawn of the color attacks
+Bitboard GetPawnAttacks(const bool isWhite, const Index index);
+
+/// Gets the squares a bishop attacks with the given occupancy
+Bitboard GetBishopAttacks(const Index index, const Bitboard occupied);
+
+/// Gets the squares a rook attacks with the given occupancy
+Bitboard GetRookAttacks(const Index index, const Bitboard occupied);
+
+/// Gets the pieces of both colors attacking a square with the given occupancy
+Bitboard GetAttackersTo(const Position* const position, const Index index, const Bitboard occupied);
+
+/// Checks if a square is attacked by the given color
+bool IsSquareAttacked(const Position* const position, const Index index, const bool byWhite);
+
+/// Gets the square of the king of a color
+Index GetPositionKing(const Position* const position, const bool isWhite);
+
+/// Checks if the side to move is in check
+bool IsPositionInCheck(const Position* const position);
+
+/// Checks if the move captures a piece, en passant included
+bool IsCaptureMove(const Position* const position, const Move move);
+
+/// Plays a move on the position and fills the undo information
+void MakePositionMove(Position* const position, const Move move, PositionUndo* const undo);
+
+/// Takes back a move played with MakePositionMove
+void UnmakePositionMove(Position* const position, const Move move, const PositionUndo* const undo);
+
+/// Passes the turn to the other side
+void MakeNullMove(Position* const position, PositionUndo* const undo);
+
+/// Takes back a pass played with MakeNullMove
+void UnmakeNullMove(Position* const position, const PositionUndo* const undo);
+
+/// Fills the list with every pseudo legal move of the side to move
+uint8_t GeneratePseudoMoves(const Position* const position, PositionMoveList* const list);
+
+/// Fills the list with the captures and queen promotions of the side to move
+uint8_t GenerateTacticalMoves(const Position* const position, PositionMoveList* const list);
+
+/// Fills the list with every legal move of the side to move
+uint8_t GenerateLegalMoves(Position* const position, PositionMoveList* const list);
+
+/// Checks if a pseudo legal move leaves the mover's king safe
+bool IsLegalPositionMove(Position* const position, const Move move);
+
+/// Checks if the side to move has any legal move
+bool HasLegalMoves(Position* const position);
+
+#endif
+
+// EOF //
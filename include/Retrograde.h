@@ -0,0 +1,66 @@
+/*!
+ * \file Retrograde.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the Retrograde Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef RETROGRADE_H
+#define RETROGRADE_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Tablebase.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Fewest pieces a table can have, two kings alone are always a draw
+#define RETROGRADE_MIN_PIECES 3
+
+/// Longest distance to zeroing a table value can hold, anything longer is cut to it
+#define RETROGRADE_DTZ_MAX 126
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief One table while it is being worked out
+ * \details The win, loss and frontier sets take one bit per entry so the passes that spread the results only touch a sixteenth
+ * of the memory the values do, the counters and values are only needed where the bits say so
+ */
+typedef struct
+{
+
+    char name[TABLEBASE_NAME_MAX];           ///< Material like KQvKR, white is the first side of the name
+    uint8_t pieces;                          ///< Pieces in the table
+    Piece slots[TABLEBASE_MAX_PIECES];       ///< Piece of each base 64 digit of the entries while working, white first and each side from the king down
+    size_t size;                             ///< Entries, either side to move and every square of every piece
+
+    Tablebase* smaller;                      ///< Tables the captures and promotions lead to, NULL if they all leave two kings
+
+    Bitboard* valid;                         ///< Entries that are positions that can come up in a game
+    Bitboard* wins;                          ///< Entries the side to move wins
+    Bitboard* losses;                        ///< Entries the side to move loses
+    Bitboard* frontier;                      ///< Entries decided by the last pass, their predecessors are looked at next
+    Bitboard* next;                          ///< Entries decided by the pass running now
+
+    uint8_t* moves;                          ///< Moves of each entry not yet known to lose, the entry is lost when it reaches zero
+    uint8_t* quiet;                          ///< Moves of each lost entry that keep the clock running and whose distance isn't known yet
+    int8_t* values;                          ///< Value of each entry, its result and distance to zeroing are what the files keep
+
+    bool missing;                            ///< A capture or promotion led to a table that isn't in the directory
+
+} Retrograde;
+
+// ------------------------- Functions ------------------------- //
+
+/// Generates the table of a material, and every smaller table it needs, into a directory
+bool GenerateTablebase(const char* const directory, const char* const material, const uint8_t threads, FILE* const report);
+
+/// Generates every table with the given number of pieces into a directory
+bool GenerateTablebases(const char* const directory, const uint8_t pieces, const uint8_t threads, FILE* const report);
+
+#endif
+
+// EOF //
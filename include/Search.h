@@ -0,0 +1,257 @@
+/*!
+ * \file Search.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the Search Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Position.h"
+#include "TranspositionTable.h"
+#include "MoveOrder.h"
+#include "Network.h"
+#include "Tablebase.h"
+#include "ThreadPool.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Deepest the search can go from the root
+#define MAX_PLY 64
+
+/// Score of a checkmate at the root, mates further away score less
+#define MATE_SCORE 30000
+
+/// Scores at least this big are a forced mate
+#define MATE_BOUND (MATE_SCORE - MAX_PLY)
+
+/// Score of a tablebase win at the root, below every mate so a real mate is always preferred
+#define TABLEBASE_SCORE (MATE_BOUND - MAX_PLY)
+
+/// Bigger than any score the search returns
+#define INFINITE_SCORE 32000
+
+/// Most threads that can search one position
+#define SEARCH_MAX_THREADS POOL_MAX_WORKERS
+
+/// Margin on top of the captured piece a capture needs to possibly raise alpha in quiescence
+#define DELTA_MARGIN 200
+
+/// Nodes searched between looks at the clock, must be a power of two
+#define SEARCH_CHECK_NODES 1024
+
+/// Most keys of the game before the root a search looks back through, more than the fifty move rule ever lets repeat
+#define SEARCH_MAX_HISTORY 256
+
+// ------------------------- Pruning ------------------------- //
+
+/// Lets a side that is already above beta pass, if a shallower search still fails high the position is cut
+#define PRUNE_NULL_MOVE 1
+
+/// Searches quiet moves late in the order less deep, re-searching the ones that beat alpha
+#define PRUNE_LATE_MOVES 2
+
+/// Cuts positions far above beta near the horizon and skips quiet moves there that can't reach alpha
+#define PRUNE_FUTILITY 4
+
+/// Trusts quiescence near the horizon when the evaluation is far below alpha
+#define PRUNE_RAZORING 8
+
+/// Searches every move after the first with a null window, only re-searching the ones that beat it
+#define PRUNE_PVS 16
+
+/// Starts each iteration with a narrow window around the last score, widening it when the score falls outside
+#define PRUNE_ASPIRATION 32
+
+/// Every pruning technique
+#define PRUNE_ALL 63
+
+/// Shallowest depth a null move is tried at
+#define NULL_MIN_DEPTH 3
+
+/// Plies a null move search is reduced by on top of the pass, one more every six plies of depth
+#define NULL_REDUCTION 2
+
+/// Shallowest depth a null move cutoff is verified with a reduced search without null moves
+#define NULL_VERIFY_DEPTH 6
+
+/// Shallowest depth late moves are reduced at
+#define LMR_MIN_DEPTH 3
+
+/// Moves searched at full depth before the rest are reduced
+#define LMR_MIN_MOVES 3
+
+/// Deepest depth futility pruning is used at
+#define FUTILITY_DEPTH 3
+
+/// Futility margin per ply of depth in centipawns
+#define FUTILITY_MARGIN 120
+
+/// Deepest depth razoring is used at
+#define RAZOR_DEPTH 2
+
+/// Razoring margin per ply of depth in centipawns
+#define RAZOR_MARGIN 250
+
+/// Shallowest iteration that uses an aspiration window
+#define ASPIRATION_DEPTH 4
+
+/// First half width of the aspiration window in centipawns, doubled every time the score falls outside
+#define ASPIRATION_WINDOW 30
+
+// ------------------------- Types ------------------------- //
+
+/// Result of a search, defined below so a report can take one
+typedef struct SearchResult SearchResult;
+
+/// Called by the main thread of a search after every iteration it finishes
+typedef void (*SearchReport)(const SearchResult* const result);
+
+/*!
+ * \brief Budget for one search
+ * \details The search deepens one ply at a time until any of the limits is reached, a limit of zero is no limit
+ * The network, the tablebase and the stop flag aren't limits, they pick the evaluation, where it can stop early and who else can stop it
+ * The excluded moves are skipped at the root so the search finds the best of the others
+ * The keys of the game before the root let the search see a line that repeats a position already played as the draw it is
+ */
+typedef struct
+{
+
+    uint8_t depth;               ///< Deepest iteration to search
+    uint64_t nodes;              ///< Most positions to visit
+    uint32_t time;               ///< Most milliseconds to spend
+    uint8_t threads;             ///< Threads searching together, zero is the same as one
+    uint8_t pruning;             ///< Pruning techniques to use, PRUNE flags
+
+    const Network* network;      ///< Network to evaluate with, NULL for the hand written evaluation
+    const Tablebase* tablebase;  ///< Endgame tables to stop at, NULL for none
+    const bool* stop;            ///< Flag another thread sets to stop the search, NULL for none
+
+    const Move* exclude;         ///< Root moves left out of the search, NULL for none
+    uint8_t excluded;            ///< Number of root moves left out
+
+    SearchReport report;         ///< Called after each finished iteration with the nodes and time so far, NULL for none
+
+    uint16_t noise;              ///< Most centipawns the evaluation is moved either way, zero to play at full strength
+    uint64_t seed;               ///< Seed of the noise, each position is always moved the same way under the same seed
+
+    const uint64_t* keys;        ///< Keys of the positions played before the searched one, oldest first, NULL for none
+    uint16_t keycount;           ///< Number of keys
+
+} SearchLimits;
+
+/*!
+ * \brief Counters of where a search spent its nodes
+ * \details The table counters and iteration sizes are always kept, everything counted inside the tree is only counted
+ * when compiled with SEARCH_STATS and stays zero otherwise so a normal build pays nothing for it
+ */
+typedef struct
+{
+
+    uint8_t seldepth;            ///< Deepest ply reached, quiescence included
+    uint64_t iterations[2];      ///< Nodes of the last two iterations the main thread finished, their ratio is the branching factor
+
+    uint64_t cutoffs;            ///< Beta cutoffs in the main search
+    uint64_t firstcutoffs;       ///< Cutoffs made by the first move searched, a measure of the move ordering
+
+    uint64_t nullmoves;          ///< Null move searches
+    uint64_t nullcutoffs;        ///< Null move searches that cut the position
+    uint64_t reductions;         ///< Late moves searched reduced
+    uint64_t researches;         ///< Reduced or null window searches that had to be searched again
+    uint64_t futility;           ///< Positions and moves cut by futility pruning
+    uint64_t razors;             ///< Positions cut by razoring
+    uint64_t aspirations;        ///< Iterations searched again with a wider window
+
+    TableStats table;            ///< Table probes, hits, collisions and stores
+
+} SearchStats;
+
+/*!
+ * \brief Result of a search
+ * \details Stores the best move and its score along with the line the search expects to be played
+ */
+struct SearchResult
+{
+
+    Move best;                   ///< Best move found, EMPTY piece if there are no legal moves
+    int32_t score;               ///< Score of the best move for the side to move in centipawns
+
+    uint8_t depth;               ///< Depth of the last finished iteration
+    uint64_t nodes;              ///< Positions visited, unfinished iterations included
+    uint64_t qnodes;             ///< Positions of those visited by the quiescence search
+    uint64_t tbhits;             ///< Positions found in the tablebase
+    uint32_t time;               ///< Milliseconds spent
+
+    Move pv[MAX_PLY];            ///< Principal variation starting with the best move
+    uint8_t pvlength;            ///< Number of moves in the principal variation
+
+    SearchStats stats;           ///< Counters of every thread
+
+};
+
+/*!
+ * \brief Working state of one search
+ * \details Owns its own copy of the position, the triangular principal variation table and the move ordering state so nothing is allocated or shared while searching
+ */
+typedef struct
+{
+
+    Position position[1];            ///< Position being searched, moves are made and unmade in place
+
+    Move pv[MAX_PLY][MAX_PLY];       ///< Principal variation found from each ply
+    uint8_t pvlength[MAX_PLY];       ///< Length of the principal variation at each ply
+    Move played[MAX_PLY];            ///< Move searched at each ply, the previous move of the next ply
+
+    uint64_t keys[SEARCH_MAX_HISTORY + MAX_PLY];   ///< Keys of the game back to the last capture or pawn move, then of every ply of the line searched
+    uint16_t rootkey;                ///< Slot of the root in the keys, the key of a ply is that many slots on
+
+    MoveOrder order;                 ///< Killers, history and counter moves of this thread
+
+    uint8_t pruning;                 ///< Pruning techniques to use, PRUNE flags
+    bool verifying;                  ///< Set while a null move cutoff is being verified, no null moves are tried under it
+
+    const Network* network;          ///< Network to evaluate with, NULL for the hand written evaluation
+    Accumulator accumulators[MAX_PLY];   ///< First layer of the network at each ply, only kept with a network
+    const Tablebase* tablebase;      ///< Endgame tables to stop at, NULL for none
+    const Move* exclude;             ///< Root moves to skip, NULL for none
+    uint8_t excluded;                ///< Number of root moves to skip
+    int32_t noise;                   ///< Most centipawns the evaluation is moved either way
+    uint64_t seed;                   ///< Seed of the noise
+
+    uint64_t nodes;                  ///< Positions visited so far
+    uint64_t qnodes;                 ///< Positions of those visited by the quiescence search
+    uint64_t tbhits;                 ///< Positions found in the tablebase
+    uint64_t maxnodes;               ///< Nodes the search stops at, zero for no limit
+    uint64_t deadline;               ///< Monotonic time in nanoseconds the search stops at, zero for no limit
+
+    bool stopped;                    ///< Set once a limit is reached, the unfinished iteration is thrown away
+    bool stoppable;                  ///< Limits only apply once an iteration has finished so there is always a move
+    const bool* halt;                ///< Shared flag set when every thread has to stop
+    const bool* stop;                ///< Flag set from outside the search to stop it, NULL for none
+
+    TranspositionTable* table;       ///< Table shared with other searches, NULL to search without one
+    TableStats tablestats;           ///< Table counters of this search
+
+    SearchStats stats;               ///< Counters of this thread
+
+} SearchData;
+
+// ------------------------- Functions ------------------------- //
+
+/// Searches the position deeper and deeper until it runs out of budget
+SearchResult SearchPosition(const Position* const position, const SearchLimits limits, TranspositionTable* const table);
+
+/// Prints the counters of a search
+void PrintSearchStats(FILE* const file, const SearchResult* const result);
+
+/// Gets the limits for a search of a fixed depth
+SearchLimits GetDepthLimits(const uint8_t depth);
+
+#endif
+
+// EOF //
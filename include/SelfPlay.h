@@ -0,0 +1,106 @@
+/*!
+ * \file SelfPlay.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the SelfPlay Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Search.h"
+#include "Settings.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Longest game in plies, longer games are adjudicated a draw
+#define SELFPLAY_MAX_PLIES 600
+
+/// Nodes each move gets when an engine is given no limit
+#define SELFPLAY_DEFAULT_NODES 20000
+
+/// Random plies played from the start before the engines take over when none is given
+#define SELFPLAY_RANDOM_PLIES 8
+
+/// First four bytes of a game record file
+#define SELFPLAY_MAGIC "UCSP"
+
+/// Version of the game record format
+#define SELFPLAY_VERSION 1
+
+/// Bytes of the header of each game record, the moves follow as 16 bit numbers
+#define SELFPLAY_RECORD_HEADER 12
+
+// ------------------------- Types ------------------------- //
+
+/// How a self-play game ended
+typedef enum
+{
+
+    EndCheckmate,       ///< The side to move is mated
+    EndStalemate,       ///< The side to move has no moves and isn't in check
+    EndRepetition,      ///< The same position came up a third time
+    EndFiftyMoves,      ///< A hundred plies without a capture or pawn move
+    EndMaterial,        ///< Neither side has enough to mate
+    EndAdjudicated      ///< Reached SELFPLAY_MAX_PLIES
+
+} GameEnd;
+
+/*!
+ * \brief Settings of one side of a match
+ * \details Read from a spec like "depth=8,pruning=31,hash=32", anything not given is left as the settings have it
+ */
+typedef struct
+{
+
+    SearchLimits limits;         ///< Budget of every move, the network and tablebase are loaded from the paths below
+    uint16_t hash;               ///< Table size in MB, each concurrent game gets its own table
+
+    char network[SETTINGS_PATH_MAX];     ///< Network file, empty for the hand written evaluation
+    char tablebase[SETTINGS_PATH_MAX];   ///< Tablebase directory, empty for none
+
+} SelfPlayEngine;
+
+/*!
+ * \brief A match between two engines shared by its workers
+ * \details Games come in pairs that start from the same random opening with the colors swapped
+ * Each worker takes the next game number, plays it with its own tables and adds the outcome under the lock
+ */
+typedef struct
+{
+
+    SelfPlayEngine engines[2];   ///< First and second engine, results are counted for the first
+    uint32_t games;              ///< Games to play
+    uint8_t random;              ///< Random plies of each opening
+    uint64_t seed;               ///< Seed of the openings, the same seed plays the same openings
+
+    FILE* records;               ///< Binary game records, NULL for none
+
+    pthread_mutex_t lock;        ///< Guards the counters and the record file
+    uint32_t next;               ///< Next game to play
+    uint32_t wins;               ///< Games the first engine won
+    uint32_t draws;              ///< Games drawn
+    uint32_t losses;             ///< Games the first engine lost
+    uint32_t ends[EndAdjudicated + 1];   ///< Games that ended each way
+    uint64_t plies;              ///< Plies of every game
+
+} SelfPlay;
+
+// ------------------------- Functions ------------------------- //
+
+/// Sets an engine up from the settings
+void ResetSelfPlayEngine(SelfPlayEngine* const engine, const Settings* const settings);
+
+/// Changes an engine with a spec of key=value pairs
+bool ParseSelfPlayEngine(SelfPlayEngine* const engine, const char* const spec);
+
+/// Plays a match between two engines on a pool of workers and prints the results
+bool RunSelfPlay(SelfPlay* const match, const uint8_t concurrency, const char* const records, FILE* const file);
+
+#endif
+
+// EOF //
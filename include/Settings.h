@@ -14,6 +14,11 @@
 
 #include "main.h"
 
+// ------------------------- Limits ------------------------- //
+
+/// Longest file path the settings can hold, terminator included
+#define SETTINGS_PATH_MAX 256
+
 // ------------------------- Types ------------------------- //
 
 /*!
@@ -54,6 +59,16 @@ typedef struct
     GameMode mode;        ///< The gamemade currently being used
     Connection connect;
 
+    uint16_t hashsize;    ///< Size of each AI's transposition table in MB
+    uint8_t threads;      ///< Search threads of the harder AIs, zero for every processor
+    uint8_t pruning;      ///< Pruning techniques the AIs may search with, PRUNE flags
+    bool stats;           ///< Prints the counters of every AI search to stderr
+    uint8_t difficulty;   ///< Difficulty of every AI, from Novice to Impossible
+
+    char network[SETTINGS_PATH_MAX];  ///< Weights file of the Impossible AI's network, empty for none
+    char book[SETTINGS_PATH_MAX];     ///< Opening book of every AI, empty for none
+    char tablebase[SETTINGS_PATH_MAX];    ///< Directory with the endgame tables of every AI, empty for none
+
 } Settings;
 
 
@@ -81,6 +96,54 @@ void SetConnection(Settings* const settings, Connection connection);
 /// Gets the color of the pieces
 Color GetPieceColor(const Settings* const settings, const bool isWhite);
 
+/// Gets the transposition table size
+uint16_t GetHashSize(const Settings* const settings);
+
+/// Sets the transposition table size
+void SetHashSize(Settings* const settings, const uint16_t megabytes);
+
+/// Gets the number of search threads
+uint8_t GetSearchThreads(const Settings* const settings);
+
+/// Sets the number of search threads
+void SetSearchThreads(Settings* const settings, const uint8_t threads);
+
+/// Gets the pruning techniques of the search
+uint8_t GetSearchPruning(const Settings* const settings);
+
+/// Sets the pruning techniques of the search
+void SetSearchPruning(Settings* const settings, const uint8_t pruning);
+
+/// Gets the difficulty of the AIs
+uint8_t GetAIDifficulty(const Settings* const settings);
+
+/// Sets the difficulty of the AIs
+void SetAIDifficulty(Settings* const settings, const uint8_t difficulty);
+
+/// Gets if the counters of every search are printed
+bool GetPrintStats(const Settings* const settings);
+
+/// Sets if the counters of every search are printed
+void SetPrintStats(Settings* const settings, const bool stats);
+
+/// Gets the weights file of the network
+const char* GetNetworkFile(const Settings* const settings);
+
+/// Sets the weights file of the network
+void SetNetworkFile(Settings* const settings, const char* const path);
+
+/// Gets the opening book file
+const char* GetBookFile(const Settings* const settings);
+
+/// Sets the opening book file
+void SetBookFile(Settings* const settings, const char* const path);
+
+/// Gets the endgame table directory
+const char* GetTablebaseDirectory(const Settings* const settings);
+
+/// Sets the endgame table directory
+void SetTablebaseDirectory(Settings* const settings, const char* const path);
+
 /// Gets the color of the squares
 Color GetSquareColor(const Settings* const settings, const bool isWhite);
 
@@ -0,0 +1,138 @@
+/*!
+ * \file Tablebase.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the Tablebase Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Position.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Most pieces a table can have, kings included
+#define TABLEBASE_MAX_PIECES 4
+
+/// Most table files that can be loaded from one directory
+#define TABLEBASE_MAX_FILES 128
+
+/// Longest file name of a table, like KQRvKR.uctb
+#define TABLEBASE_NAME_MAX 32
+
+/// Most placements of the two kings, the tables with pawns only use the left half of the board for the first king
+#define TABLEBASE_KING_PAIRS 1806
+
+/// Extension of the result files, the rest of the name is the material
+/// The files are the engine's own format written by --tbgen, Syzygy files can't be read
+#define TABLEBASE_EXTENSION ".uctb"
+
+/// Extension of the distance files, which sit next to the result file of the same material
+#define TABLEBASE_DTZ_EXTENSION ".uctz"
+
+/// First four bytes of a result file
+#define TABLEBASE_MAGIC "UCTB"
+
+/// First four bytes of a distance file
+#define TABLEBASE_DTZ_MAGIC "UCTZ"
+
+/// Version of the table file format
+#define TABLEBASE_VERSION 2
+
+/// Bytes before the entries of a file, the magic then the version and piece count as 32 bit numbers
+#define TABLEBASE_HEADER 12
+
+// ------------------------- Results ------------------------- //
+
+/// Result of an entry the side to move draws
+#define TABLEBASE_DRAW 0
+
+/// Result of an entry the side to move wins
+#define TABLEBASE_WIN 1
+
+/// Result of an entry the side to move loses
+#define TABLEBASE_LOSS 2
+
+/// Result of an entry that isn't a legal position, it is never looked up
+#define TABLEBASE_BROKEN 3
+
+// ------------------------- Macros ------------------------- //
+
+/// Gets the outcome for the side to move of a table value, 1 for a win, 0 for a draw and -1 for a loss
+#define TablebaseWDL(value) (((value) > 0) - ((value) < 0))
+
+/// Gets the plies to a capture, pawn move or mate of a won or lost table value
+#define TablebaseDTZ(value) (abs(value) - 1)
+
+/// Gets the two bit result of an entry, four entries are packed into each byte lowest first
+#define TablebaseResult(results, index) (((results)[(index) >> 2] >> (((index) & 3) * 2)) & 3)
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief One table mapped from its files
+ * \details The result file holds two bits for every entry, the distance file a byte of plies to zeroing for every entry
+ * The distance file is optional, without it the search still knows the outcome but the root can't pick the move that makes progress
+ */
+typedef struct
+{
+
+    uint64_t material;           ///< Material key of the pieces with white being the first side of the name
+    uint8_t pieces;              ///< Pieces in the table
+    size_t entries;              ///< Entries in the table
+
+    const uint8_t* results;      ///< Mapped results past the header
+    size_t resultsize;           ///< Bytes of the result file, header included
+
+    const uint8_t* distances;    ///< Mapped distances past the header, NULL if the table has no distance file
+    size_t distancesize;         ///< Bytes of the distance file, header included
+
+} TablebaseFile;
+
+/*!
+ * \brief Every table of a directory
+ * \details All of the files are mapped when it is created and never written, so any number of threads can probe it at once
+ */
+typedef struct
+{
+
+    TablebaseFile files[TABLEBASE_MAX_FILES];   ///< Tables that were loaded
+    uint8_t count;                              ///< Number of tables
+    uint8_t pieces;                             ///< Most pieces of any table, positions with more are never looked up
+
+} Tablebase;
+
+// ------------------------- Functions ------------------------- //
+
+/// Maps every table in a directory
+Tablebase* CreateTablebase(const char* const directory);
+
+/// Unmaps every table
+void DeleteTablebase(Tablebase* const tablebase);
+
+/// Gets the material key of the pieces on the board
+uint64_t GetMaterialKey(const Position* const position, const bool flipped);
+
+/// Gets the number of entries in the table of a material
+size_t GetTablebaseEntries(const uint64_t material);
+
+/// Gets the entry of a position in the table of its material
+size_t GetTablebaseIndex(const Position* const position, const bool flipped);
+
+/// Sets up the position of an entry of the table of a material
+bool SetTablebasePosition(Position* const position, const uint64_t material, const size_t index);
+
+/// Looks up the value of a position
+bool ProbeTablebase(const Tablebase* const tablebase, const Position* const position, int8_t* const value);
+
+/// Picks the move that wins the fastest, holds the draw or loses the slowest
+bool ProbeTablebaseRoot(const Tablebase* const tablebase, Position* const position, Move* const move);
+
+#endif
+
+// EOF //
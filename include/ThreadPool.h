@@ -0,0 +1,95 @@
+/*!
+ * \file ThreadPool.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the ThreadPool Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "main.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Most worker threads a pool can have
+#define POOL_MAX_WORKERS 64
+
+/// Most tasks that can wait in the queue, submitting to a full queue runs the task right away
+#define POOL_QUEUE_SIZE 256
+
+// ------------------------- Types ------------------------- //
+
+/// Function run by a task, what it returns is the result of the task
+typedef void* (*TaskFunction)(void* argument);
+
+/*!
+ * \brief A unit of work and its future
+ * \details Owned by whoever submits it, it has to stay alive until WaitTask returns
+ */
+typedef struct
+{
+
+    TaskFunction function;       ///< Work to do
+    void* argument;              ///< Argument handed to the function
+    void* result;                ///< What the function returned, valid once done
+
+    bool done;                   ///< Set once the function has returned
+
+} Task;
+
+/*!
+ * \brief Persistent worker threads with a bounded queue of tasks
+ * \details Workers sleep until a task is queued, waiting on a task runs queued tasks instead of sleeping so tasks can wait on other tasks
+ */
+typedef struct
+{
+
+    pthread_t workers[POOL_MAX_WORKERS];     ///< Worker threads
+    uint8_t count;                           ///< Number of workers started
+
+    Task* queue[POOL_QUEUE_SIZE];            ///< Ring buffer of tasks that haven't started
+    uint16_t head;                           ///< Slot of the oldest task
+    uint16_t size;                           ///< Tasks in the queue
+
+    pthread_mutex_t lock;                    ///< Guards the queue and the flags
+    pthread_cond_t ready;                    ///< Signalled when a task is queued or the pool is stopping
+    pthread_cond_t finished;                 ///< Broadcast when a task is done
+
+    bool stopping;                           ///< Set when the workers have to exit
+
+} ThreadPool;
+
+// ------------------------- Functions ------------------------- //
+
+/// Creates a pool with the given number of workers, zero for one per processor
+ThreadPool* CreateThreadPool(const uint8_t workers);
+
+/// Finishes the queued tasks, stops the workers and deletes the pool
+void DeleteThreadPool(ThreadPool* const pool);
+
+/// Gets the pool shared by the whole program, created on first use
+ThreadPool* GetThreadPool();
+
+/// Starts more workers until the pool has at least the given number
+uint8_t ReserveWorkers(ThreadPool* const pool, const uint8_t workers);
+
+/// Queues a task
+void SubmitTask(ThreadPool* const pool, Task* const task, const TaskFunction function, void* const argument);
+
+/// Waits for a task to finish, running queued tasks meanwhile
+void* WaitTask(ThreadPool* const pool, Task* const task);
+
+/// Checks if a task has finished without waiting
+bool IsTaskDone(const Task* const task);
+
+/// Gets the number of processors that are online
+uint8_t GetOnlineProcessors();
+
+#endif
+
+// EOF //
@@ -0,0 +1,134 @@
+/*!
+ * \file TranspositionTable.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the TranspositionTable Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Moves.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Size of the table when none is given in MB
+#define TABLE_DEFAULT_MB 16
+
+/// Largest table that can be asked for in MB
+#define TABLE_MAX_MB 4096
+
+/// Slots per bucket, a bucket fills one cache line
+#define TABLE_BUCKET_SIZE 4
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief What a stored score says about the real score
+ * \details Searches that fail low only give an upper bound and ones that fail high only give a lower bound
+ */
+typedef enum
+{
+
+    BoundNone = 0,
+    BoundUpper = 1,
+    BoundLower = 2,
+    BoundExact = 3
+
+} Bound;
+
+/*!
+ * \brief One slot of the table
+ * \details The key is stored XORed with the data so a slot torn by two threads writing at once fails to verify instead of returning the wrong data
+ */
+typedef struct
+{
+
+    uint64_t key;                ///< Hash of the position XORed with the data
+    uint64_t data;               ///< Packed move, score, depth, bound and generation
+
+} TableSlot;
+
+/*!
+ * \brief Unpacked contents of a slot
+ * \details The move only holds the squares and promotion, the piece is filled from the position by the caller
+ */
+typedef struct
+{
+
+    Move move;                   ///< Best move found, INDEX_MAX squares if none
+    int32_t score;               ///< Score of the position, mates are relative to the position
+    uint8_t depth;               ///< Depth the score was searched to
+    Bound bound;                 ///< How the score relates to the real score
+
+} TableEntry;
+
+/*!
+ * \brief Counters of how the table is being used
+ * \details Searches count into their own copy and add it to the table when done so threads don't fight over the counters
+ */
+typedef struct
+{
+
+    uint64_t probes;             ///< Lookups done
+    uint64_t hits;               ///< Lookups that found the position
+    uint64_t collisions;         ///< Lookups that found only other positions in the bucket
+    uint64_t stores;             ///< Entries written
+
+} TableStats;
+
+/*!
+ * \brief Transposition table shared by every search of a game
+ * \details Buckets are found by the low bits of the hash, no locks are taken so any number of threads can read and write at once
+ */
+typedef struct
+{
+
+    TableSlot* slots;            ///< Buckets of TABLE_BUCKET_SIZE slots aligned to cache lines
+    uint64_t mask;               ///< Number of buckets minus one, the count is a power of two
+
+    uint8_t generation;          ///< Bumped every search so old entries are replaced first
+
+    TableStats stats;            ///< Totals of every finished search
+
+} TranspositionTable;
+
+// ------------------------- Functions ------------------------- //
+
+/// Creates a table of at most the given size in MB
+TranspositionTable* CreateTable(const size_t megabytes);
+
+/// Deletes a table
+void DeleteTable(TranspositionTable* const table);
+
+/// Empties the table and its counters
+void ClearTable(TranspositionTable* const table);
+
+/// Starts a new search so entries from older ones are replaced first
+void AgeTable(TranspositionTable* const table);
+
+/// Looks up a position
+bool ProbeTable(const TranspositionTable* const table, const uint64_t key, TableEntry* const entry, TableStats* const stats);
+
+/// Stores a position
+void StoreTable(TranspositionTable* const table, const uint64_t key, const TableEntry* const entry, TableStats* const stats);
+
+/// Adds the counters of a search to the table totals
+void AddTableStats(TranspositionTable* const table, const TableStats* const stats);
+
+/// Gets the totals of every finished search
+TableStats GetTableStats(const TranspositionTable* const table);
+
+/// Gets how full the table is in parts per thousand
+uint16_t GetTableUsage(const TranspositionTable* const table);
+
+/// Gets the size of the table in MB
+size_t GetTableSize(const TranspositionTable* const table);
+
+#endif
+
+// EOF //
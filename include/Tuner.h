@@ -0,0 +1,89 @@
+/*!
+ * \file Tuner.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the Tuner Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef TUNER_H
+#define TUNER_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Position.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Weights that are tuned, a midgame and an endgame value for every piece type on every square
+#define TUNE_WEIGHTS (2 * 6 * 64)
+
+/// Passes over every position when none is given
+#define TUNE_EPOCHS 300
+
+/// Step size of the optimizer in centipawns when none is given
+#define TUNE_RATE 1.0
+
+/// Longest line of a position file
+#define TUNE_LINE_MAX 512
+
+/// Header the tuned weights are written to when no path is given
+#define TUNE_OUTPUT "include/TunedWeights.h"
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief One position with the result of its game
+ * \details The pieces are kept as features in the shared pool so millions of positions fit, the pawn terms aren't tuned and are kept as is
+ */
+typedef struct
+{
+
+    uint32_t offset;             ///< First feature of the position in the pool
+    uint8_t count;               ///< Number of features, one per piece
+    uint8_t phase;               ///< Phase of the position, PHASE_MAX at the start
+    uint8_t result;              ///< 0 if black won, 1 for a draw and 2 if white won
+    int16_t midgame;             ///< Pawn structure and king shelter terms in the midgame, for white minus black
+    int16_t endgame;             ///< Same terms in the endgame
+
+} TuningPosition;
+
+/*!
+ * \brief Positions and weights of a tuning run
+ * \details A feature is the weight of a piece on its square with the color in bit 9, so the evaluation is a sum over at most 32 features
+ * blended by the phase, which makes the gradient a scatter of the same features
+ */
+typedef struct
+{
+
+    TuningPosition* positions;   ///< Every position loaded
+    size_t count;                ///< Number of positions
+    size_t capacity;             ///< Positions the array has room for
+
+    uint16_t* features;          ///< Features of every position back to back
+    size_t used;                 ///< Features in the pool
+    size_t size;                 ///< Features the pool has room for
+
+    double weights[TUNE_WEIGHTS];    ///< Midgame then endgame weights by type and square, laid out like the piece square tables
+    double scale;                    ///< Fitted scale from a score to a win chance
+
+} Tuner;
+
+// ------------------------- Functions ------------------------- //
+
+/// Starts a tuning run from the weights the engine has now
+Tuner* CreateTuner();
+
+/// Frees a tuning run
+void DeleteTuner(Tuner* const tuner);
+
+/// Loads the positions of a file, EPD lines with results or self-play records
+size_t LoadTuningFile(Tuner* const tuner, const char* const path);
+
+/// Fits the weights to the results and writes them as a header
+bool RunTuner(Tuner* const tuner, const uint8_t threads, const uint32_t epochs, const double rate, const char* const output);
+
+#endif
+
+// EOF //
@@ -0,0 +1,72 @@
+/*!
+ * \file UCI.h
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the prototypes and custom types for the UCI Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+#ifndef UCI_H
+#define UCI_H
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Search.h"
+#include "Settings.h"
+
+// ------------------------- Limits ------------------------- //
+
+/// Longest command that is read, a position command of a long game is the longest
+#define UCI_LINE_MAX 16384
+
+/// Milliseconds kept back from the clock for sending the move
+#define UCI_MOVE_OVERHEAD 30
+
+/// Moves the time left is spread over when the GUI doesn't say
+#define UCI_MOVES_TO_GO 30
+
+/// Largest hash size offered in MB
+#define UCI_MAX_HASH 65535
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief State of the engine between commands
+ * \details The search runs on its own thread so stop, isready and quit are still read while it thinks
+ * The table lives as long as the engine so every search of a game starts with what the last one found
+ */
+typedef struct
+{
+
+    Position position[1];        ///< Position of the last position command
+    uint64_t keys[SEARCH_MAX_HISTORY];   ///< Keys of the positions the moves of the command went through since the last capture or pawn move
+    uint16_t keycount;           ///< Number of keys
+
+    TranspositionTable* table;   ///< Table of the engine, NULL if it couldn't be made
+    uint16_t hash;               ///< Size of the table in MB
+    uint8_t threads;             ///< Threads every search uses
+    uint8_t pruning;             ///< Pruning techniques from the settings, PRUNE flags
+
+    const Network* network;      ///< Network from the settings, NULL for the hand written evaluation
+    const Tablebase* tablebase;  ///< Tables from the settings, NULL for none
+
+    pthread_t thread;            ///< Thread running the search
+    bool searching;              ///< True from go until the search thread is joined
+    bool infinite;               ///< The best move isn't sent until a stop, even if the search finishes
+    bool stop;                   ///< Set by stop, quit or a new command to end the search
+    pthread_mutex_t lock;        ///< Guards the stop flag for the condition
+    pthread_cond_t stopped;      ///< Signalled when stop is set
+
+    SearchLimits limits;         ///< Limits of the running search
+
+} UCIEngine;
+
+// ------------------------- Functions ------------------------- //
+
+/// Runs the engine over the UCI protocol on stdin and stdout until quit
+void RunUCI(const Settings* const settings);
+
+#endif
+
+// EOF //
@@ -11,16 +11,28 @@
 
 #include "AI.h"
 
+#include <time.h>
+
+// ------------------------- Globals ------------------------- //
+
+/// AIs made so far, mixed into the seed so AIs made in the same second still play differently
+static uint64_t AICount = 0;
+
 // ------------------------- Definintions ------------------------- //
 
 /*!
  * \brief Initializes the AI with a fixed difficulty
+ * \details The random generator is seeded here once from the clock, every random choice after that comes from it
  * \returns ai: Returns novice level AI
  */
 AI GetDefaultAI()
 {
 
-    return (AI){(Player*)NULL, Novice};
+    AI ai = {(Player*)NULL, Novice, (TranspositionTable*)NULL, (Network*)NULL, (Book*)NULL, (Tablebase*)NULL, 0};
+
+    SeedAI(&ai, (uint64_t)time(NULL) ^ (++AICount * 0x9E3779B97F4A7C15ull));
+
+    return ai;
     
 }
 
@@ -72,4 +84,128 @@ void SetAIPlayer(AI *const ai, const Player *const player)
     
 }
 
+/*!
+ * \brief Gets the transposition table of the AI
+ * \param ai: Takes in the AI struct
+ * \returns TranspositionTable*: The table kept between moves, NULL if it has none
+ */
+TranspositionTable* GetAITable(const AI *const ai)
+{
+
+    return ai->table;
+
+}
+
+/*!
+ * \brief Sets the transposition table of the AI, the AI doesn't own it
+ * \param ai: Takes in the AI struct
+ * \param table: Table to search with, NULL for none
+ */
+void SetAITable(AI *const ai, TranspositionTable *const table)
+{
+
+    ai->table = table;
+
+}
+
+/*!
+ * \brief Gets the network of the AI
+ * \param ai: Takes in the AI struct
+ * \returns Network*: The network it evaluates with, NULL if it uses the hand written evaluation
+ */
+Network* GetAINetwork(const AI *const ai)
+{
+
+    return ai->network;
+
+}
+
+/*!
+ * \brief Sets the network of the AI, the AI doesn't own it
+ * \param ai: Takes in the AI struct
+ * \param network: Network to evaluate with, NULL for the hand written evaluation
+ */
+void SetAINetwork(AI *const ai, Network *const network)
+{
+
+    ai->network = network;
+
+}
+
+/*!
+ * \brief Gets the opening book of the AI
+ * \param ai: Takes in the AI struct
+ * \returns Book*: The book it plays from, NULL if it always searches
+ */
+Book* GetAIBook(const AI *const ai)
+{
+
+    return ai->book;
+
+}
+
+/*!
+ * \brief Sets the opening book of the AI, the AI doesn't own it
+ * \param ai: Takes in the AI struct
+ * \param book: Book to play from, NULL for none
+ */
+void SetAIBook(AI *const ai, Book *const book)
+{
+
+    ai->book = book;
+
+}
+
+/*!
+ * \brief Gets the endgame tables of the AI
+ * \param ai: Takes in the AI struct
+ * \returns Tablebase*: The tables it plays and searches with, NULL for none
+ */
+Tablebase* GetAITablebase(const AI *const ai)
+{
+
+    return ai->tablebase;
+
+}
+
+/*!
+ * \brief Sets the endgame tables of the AI, the AI doesn't own them
+ * \param ai: Takes in the AI struct
+ * \param tablebase: Tables to play and search with, NULL for none
+ */
+void SetAITablebase(AI *const ai, Tablebase *const tablebase)
+{
+
+    ai->tablebase = tablebase;
+
+}
+
+/*!
+ * \brief Restarts the random choices of the AI, the same seed makes the same choices in the same games
+ * \param ai: Takes in the AI struct
+ * \param seed: Any number, zero included
+ */
+void SeedAI(AI *const ai, const uint64_t seed)
+{
+
+    ai->random = seed? seed: 0x9E3779B97F4A7C15ull; // Xorshift never leaves zero
+
+}
+
+/*!
+ * \brief Gets the next number of the AI's xorshift64* generator
+ * \param ai: Takes in the AI struct
+ * \returns uint64_t: Random number
+ */
+uint64_t NextAIRandom(AI *const ai)
+{
+
+    ai->random ^= ai->random >> 12;
+    ai->random ^= ai->random << 25;
+    ai->random ^= ai->random >> 27;
+
+    return ai->random * 0x2545F4914F6CDD1Dull;
+
+}
+
 // EOF //
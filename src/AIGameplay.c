@@ -15,431 +15,406 @@
 #include "Moves.h"
 #include "Board.h"
 #include "Player.h"
-#include "MoveValidation.h"
-#include "MoveList.h"
+#include "Search.h"
+#include "PieceSquare.h"
+#include "PawnTable.h"
+#include "Book.h"
+#include "Tablebase.h"
 
-// ------------------------- Types ------------------------- //
+// ------------------------- Tables ------------------------- //
 
-/*!
- * \brief The movebranch that holds all the branches information
- * \details The branch holds the root the leaves the ranked moves
- * The number of branches and the worst value of a move
- */
-typedef struct leaf
+/// Depth, node, millisecond, thread and pruning budgets and evaluation noise of each difficulty from Novice to Impossible, zero threads uses every processor
+/// Every difficulty has a time budget so none of them can keep the player waiting, the node budgets keep the easy ones weak on fast machines too
+static const SearchLimits SearchBudgets[] =
 {
 
-    struct leaf* root;           ///< The leaf struct of the previous move
-    struct leaf* leaves[20];     ///< The leaf structs of future moves
-    RankedMove* move[20];        ///< The Ranked moves connected to the leaves
-    uint8_t branches;            ///< The number of moves stored
-    int8_t lowestvalue;          ///< The least value of a move
+    {1, 2000, 100, 1, PRUNE_ALL, NULL, NULL, NULL, NULL, 0, NULL, 150, 0, NULL, 0},
+    {2, 10000, 250, 1, PRUNE_ALL, NULL, NULL, NULL, NULL, 0, NULL, 80, 0, NULL, 0},
+    {4, 100000, 500, 1, PRUNE_ALL, NULL, NULL, NULL, NULL, 0, NULL, 30, 0, NULL, 0},
+    {6, 1000000, 1000, 0, PRUNE_ALL, NULL, NULL, NULL, NULL, 0, NULL, 10, 0, NULL, 0},
+    {10, 0, 2000, 0, PRUNE_ALL, NULL, NULL, NULL, NULL, 0, NULL, 0, 0, NULL, 0},
+    {0, 0, 5000, 0, PRUNE_ALL, NULL, NULL, NULL, NULL, 0, NULL, 0, 0, NULL, 0}
 
-} MoveBranch;
+};
 
-// // ------------------------- Functions ------------------------- //
+// ------------------------- Functions ------------------------- //
 
-// /// Creates an initial movebranch
-// static MoveBranch* CreateMoveBranch();
+/// Gets the budget of the AI with the settings of the game applied
+static SearchLimits GetGameLimits(const GameData* const data, const AI* const ai);
 
-// /// Adds a new branch to an existing movebranch
-// static void AddBranch(MoveBranch* const moveBranch, const RankedMove* const move);
+/// Looks for the AI's move in its opening book and endgame tables
+static bool ProbeAIMove(const GameData* const data, AI* const ai, Position* const position, Move* const move);
 
-// /// Resets the lowest value of a branch
-// static void setBranchLowestValue(MoveBranch* const movebranch);
+/// Runs a ponder search on its own thread
+static void* PonderSearch(void* ponder);
 
-// /// Sets a new root to the branch
-// static void SetBranchRoot(MoveBranch* const movebranch, const MoveBranch* const root);
+// ------------------------- Definintions ------------------------- //
 
-// /// Gets the branches root
-// static MoveBranch* GetBranchRoot(const MoveBranch* const moveBranch);
+/*!
+ * \brief Looks for the AI's move in its opening book and endgame tables, both are played without searching
+ * \details The book isn't looked at once IsEndgame says the game has reached the endgame, no book line gets that far
+ * \param data: The current gamedata
+ * \param ai: The AI struct, its generator picks between book moves
+ * \param position: Position of the game with the AI to move
+ * \param move: Filled with the move if one was found
+ * \returns bool: True if the book or the tables had a move
+ */
+static bool ProbeAIMove(const GameData* const data, AI* const ai, Position* const position, Move* const move)
+{
 
-// /// Gets the leaves of a branch
-// static MoveBranch* GetBranchLeaves(const MoveBranch* const moveBranch, uint8_t i);
+    if(!IsEndgame(data) && ProbeBook(GetAIBook(ai), position, NextAIRandom(ai), move)) return true;
 
-// /// Gets the ranked move at an index in the branch
-// static RankedMove* GetBranchRankedMove(const MoveBranch* const moveBranch, uint8_t i);
+    return ProbeTablebaseRoot(GetAITablebase(ai), position, move);
 
-// /// Gets the number of branches in the current branch
-// static uint8_t GetBranchNumber(const MoveBranch* const moveBranch);
+}
 
-// /// Gets the branches lowest value
-// static uint8_t GetBranchLowestValue(const MoveBranch* const moveBranch);
+/*!
+ * \brief Generates the best move for the AI
+ * \details Plays straight from the opening book while the game is still in it and from the tablebase once it is in an endgame it has, otherwise searches
+ * The book pick and the noise of the search both come from the AI's own generator
+ * \param data: The current gamedata
+ * \param ai: The AI struct
+ * \returns Move: The best possible move
+ */
+Move GenerateBestMove(const GameData* const data, AI* const ai)
+{
 
-// /// Creates a new rankedmove
-// static RankedMove* CreateRankedMove(const Move move, const uint8_t value, const uint32_t rank);
+    STATIC_ASSERT(data, "Invalid Game Data Pointer");
+    STATIC_ASSERT(ai, "Invalid AI Pointer");
 
-// /// Sets the value of a rankedmove
-// static void SetRankedMoveValue(RankedMove* const rankedMove, const uint8_t value);
+    Position position[1];
+    SearchLimits limits;
+    Move move;
 
-// /// Sets the rank of a rankedmove
-// static void SetRankedMoveRank(RankedMove* const rankedMove, const uint32_t rank);
+    SetPositionFromGameData(position, data, IsPlayerWhite(ai->player));
 
-// /// Gets the move of a rankedmove
-// static Move GetRankedMoveMove(const RankedMove* const rankedMove);
+    if(ProbeAIMove(data, ai, position, &move)) return move;
 
-// /// Gets the value of a ranked move
-// static uint8_t GetRankedMoveValue(const RankedMove* const rankedMove);
+    limits = GetGameLimits(data, ai);
+    limits.seed = NextAIRandom(ai); // New noise every move so the same mistakes aren't made every game
 
-// /// Gets the ranke of a rankedmove
-// static uint32_t GetRankedMoveRank(const RankedMove* const rankedMove);
+    return GenerateLimitedMove(data, ai, limits);
 
-// // ------------------------- Definintions ------------------------- //
+}
 
-/**
- * @brief 
- * 
- * @param data 
- * @param player 
- * @return Move 
+/*!
+ * \brief Generates the AI's move, playing the pondered move if the player made the expected reply
+ * \details The book and the tables come first as they do without pondering. The pondered result is only used if it searched
+ * as deep or as long as the AI would have without going past its depth or node budget, otherwise the AI searches again with the table it filled
+ * \param data: The current gamedata, the player's reply already made
+ * \param ai: The AI struct
+ * \param ponder: Stopped ponder, NULL if the AI didn't ponder
+ * \returns Move: The best possible move
  */
-static Move NoviceMove(const GameData* data, Player* const player)
-{   
-    
+Move GeneratePonderedMove(const GameData* const data, AI* const ai, const Ponder* const ponder)
+{
+
     STATIC_ASSERT(data, "Invalid Game Data Pointer");
-    STATIC_ASSERT(player, "Invalid Player Pointer");
+    STATIC_ASSERT(ai, "Invalid AI Pointer");
+
+    Position position[1];
+    SearchLimits limits;
+    Move move;
+
+    SetPositionFromGameData(position, data, IsPlayerWhite(ai->player));
+
+    if(ProbeAIMove(data, ai, position, &move)) return move;
+
+    if(ponder && ponder->result.pvlength && position->key == ponder->position->key)
+    {
+
+        const SearchLimits* budget = &ponder->budget;
+        const SearchResult* result = &ponder->result;
+
+        bool reached = (budget->depth && result->depth >= budget->depth) || (budget->time && result->time >= budget->time);
+        bool within = (!budget->depth || result->depth <= budget->depth) && (!budget->nodes || result->nodes <= budget->nodes);
+
+        if(reached && within) return result->best; // Ponder hit, no stronger than the AI's own search would have been
 
-    srand(time(NULL));
+    }
 
-    MoveList list[1];
-    
-    while(!GenerateTakingMoves(data, list, player, rand() & 63));
+    limits = GetGameLimits(data, ai);
+    limits.seed = NextAIRandom(ai);
 
-    return GetListMove(list, GetListSize(list) - 1);
+    return GenerateLimitedMove(data, ai, limits);
 
 }
 
 /*!
- * \brief Generates the best move for the AI
- * \param data: The current gamedata
- * \param ai: The AI struct
- * \returns Move: The best possible move
+ * \brief Starts searching on the player's time
+ * \details The reply the AI expects is the best move its table has for the player, it is played on a copy of the position and searched
+ * with the AI's budget, or until StopPonder if that comes first
+ * \param ponder: Ponder to start
+ * \param data: The current gamedata, the player is to move
+ * \param ai: The AI struct, its table is filled by the search and its generator seeds the noise
+ * \returns bool: True if a search was started, false if there is no expected reply
  */
-Move GenerateBestMove(const GameData* const data, const AI* const ai)
+bool StartPonder(Ponder* const ponder, const GameData* const data, AI* const ai)
 {
 
-    return NoviceMove(data, ai->player);
+    STATIC_ASSERT(ponder, "Invalid Ponder Pointer");
+    STATIC_ASSERT(data, "Invalid Game Data Pointer");
+    STATIC_ASSERT(ai, "Invalid AI Pointer");
+
+    PositionMoveList list[1];
+    PositionUndo undo;
+    TableEntry entry;
+    TableStats stats;
+
+    ponder->running = false;
+    ponder->stop = false;
+    ponder->result.pvlength = 0;
+
+    if(!GetAITable(ai)) return false; // Nothing to expect a reply from
+
+    SetPositionFromGameData(ponder->position, data, !IsPlayerWhite(ai->player));
+
+    if(!ProbeTable(GetAITable(ai), ponder->position->key, &entry, &stats)) return false;
+
+    GenerateLegalMoves(ponder->position, list);
+
+    for(size_t i = 0; i < list->size; i++)
+    {
+
+        if(!IsSameMove(list->move[i], entry.move)) continue;
+
+        MakePositionMove(ponder->position, list->move[i], &undo);
+
+        if(!HasLegalMoves(ponder->position)) return false; // The reply ends the game
+
+        ponder->budget = GetGameLimits(data, ai);
+        ponder->budget.seed = NextAIRandom(ai); // Noise drawn the same way GenerateBestMove draws it
+        ponder->limits = ponder->budget; // Stops at the AI's own budget so pondering never plays stronger than the difficulty
+        ponder->limits.network = GetAINetwork(ai);
+        ponder->limits.tablebase = GetAITablebase(ai);
+        ponder->limits.stop = &ponder->stop;
+        ponder->table = GetAITable(ai);
+        ponder->running = !pthread_create(&ponder->thread, NULL, PonderSearch, ponder);
+
+        return ponder->running;
+
+    }
+
+    return false; // The table move is from a collision
 
 }
 
-// /*!
-//  * \brief Generates the best move for the AI with the most value
-//  * \param data: The current gamedata
-//  * \param ai: The AI struct
-//  * \returns ?
-//  */
-// uint32_t Max(const GameData* const data, const AI* const ai)
-// {
-//     STATIC_ASSERT(data, "Invalid Game Data Pointer");
-//     STATIC_ASSERT(ai, "Invalid AI Pointer");
+/*!
+ * \brief Stops pondering and keeps the result
+ * \param ponder: Ponder to stop, nothing happens if it isn't running
+ */
+void StopPonder(Ponder* const ponder)
+{
 
-//     //MoveBranch branch;
+    STATIC_ASSERT(ponder, "Invalid Ponder Pointer");
 
-//     Player* next = IsPlayerWhite(ai->player)? GetPlayer(data, BLACK): GetPlayer(data, WHITE);
+    if(!ponder->running) return;
 
-//     MoveList queen, king, bishop[2], rook[2], knight[2], pawn[8];
+    __atomic_store_n(&ponder->stop, true, __ATOMIC_RELAXED);
+    pthread_join(ponder->thread, NULL);
 
-//     GenerateTakingMoves(data, &queen, ai->player, GetPieceLoc(next, QUEEN, 0)); 
-//     GenerateTakingMoves(data, &king, ai->player, GetPieceLoc(next, KING, 0));
-    
-//     for(uint8_t i = 0; i < 2; i++)
-//     {
-//         GenerateTakingMoves(data, &bishop[i], ai->player, GetPieceLoc(next, BISHOP, i));
-//         GenerateTakingMoves(data, &rook[i], ai->player, GetPieceLoc(next, ROOK, i));
-//         GenerateTakingMoves(data, &knight[i], ai->player, GetPieceLoc(next, KNIGHT, i));   
-//     }
+    ponder->running = false;
 
-//     for(uint8_t i = 0; i < 8; i++)
-//         GenerateTakingMoves(data, &pawn[i], ai->player, GetPieceLoc(next, PAWN, i));
+}
 
+/*!
+ * \brief Generates the best move for the AI without going over a budget
+ * \param data: The current gamedata
+ * \param ai: The AI struct
+ * \param limits: Depth, node and time budget of the search
+ * \returns Move: The best move of the deepest finished search
+ */
+Move GenerateLimitedMove(const GameData* const data, const AI* const ai, const SearchLimits limits)
+{
 
-//     return 0;
+    STATIC_ASSERT(data, "Invalid Game Data Pointer");
+    STATIC_ASSERT(ai, "Invalid AI Pointer");
 
+    Position position[1];
+    SearchLimits search = limits;
 
-// }
+    SetPositionFromGameData(position, data, IsPlayerWhite(ai->player));
 
-// /*!
-//  * \brief Generates the worst move for the AI with the least value by the opponent
-//  * \param data: The current gamedata
-//  * \param ai: The AI struct
-//  * \returns ?
-//  */
-// uint32_t Min(const GameData* const data, const AI* const ai)
-// {
+    if(!search.network) search.network = GetAINetwork(ai); // Only set for the Impossible AI
+    if(!search.tablebase) search.tablebase = GetAITablebase(ai);
 
-//     return 0;
-    
-// }
+    SearchResult result = SearchPosition(position, search, GetAITable(ai));
 
-// /*!
-//  * \brief ?
-//  * \param data: The current gamedata
-//  * \returns ?
-//  */
-// double Evaluate(const GameData* const data)
-// {
+    if(GetPrintStats(GetSettings(data))) PrintSearchStats(stderr, &result); // On stderr so it can be logged without getting in the way of the board
 
-//     return 0.0f;
+    return result.best;
 
-// }
+}
 
 /*!
- * \brief Predetermines values for each players piece used for minmax algorithm
- * \param piece player piece
- * \returns Determined piece value
+ * \brief Searches the best few moves for the AI, best first
+ * \details Each line searches the root again without the moves of the lines before it, sharing the AI's table
+ * so every search after the first starts with the tree the others left behind instead of from nothing
+ * \param data: The current gamedata
+ * \param ai: The AI struct, its table, network and tablebase are used
+ * \param count: Most lines to find
+ * \param limits: Depth, node and time budget of each line
+ * \param lines: Filled with a result for each line, the first move of its principal variation is the move
+ * \returns uint8_t: Number of lines found, less than count if there aren't that many legal moves
  */
-uint32_t GetPieceValue(const Piece piece)
+uint8_t GenerateTopMoves(const GameData* const data, const AI* const ai, const uint8_t count, const SearchLimits limits, SearchResult* const lines)
 {
 
-    switch (GetPieceID(piece))
+    STATIC_ASSERT(data, "Invalid Game Data Pointer");
+    STATIC_ASSERT(ai, "Invalid AI Pointer");
+    STATIC_ASSERT(lines, "Invalid Lines Pointer");
+
+    Position position[1];
+    PositionMoveList list[1];
+    Move exclude[MAX_MOVES];
+    SearchLimits search = limits;
+    uint8_t found = 0;
+
+    SetPositionFromGameData(position, data, IsPlayerWhite(ai->player));
+
+    uint8_t legal = GenerateLegalMoves(position, list);
+
+    if(!search.network) search.network = GetAINetwork(ai);
+    if(!search.tablebase) search.tablebase = GetAITablebase(ai);
+
+    search.exclude = exclude;
+
+    while(found < count && found < legal)
     {
 
-        case PAWN: return PAWNVAL;
-        case KNIGHT: return KNIGHTVAL;
-        case BISHOP: return BISHOPVAL;
-        case ROOK: return ROOKVAL;
-        case QUEEN: return QUEENVAL;
-        case KING: return KINGVAL;    
-        default: return 0;
+        search.excluded = found;
+        lines[found] = SearchPosition(position, search, GetAITable(ai));
+
+        if(!lines[found].pvlength) break; // Stopped from outside before a line was found
+
+        exclude[found] = lines[found].best;
+        found++;
 
     }
+
+    return found;
+
 }
 
-// /*!
-//  * \brief Initializes a blank movebranch
-//  * \returns MoveBranch*: Returns a pointer to the created movebranch
-//  */
-// MoveBranch* CreateMoveBranch()
-// {
+/*!
+ * \brief Gets the budget of the AI with the settings of the game applied
+ * \param data: The current gamedata
+ * \param ai: The AI struct
+ * \returns SearchLimits: Budget of the difficulty with the thread count and pruning techniques of the settings
+ */
+static SearchLimits GetGameLimits(const GameData* const data, const AI* const ai)
+{
 
-//     MoveBranch* moveBranch = malloc(sizeof(MoveBranch)); // The movebranch
+    SearchLimits limits = GetSearchLimits(ai);
 
-//     moveBranch->root = NULL; // There is no root when initialized
-//     moveBranch->leaves[20]; // The blank leaves
-//     moveBranch->move[20]; // The blank move slots
-//     moveBranch->branches = 0; // The number is set to 0 on initialization
-//     moveBranch->lowestvalue = -128; // The minimum possible value of a move
+    if(GetSearchThreads(GetSettings(data)) && limits.threads != 1) // The settings only change the difficulties that search in parallel
+        limits.threads = GetSearchThreads(GetSettings(data));
 
-//     return moveBranch;
+    limits.pruning &= GetSearchPruning(GetSettings(data)); // Techniques can only be turned off
 
-// }
+    return limits;
 
-// uint8_t MaxValue(const int* const array, uint8_t size)
-// {
+}
 
-// }
+/*!
+ * \brief Runs a ponder search on its own thread
+ * \param ponder: Ponder to run, its result is filled once stopped
+ * \returns void*: NULL
+ */
+static void* PonderSearch(void* ponder)
+{
 
-// /*!
-//  * \brief Adds a branch to the current movebranch
-//  * \param moveBranch: The currnet movebranch
-//  * \param move: The rankedmove intended to be added
-//  */
-// void AddBranch(MoveBranch* const moveBranch, const RankedMove* const move)
-// {
+    Ponder* run = ponder;
 
-//     MoveBranch* leaf = CreateMoveBranch(); // Creates a new branch to be added
+    run->result = SearchPosition(run->position, run->limits, run->table);
 
-//     leaf->root = moveBranch; // The root of the new branch is the current leaf
-    
-//     uint8_t branches = GetBranchNumber(moveBranch); // The number of branches in the current movebranch
-//     int8_t lowestValue = GetBranchLowestValue(moveBranch); // The lowest value of any move in the current branch
+    return NULL;
 
-//     if(branches < 20) // If there are less than 20 branches
-//     {   
+}
 
-//         moveBranch->move[branches] = move; // Adds the new move at the end of the array
-//         moveBranch->leaves[branches] = leaf; // Adds the new leaf at the end of the array
+/*!
+ * \brief Gets how much the AI may search
+ * \param ai: The AI struct
+ * \returns SearchLimits: Budget of the difficulty, harder AIs look further ahead and take longer while easier ones misjudge positions by more
+ */
+SearchLimits GetSearchLimits(const AI* const ai)
+{
 
-//         if(lowestValue > GetRankedMoveValue(move)) moveBranch->lowestvalue = GetRankedMoveValue(move); // If the value of the move being added is lower than the lowes value thats the new lowest value
-        
-//         moveBranch->branches++; // increments the number of branches
+    STATIC_ASSERT(ai, "Invalid AI Pointer");
 
-//     }
+    Difficulty difficulty = GetDifficulty(ai);
 
-//     else // If theres 20 branches
-//     {    
+    if(difficulty > Impossible) difficulty = Impossible;
 
-//         for(uint8_t i = 0; i < branches; i++) // Scans through all branches in the movebranch
-//         {
-//             if(GetRankedMoveValue(GetBranchRankedMove(moveBranch, i)) == lowestValue) // If the move has the lowest value
-//             {
+    SearchLimits limits = SearchBudgets[difficulty];
 
-//                 moveBranch->move[i] = move; // Replace the move
-//                 moveBranch->leaves[i] = leaf; // Replace the branch
-//                 setBranchLowestValue(moveBranch); // Resets the lowest value of the branch
+    if(!limits.threads) limits.threads = GetOnlineProcessors();
 
-//             }
-//         }
-//     }    
-// }
-
-// /*!
-//  * \brief Resets the lowest value of a branch
-//  * \param moveBranch: The currnet movebranch
-//  */
-// void setBranchLowestValue(MoveBranch* const movebranch)
-// {
-    
-//     int8_t lowest = GetRankedMoveValue(GetBranchRankedMove(movebranch, 0)); // Gets the value of the first move
+    return limits;
+
+}
 
-//     for(uint8_t i = 1; i < GetBranchNumber(movebranch); i++) // Scans through each branch
-//     {
+/*!
+ * \brief Evaluates the material and piece placement of the game
+ * \param data: The current gamedata
+ * \returns double: Score for white in pawns, negative when black is ahead
+ */
+double Evaluate(const GameData* const data)
+{
 
-//         if(GetRankedMoveValue(GetBranchRankedMove(movebranch, 0)) < lowest) // If the branch has a lower value than the previous ones
-//             lowest = GetRankedMoveValue(GetBranchRankedMove(movebranch, 0)); // Set the new lowest
-
-//     }
-// }
+    STATIC_ASSERT(data, "Invalid Game Data Pointer");
 
-// /*!
-//  * \brief Sets the root of the current branch
-//  * \param moveBranch: The currnet movebranch
-//  */
-// void SetBranchRoot(MoveBranch* const movebranch, const MoveBranch* const root)
-// {
+    Position position[1];
 
-//     movebranch->root = root;
-
-// }
-
-// /*!
-//  * \brief Returns the root of the current movebranch
-//  * \param moveBranch: The currnet movebranch
-//  * \returns MoveBranch*: The pointer to the root
-//  */
-// MoveBranch* GetBranchRoot(const MoveBranch* const moveBranch)
-// {
+    SetPositionFromGameData(position, data, WHITE);
 
-//     return moveBranch->root;
+    return (double)EvaluatePosition(position) / PAWNVAL;
 
-// }
-
-// /*!
-//  * \brief Returns the leaves of the current movebranch
-//  * \param moveBranch: The currnet movebranch
-//  * \param i: The index of the leaf to be grabbed
-//  * \returns MoveBranch*: The pointer to the root
-//  */
-// MoveBranch* GetBranchLeaves(const MoveBranch* const moveBranch, uint8_t i)
-// {
-
-//     return moveBranch->leaves[i];
-
-// }
-
-// /*!
-//  * \brief Returns the moves of the current movebranch
-//  * \param moveBranch: The currnet movebranch
-//  * \param i: The index of the leaf to be grabbed
-//  * \returns RankedMove*: The pointer to the RankedMove
-//  */
-// RankedMove* GetBranchRankedMove(const MoveBranch* const moveBranch, uint8_t i)
-// {
-
-//     return moveBranch->move[i];
-
-// }
-
-// /*!
-//  * \brief Returns the number of branches of the current movebranch
-//  * \param moveBranch: The currnet movebranch
-//  * \returns uint8_t: The number of branches
-//  */
-// uint8_t GetBranchNumber(const MoveBranch* const moveBranch)
-// {
-
-//     return moveBranch->branches;
+}
 
-// }
-
-// /*!
-//  * \brief Returns the lowest value of a move of the current movebranch
-//  * \param moveBranch: The currnet movebranch
-//  * \returns uint8_t: The value of the lowest move
-//  */
-// uint8_t GetBranchLowestValue(const MoveBranch* const moveBranch)
-// {
-
-//     return moveBranch->lowestvalue;
-
-// }
-
-// /*!
-//  * \brief Creates a rankedmove
-//  * \param move: The move for the rankedmove
-//  * \param value: The value of the rankedmove
-//  * \param rank: The value of the branch of the move
-//  * \returns RankedMove*: A pointer to the created rankedmove
-//  */
-// RankedMove* CreateRankedMove(const Move move, const uint8_t value, const uint32_t rank)
-// {
-
-//     RankedMove* temp;
-//     temp->move = move;
-//     temp->value = value;
-//     temp->rank = rank;
+/*!
+ * \brief Evaluates the material, piece placement and pawn structure of a position
+ * \details The midgame and endgame sums kept by the position and the cached pawn terms are blended by how many pieces are left
+ * \param position: Position to evaluate
+ * \returns int32_t: Score for the side to move in centipawns
+ */
+int32_t EvaluatePosition(const Position* const position)
+{
 
-//     return temp;
+    STATIC_ASSERT(position, "Invalid Position Pointer");
 
-// }
+    int32_t phase = (position->phase < PHASE_MAX)? position->phase: PHASE_MAX; // Promotions can push it past the start
+    int32_t midgame = position->midgame;
+    int32_t endgame = position->endgame;
 
-// /*!
-//  * \brief Sets the value of a rankedmove
-//  * \param RankedMove: The current rankedmove
-//  * \param value: The value to set to
-//  */
-// void SetRankedMoveValue(RankedMove* const rankedMove, const uint8_t value)
-// {
+    AddPawnScores(position, &midgame, &endgame);
 
-//     rankedMove->value == value;
-
-// }
+    int32_t score = (midgame * phase + endgame * (PHASE_MAX - phase)) / PHASE_MAX;
 
-// /*!
-//  * \brief Sets the rank of a rankedmove
-//  * \param RankedMove: The current rankedmove
-//  * \param rank: The value to add
-//  */
-// void SetRankedMoveRank(RankedMove* const rankedMove, const uint32_t rank)
-// {
-
-//     rankedMove->rank += rank;
-
-// }
+    return position->isWhite? score: -score;
 
-// /*!
-//  * \brief Gets the move of the ranked move
-//  * \param RankedMove: The current rankedmove
-//  * \returns Move: The move
-//  */
-// Move GetRankedMoveMove(const RankedMove* const rankedMove)
-// {
-
-//     return (rankedMove->move);
-
-// }
+}
 
-// /*!
-//  * \brief Gets the value of the ranked move
-//  * \param RankedMove: The current rankedmove
-//  * \returns uint8_t: The value of the move
-//  */
-// uint8_t GetRankedMoveValue(const RankedMove* const rankedMove)
-// {
+/*!
+ * \brief Predetermines values for each players piece used for minmax algorithm
+ * \param piece player piece
+ * \returns Determined piece value
+ */
+uint32_t GetPieceValue(const Piece piece)
+{
 
-//     return (rankedMove->value);
-
-// }
+    switch (GetPieceID(piece))
+    {
 
-// /*!
-//  * \brief Gets the rank of the ranked move
-//  * \param RankedMove: The current rankedmove
-//  * \returns uint32_t: The rank of the move
-//  */
-// uint32_t GetRankedMoveRank(const RankedMove* const rankedMove)
-// {
+        case PAWN: return PAWNVAL;
+        case KNIGHT: return KNIGHTVAL;
+        case BISHOP: return BISHOPVAL;
+        case ROOK: return ROOKVAL;
+        case QUEEN: return QUEENVAL;
+        case KING: return KINGVAL;    
+        default: return 0;
 
-//     return (rankedMove->rank);
-
-// }
+    }
+}
 
-// // EOF //
+// EOF //
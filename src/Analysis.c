@@ -0,0 +1,414 @@
+/*!
+ * \file Analysis.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the Analysis Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Analysis.h"
+#include "Notation.h"
+#include "ThreadPool.h"
+
+// ------------------------- Functions ------------------------- //
+
+/// Reads the moves of a bm or am operation
+static void ParseEPDMoves(Position* const position, const PositionMoveList* const legal, const char* operands, const char* const end,
+    Move* const moves, uint8_t* const count);
+
+/// Checks if a move is in a list
+static bool IsListedMove(const Move* const moves, const uint8_t count, const Move move);
+
+/// Writes a string as a field of the output format
+static void WriteField(char* const buffer, const size_t size, const char* const text, const AnalysisFormat format);
+
+/// Reads the next line of the input and gives it a number
+static bool ReadAnalysisLine(Analysis* const analysis, char line[ANALYSIS_LINE_MAX], size_t* const number);
+
+/// Analyzes lines until the input runs out
+static void* AnalysisWorker(void* analysis);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Reads the moves of a bm or am operation, SAN like EPD uses or UCI
+ * \param position: Position the moves are played in
+ * \param legal: Legal moves of the position
+ * \param operands: Start of the moves
+ * \param end: End of the operation
+ * \param moves: Filled with the legal moves that were read
+ * \param count: Filled with the number of moves
+ */
+static void ParseEPDMoves(Position* const position, const PositionMoveList* const legal, const char* operands, const char* const end,
+    Move* const moves, uint8_t* const count)
+{
+
+    char token[SAN_LENGTH + 4];
+
+    *count = 0;
+
+    while(operands < end && *count < ANALYSIS_MAX_MOVES)
+    {
+
+        while(operands < end && *operands == ' ') operands++;
+
+        size_t length = 0;
+
+        for(; operands < end && *operands != ' '; operands++)
+            if(length + 1 < sizeof(token)) token[length++] = *operands;
+
+        if(!length) break;
+
+        token[length] = '\0';
+
+        Move move = SANToMove(position, legal, token);
+
+        if(!move.piece) move = UCIToMove(position, legal, token);
+
+        if(move.piece) moves[(*count)++] = move;
+
+    }
+}
+
+/*!
+ * \brief Reads a line of an EPD or FEN file
+ * \details The position comes first, an EPD then has operations ended by semicolons, of which only bm, am and id are kept
+ * \param line: Line to read
+ * \param epd: Filled with the position and its operations
+ * \returns bool: True if the line has a legal position
+ */
+bool ParseEPDLine(const char* const line, EPDLine* const epd)
+{
+
+    STATIC_ASSERT(line, "Invalid Line Pointer");
+    STATIC_ASSERT(epd, "Invalid EPD Pointer");
+
+    PositionMoveList legal[1];
+    const char* c = SetPositionFromFEN(epd->position, line);
+
+    epd->id[0] = '\0';
+    epd->bestcount = 0;
+    epd->avoidcount = 0;
+
+    if(!c) return false;
+
+    GenerateLegalMoves(epd->position, legal);
+
+    while(*c) // One operation at a time, "opcode operands;"
+    {
+
+        while(*c == ' ' || *c == ';') c++;
+
+        const char* opcode = c;
+
+        while(*c && *c != ' ' && *c != ';' && *c != '\n' && *c != '\r') c++;
+
+        size_t length = c - opcode;
+
+        if(!length) break;
+
+        const char* operands = c;
+        bool quoted = false;
+
+        for(; *c && *c != '\n' && *c != '\r' && (quoted || *c != ';'); c++) // Semicolons inside a string don't end it
+            if(*c == '"') quoted = !quoted;
+
+        if(length == 2 && !strncmp(opcode, "bm", 2)) ParseEPDMoves(epd->position, legal, operands, c, epd->best, &epd->bestcount);
+
+        else if(length == 2 && !strncmp(opcode, "am", 2)) ParseEPDMoves(epd->position, legal, operands, c, epd->avoid, &epd->avoidcount);
+
+        else if(length == 2 && !strncmp(opcode, "id", 2))
+        {
+
+            while(operands < c && (*operands == ' ' || *operands == '"')) operands++;
+
+            size_t size = 0;
+
+            for(; operands < c && *operands != '"' && size + 1 < ANALYSIS_ID_MAX; operands++)
+                epd->id[size++] = *operands;
+
+            while(size && epd->id[size - 1] == ' ') size--;
+
+            epd->id[size] = '\0';
+
+        }
+
+        if(*c == '\n' || *c == '\r') break;
+
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief Checks if a move is one of a list
+ * \param moves: Moves to look through
+ * \param count: Number of moves
+ * \param move: Move to look for
+ * \returns bool: True if it is listed
+ */
+static bool IsListedMove(const Move* const moves, const uint8_t count, const Move move)
+{
+
+    for(uint8_t i = 0; i < count; i++)
+        if(IsSameMove(moves[i], move)) return true;
+
+    return false;
+
+}
+
+/*!
+ * \brief Writes a string as a quoted field, escaping what the format needs
+ * \param buffer: Buffer to write to, always terminated
+ * \param size: Size of the buffer
+ * \param text: String to write
+ * \param format: CSV doubles its quotes and JSON escapes quotes, backslashes and control characters
+ */
+static void WriteField(char* const buffer, const size_t size, const char* const text, const AnalysisFormat format)
+{
+
+    size_t length = 0;
+
+    buffer[length++] = '"';
+
+    for(const char* c = text; *c && length + 3 < size; c++)
+    {
+
+        if(*c == '"') buffer[length++] = (format == AnalysisCSV)? '"': '\\';
+        else if(*c == '\\' && format == AnalysisJSON) buffer[length++] = '\\';
+        else if((unsigned char)*c < ' ') continue; // Nothing in an id needs them
+
+        buffer[length++] = *c;
+
+    }
+
+    buffer[length++] = '"';
+    buffer[length] = '\0';
+
+}
+
+/*!
+ * \brief Reads the next line of the input, lines are numbered in the order they are in the file
+ * \param analysis: Analysis to read from
+ * \param line: Filled with the line, emptied if it was too long
+ * \param number: Filled with the number of the line
+ * \returns bool: False once the input runs out
+ */
+static bool ReadAnalysisLine(Analysis* const analysis, char line[ANALYSIS_LINE_MAX], size_t* const number)
+{
+
+    pthread_mutex_lock(&analysis->lock);
+
+    bool read = fgets(line, ANALYSIS_LINE_MAX, analysis->input) != NULL;
+
+    if(read && !strchr(line, '\n') && !feof(analysis->input)) // Too long, skip the rest of it and let it be reported
+    {
+
+        int c;
+
+        while((c = fgetc(analysis->input)) != EOF && c != '\n');
+
+        line[0] = '\0';
+
+    }
+
+    if(read) *number = ++analysis->lines;
+
+    pthread_mutex_unlock(&analysis->lock);
+
+    return read;
+
+}
+
+/*!
+ * \brief Analyzes lines until the input runs out
+ * \details Every worker is its own engine, with its own table and the search state of its thread, only the input and output are shared
+ * \param analysis: Analysis to work on
+ * \returns void*: NULL
+ */
+static void* AnalysisWorker(void* analysis)
+{
+
+    Analysis* run = analysis;
+    TranspositionTable* table = CreateTable(run->hash);
+    char line[ANALYSIS_LINE_MAX];
+    char record[ANALYSIS_RECORD_MAX];
+    size_t number;
+
+    static __thread EPDLine epd[1]; // Holds two large move lists, one per thread
+
+    while(ReadAnalysisLine(run, line, &number))
+    {
+
+        const char* start = line;
+
+        while(isspace((unsigned char)*start)) start++;
+
+        if(!*start && line[0]) continue; // Blank lines are skipped, an emptied long line isn't
+
+        if(*start == '#') continue; // Comments
+
+        char id[2 * ANALYSIS_ID_MAX + 3];
+        const char* verdict = NULL;
+
+        if(!ParseEPDLine(line, epd))
+        {
+
+            if(run->format == AnalysisCSV) snprintf(record, sizeof(record), "%zu,,,,,,,,,invalid\n", number);
+            else snprintf(record, sizeof(record), "{\"line\":%zu,\"result\":\"invalid\"}\n", number);
+
+            pthread_mutex_lock(&run->lock);
+            fputs(record, run->output);
+            fflush(run->output);
+            run->invalid++;
+            pthread_mutex_unlock(&run->lock);
+
+            continue;
+
+        }
+
+        if(table) ClearTable(table); // Every position stands on its own
+
+        SearchResult result = SearchPosition(epd->position, run->limits, table);
+
+        char san[SAN_LENGTH] = "";
+        char uci[UCI_LENGTH] = "";
+        char mate[16] = "";
+
+        if(result.best.piece)
+        {
+
+            MoveToSAN(epd->position, NULL, result.best, san);
+            MoveToUCI(result.best, uci);
+
+        }
+
+        if(abs(result.score) >= MATE_BOUND) // Moves to mate, negative when getting mated
+            snprintf(mate, sizeof(mate), "%d", (result.score > 0)? (MATE_SCORE - result.score + 1) / 2: -(MATE_SCORE + result.score) / 2);
+
+        if(epd->bestcount) verdict = IsListedMove(epd->best, epd->bestcount, result.best)? "pass": "fail";
+
+        if(epd->avoidcount && (!verdict || !strcmp(verdict, "pass"))) verdict = IsListedMove(epd->avoid, epd->avoidcount, result.best)? "fail": "pass";
+
+        WriteField(id, sizeof(id), epd->id, run->format);
+
+        if(run->format == AnalysisCSV)
+            snprintf(record, sizeof(record), "%zu,%s,%s,%s,%d,%s,%u,%llu,%u,%s\n", number, id, san, uci, result.score, mate,
+                result.depth, (unsigned long long)result.nodes, result.time, verdict? verdict: "");
+
+        else
+            snprintf(record, sizeof(record), "{\"line\":%zu,\"id\":%s,\"best\":\"%s\",\"uci\":\"%s\",\"score\":%d,\"mate\":%s,\"depth\":%u,"
+                "\"nodes\":%llu,\"time\":%u,\"result\":%s%s%s}\n", number, id, san, uci, result.score, *mate? mate: "null",
+                result.depth, (unsigned long long)result.nodes, result.time, verdict? "\"": "", verdict? verdict: "null", verdict? "\"": "");
+
+        pthread_mutex_lock(&run->lock); // Written as soon as it is done so a long run can be followed
+
+        fputs(record, run->output);
+        fflush(run->output);
+
+        run->positions++;
+
+        if(verdict && !strcmp(verdict, "pass")) run->passed++;
+        else if(verdict) run->failed++;
+
+        pthread_mutex_unlock(&run->lock);
+
+    }
+
+    DeleteTable(table);
+
+    return NULL;
+
+}
+
+/*!
+ * \brief Analyzes every position of an EPD or FEN file
+ * \details The lines are shared out to one task on the shared thread pool per search thread of the settings, or per processor if that is zero
+ * Each worker searches on one thread with its share of the hash size, the network and tablebase of the settings are shared by all of them
+ * A summary is printed to stderr once every line is done
+ * \param settings: Settings with the thread count, hash size, pruning, network and tablebase to use
+ * \param input: File to read, "-" for stdin
+ * \param output: File to write the records to, NULL or "-" for stdout
+ * \param format: Format of the records
+ * \param limits: Depth and time of each position, ANALYSIS_DEFAULT_TIME if both are zero
+ * \returns bool: True if the files could be opened
+ */
+bool RunAnalysis(const Settings* const settings, const char* const input, const char* const output, const AnalysisFormat format, const SearchLimits limits)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+    STATIC_ASSERT(input, "Invalid Input Pointer");
+
+    Analysis analysis = {0};
+    Task workers[SEARCH_MAX_THREADS];
+    ThreadPool* pool = GetThreadPool();
+    uint8_t count = GetSearchThreads(settings)? GetSearchThreads(settings): GetOnlineProcessors();
+
+    analysis.input = strcmp(input, "-")? fopen(input, "r"): stdin;
+    analysis.output = (output && strcmp(output, "-"))? fopen(output, "w"): stdout;
+
+    if(!analysis.input || !analysis.output)
+    {
+
+        fprintf(stderr, "Can't open %s\n", analysis.input? output: input);
+
+        if(analysis.input && analysis.input != stdin) fclose(analysis.input);
+        if(analysis.output && analysis.output != stdout) fclose(analysis.output);
+
+        return false;
+
+    }
+
+    if(count > SEARCH_MAX_THREADS) count = SEARCH_MAX_THREADS;
+
+    if(count > 1) // A worker of the pool for every share but the one run here, fewer shares if the workers can't be made
+    {
+
+        uint8_t reserved = ReserveWorkers(pool, count - 1);
+
+        if(reserved < count - 1) count = reserved + 1;
+
+    }
+
+    analysis.format = format;
+    analysis.limits = limits;
+    analysis.limits.threads = 1; // The workers are the parallelism
+    analysis.limits.pruning &= GetSearchPruning(settings);
+    analysis.limits.network = CreateNetwork(GetNetworkFile(settings));
+    analysis.limits.tablebase = CreateTablebase(GetTablebaseDirectory(settings));
+    analysis.hash = (GetHashSize(settings) / count)? GetHashSize(settings) / count: 1;
+
+    if(!analysis.limits.depth && !analysis.limits.time && !analysis.limits.nodes) analysis.limits.time = ANALYSIS_DEFAULT_TIME;
+
+    pthread_mutex_init(&analysis.lock, NULL);
+
+    if(format == AnalysisCSV) fputs("line,id,best,uci,score,mate,depth,nodes,time,result\n", analysis.output);
+
+    for(uint8_t i = 1; i < count; i++) // Every worker takes positions off the same input until it runs out
+        SubmitTask(pool, &workers[i], AnalysisWorker, &analysis);
+
+    AnalysisWorker(&analysis);
+
+    for(uint8_t i = 1; i < count; i++)
+        WaitTask(pool, &workers[i]);
+
+    fprintf(stderr, "%zu positions, %zu passed, %zu failed, %zu invalid lines, %u workers\n", analysis.positions, analysis.passed, analysis.failed,
+        analysis.invalid, count);
+
+    pthread_mutex_destroy(&analysis.lock);
+
+    DeleteNetwork((Network*)analysis.limits.network);
+    DeleteTablebase((Tablebase*)analysis.limits.tablebase);
+
+    if(analysis.input != stdin) fclose(analysis.input);
+    if(analysis.output != stdout) fclose(analysis.output);
+
+    return true;
+
+}
+
+// EOF //
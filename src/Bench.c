@@ -0,0 +1,650 @@
+/*!
+ * \file Bench.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the Bench Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#define _POSIX_C_SOURCE 200809L // clock_gettime isn't part of plain C99
+
+#include "Bench.h"
+#include "Notation.h"
+#include "MoveOrder.h"
+#include "Book.h"
+#include "Retrograde.h"
+
+// ------------------------- Tables ------------------------- //
+
+/// Bench positions as UCI moves from the starting position, an opening, a middlegame and an endgame
+static const char* const BenchLines[] =
+{
+
+    "",
+    "e2e4 c7c5 g1f3 d7d6 d2d4 c5d4 f3d4 g8f6 b1c3 a7a6",
+    "d2d4 g8f6 c2c4 e7e6 b1c3 f8b4 e2e3 e8g8 f1d3 d7d5 g1f3 c7c5 e1g1 b8c6 a2a3 b4c3 b2c3 d8c7",
+    "e2e4 e7e5 g1f3 b8c6 f1b5 a7a6 b5a4 g8f6 e1g1 f8e7 f1e1 b7b5 a4b3 d7d6 c2c3 e8g8 h2h3 c6a5 b3c2 c7c5 d2d4 d8c7",
+    "e2e4 e7e5 d2d4 e5d4 d1d4 b8c6 d4e3 g8f6 b1c3 f8b4 c1d2 e8g8 e1c1 f8e8 e3g3 e8e4 c3e4 f6e4 g3g7 g8g7 d2b4 e4f2 d1e1 f2h1 b4c3 g7g8"
+
+};
+
+/// Thread counts the scaling bench measures
+static const uint8_t BenchThreads[] = {1, 2, 4, 8, 16, 32};
+
+/// Pruning techniques the pruning bench switches, in the order of their flags
+static const uint8_t BenchPruning[] = {PRUNE_NULL_MOVE, PRUNE_LATE_MOVES, PRUNE_FUTILITY, PRUNE_RAZORING, PRUNE_PVS, PRUNE_ASPIRATION};
+
+/// Names of the pruning techniques
+static const char* const BenchPruningNames[] = {"null move", "late moves", "futility", "razoring", "pvs", "aspiration"};
+
+/*!
+ * \brief A perft position and its leaf counts
+ * \details The well known counts of the starting position, Kiwipete and the other positions the chess programming community checks against
+ */
+typedef struct
+{
+
+    const char* fen;                         ///< Position
+    uint64_t nodes[BENCH_PERFT_MAX];         ///< Leaf nodes from depth 1 to BENCH_PERFT_MAX
+
+} PerftPosition;
+
+/// Perft positions, between them they cover castling, en passant, promotions, pins and checks
+static const PerftPosition PerftPositions[] =
+{
+
+    {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", {20, 400, 8902, 197281, 4865609}},
+    {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", {48, 2039, 97862, 4085603, 193690690}},
+    {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", {14, 191, 2812, 43238, 674624}},
+    {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", {6, 264, 9467, 422333, 15833292}},
+    {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", {44, 1486, 62379, 2103487, 89941194}}
+
+};
+
+/// Test positions of the Polyglot format as UCI moves from the starting position, with castling, en passant and an en passant capture
+static const char* const BookKeyLines[] =
+{
+
+    "",
+    "e2e4",
+    "e2e4 d7d5",
+    "e2e4 d7d5 e4e5",
+    "e2e4 d7d5 e4e5 f7f5",
+    "e2e4 d7d5 e4e5 f7f5 e1e2",
+    "e2e4 d7d5 e4e5 f7f5 e1e2 e8f7",
+    "a2a4 b7b5 h2h4 b5b4 c2c4",
+    "a2a4 b7b5 h2h4 b5b4 c2c4 b4c3 a1a3"
+
+};
+
+/// Published Polyglot key of each test position
+static const uint64_t BookKeys[] =
+{
+
+    0x463B96181691FC9Cull, 0x823C9B50FD114196ull, 0x0756B94461C50FB0ull, 0x662FAFB965DB29D4ull, 0x22A48B5A8E47FF78ull,
+    0x652A607CA3F242C1ull, 0x00FDD303C946BDD9ull, 0x3C8123EA7B067637ull, 0x5C3F9B829B279560ull
+
+};
+
+/*!
+ * \brief An endgame table and the longest distance to zeroing it should have
+ * \details The distances are in plies to a capture, pawn move or mate, the same as the distance files keep
+ */
+typedef struct
+{
+
+    const char* material;        ///< Material of the table, the side before the v is white
+    const char* fen;             ///< Some position of the material, to get its key
+    uint8_t longest;             ///< Most plies to zeroing of any entry
+
+} TablebaseLongest;
+
+/// Tables the tablebase check generates, the smaller ones first
+static const TablebaseLongest TablebaseChecks[] =
+{
+
+    {"KRvK", "4k3/8/8/8/8/8/8/R3K3 w - - 0 1", 32},
+    {"KQvK", "4k3/8/8/8/8/8/8/3QK3 w - - 0 1", 20},
+    {"KPvK", "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1", 20},
+    {"KQvKR", "3rk3/8/8/8/8/8/8/3QK3 w - - 0 1", 62}
+
+};
+
+// ------------------------- Functions ------------------------- //
+
+/// Plays a line of UCI moves from the starting position
+static bool SetBenchPosition(Position* const position, const char* const line);
+
+/// Searches every bench position and prints a row with the totals
+static void RunPruningRow(FILE* const file, const char* const name, const SearchLimits limits, TranspositionTable* const table,
+    const uint64_t basenodes, const uint64_t basetime, uint64_t* const nodes, uint64_t* const time);
+
+/// Counts the leaf nodes below a position, checking the notation of every move above the last ply
+static uint64_t Perft(Position* const position, const uint8_t depth, uint64_t* const errors);
+
+/// Checks that a move reads back from its UCI and SAN notation
+static bool CheckMoveNotation(Position* const position, const PositionMoveList* const legal, const Move move);
+
+/// Works out the table value of a position from the values of the positions after each of its moves
+static bool GetChildrenValue(const Tablebase* const tablebase, Position* const position, int8_t* const value);
+
+/// Checks every entry of a table against its children and gets its longest distance
+static uint64_t CheckTablebaseFile(const Tablebase* const tablebase, const TablebaseFile* const table, uint8_t* const longest);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Builds a bench position by playing its moves
+ * \param position: Position to fill
+ * \param line: Moves in UCI notation separated by spaces
+ * \returns bool: True if every move was legal
+ */
+static bool SetBenchPosition(Position* const position, const char* const line)
+{
+
+    PositionUndo undo;
+
+    ResetPosition(position);
+
+    for(const char* c = line; *c; ) // One move at a time
+    {
+
+        while(*c == ' ') c++;
+
+        if(!*c) break;
+
+        Move move = UCIToMove(position, NULL, c);
+
+        if(!move.piece) return false;
+
+        MakePositionMove(position, move, &undo);
+
+        while(*c && *c != ' ') c++;
+
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief Measures how the time to reach a depth scales with the number of search threads
+ * \details Every thread count searches every bench position to the same depth with a fresh table, the speedup is against one thread
+ * \param file: File to print the table to
+ * \param depth: Depth to search to, zero for BENCH_SCALING_DEPTH
+ */
+void RunScalingBench(FILE* const file, const uint8_t depth)
+{
+
+    STATIC_ASSERT(file, "Invalid File Pointer");
+
+    const size_t positions = sizeof(BenchLines) / sizeof(BenchLines[0]);
+
+    TranspositionTable* table = CreateTable(BENCH_TABLE_MB);
+    SearchLimits limits = GetDepthLimits(depth? depth: BENCH_SCALING_DEPTH);
+    Position position[1];
+    uint64_t base = 0;
+
+    fprintf(file, "Time to depth %u on %zu positions, %u processors online\n\n", limits.depth, positions, GetOnlineProcessors());
+    fprintf(file, "%8s %12s %14s %8s %12s %8s\n", "threads", "time (ms)", "nodes", "qnodes", "knps", "speedup");
+
+    for(size_t i = 0; i < sizeof(BenchThreads); i++)
+    {
+
+        uint64_t time = 0;
+        uint64_t nodes = 0;
+        uint64_t qnodes = 0;
+
+        limits.threads = BenchThreads[i];
+
+        for(size_t j = 0; j < positions; j++)
+        {
+
+            if(!SetBenchPosition(position, BenchLines[j])) continue;
+
+            if(table) ClearTable(table); // Every run starts cold
+
+            SearchResult result = SearchPosition(position, limits, table);
+
+            time += result.time;
+            nodes += result.nodes;
+            qnodes += result.qnodes;
+
+        }
+
+        if(!base) base = time? time: 1;
+
+        fprintf(file, "%8u %12llu %14llu %7.1f%% %12llu %8.2f\n", limits.threads, (unsigned long long)time, (unsigned long long)nodes,
+            100.0 * qnodes / (nodes? nodes: 1), (unsigned long long)(nodes / (time? time: 1)), (double)base / (time? time: 1));
+
+    }
+
+    DeleteTable(table);
+
+}
+
+/*!
+ * \brief Searches every bench position with one set of pruning techniques and prints the totals
+ * \param file: File to print the row to
+ * \param name: Name of the row
+ * \param limits: Limits of every search
+ * \param table: Table cleared before every search, NULL for none
+ * \param basenodes: Nodes the row is compared to, zero for no comparison
+ * \param basetime: Milliseconds the row is compared to
+ * \param nodes: Filled with the total nodes
+ * \param time: Filled with the total milliseconds
+ */
+static void RunPruningRow(FILE* const file, const char* const name, const SearchLimits limits, TranspositionTable* const table,
+    const uint64_t basenodes, const uint64_t basetime, uint64_t* const nodes, uint64_t* const time)
+{
+
+    Position position[1];
+
+    *nodes = 0;
+    *time = 0;
+
+    for(size_t i = 0; i < sizeof(BenchLines) / sizeof(BenchLines[0]); i++)
+    {
+
+        if(!SetBenchPosition(position, BenchLines[i])) continue;
+
+        if(table) ClearTable(table); // Every run starts cold
+
+        SearchResult result = SearchPosition(position, limits, table);
+
+        *nodes += result.nodes;
+        *time += result.time;
+
+    }
+
+    fprintf(file, "%-16s %14llu %12llu", name, (unsigned long long)*nodes, (unsigned long long)*time);
+
+    if(basenodes) fprintf(file, " %+11.1f%% %+11.1f%%", 100.0 * ((double)*nodes - basenodes) / basenodes, 100.0 * ((double)*time - basetime) / (basetime? basetime: 1));
+
+    fputc('\n', file);
+
+}
+
+/*!
+ * \brief Measures what each pruning technique saves on its own and what it still adds on top of the others
+ * \details Every row searches every bench position to the same depth on one thread with a fresh table
+ * The first block turns one technique on at a time against none, the second turns one off at a time against all of them
+ * \param file: File to print the table to
+ * \param depth: Depth to search to, zero for BENCH_PRUNING_DEPTH
+ */
+void RunPruningBench(FILE* const file, const uint8_t depth)
+{
+
+    STATIC_ASSERT(file, "Invalid File Pointer");
+
+    const size_t techniques = sizeof(BenchPruning);
+
+    TranspositionTable* table = CreateTable(BENCH_TABLE_MB);
+    SearchLimits limits = GetDepthLimits(depth? depth: BENCH_PRUNING_DEPTH);
+    uint64_t basenodes, basetime, nodes, time;
+    char name[32];
+
+    fprintf(file, "Nodes and time to depth %u on %zu positions with one thread\n\n", limits.depth, sizeof(BenchLines) / sizeof(BenchLines[0]));
+    fprintf(file, "%-16s %14s %12s %12s %12s\n", "pruning", "nodes", "time (ms)", "nodes", "time");
+
+    limits.pruning = 0;
+    RunPruningRow(file, "none", limits, table, 0, 0, &basenodes, &basetime);
+
+    for(size_t i = 0; i < techniques; i++) // Each one alone against none
+    {
+
+        snprintf(name, sizeof(name), "+ %s", BenchPruningNames[i]);
+
+        limits.pruning = BenchPruning[i];
+        RunPruningRow(file, name, limits, table, basenodes, basetime, &nodes, &time);
+
+    }
+
+    fputc('\n', file);
+
+    limits.pruning = PRUNE_ALL;
+    RunPruningRow(file, "all", limits, table, 0, 0, &basenodes, &basetime);
+
+    for(size_t i = 0; i < techniques; i++) // Each one left out against all
+    {
+
+        snprintf(name, sizeof(name), "- %s", BenchPruningNames[i]);
+
+        limits.pruning = PRUNE_ALL & ~BenchPruning[i];
+        RunPruningRow(file, name, limits, table, basenodes, basetime, &nodes, &time);
+
+    }
+
+    DeleteTable(table);
+
+}
+
+/*!
+ * \brief Checks that a move reads back as itself from both of its notations
+ * \param position: Position the move is played in
+ * \param legal: Legal moves of the position
+ * \param move: Move to check
+ * \returns bool: True if the UCI and SAN strings of the move read back as the same move
+ */
+static bool CheckMoveNotation(Position* const position, const PositionMoveList* const legal, const Move move)
+{
+
+    char uci[UCI_LENGTH];
+    char san[SAN_LENGTH];
+
+    MoveToUCI(move, uci);
+    MoveToSAN(position, legal, move, san);
+
+    if(IsSameMove(UCIToMove(position, legal, uci), move) && IsSameMove(SANToMove(position, legal, san), move)) return true;
+
+    fprintf(stderr, "%s (%s) doesn't read back\n", uci, san);
+
+    return false;
+
+}
+
+/*!
+ * \brief Counts the leaf nodes below a position
+ * \details The notation is checked on every ply but the last, which has nearly all the moves and would only check the same moves again
+ * \param position: Position to count from, it is left as it was
+ * \param depth: Plies to count
+ * \param errors: Incremented for every move whose notation doesn't read back
+ * \returns uint64_t: Positions at the depth
+ */
+static uint64_t Perft(Position* const position, const uint8_t depth, uint64_t* const errors)
+{
+
+    PositionMoveList list[1];
+    PositionUndo undo;
+    uint64_t nodes = 0;
+
+    GenerateLegalMoves(position, list);
+
+    if(depth == 1) return list->size;
+
+    for(size_t i = 0; i < list->size; i++)
+    {
+
+        if(!CheckMoveNotation(position, list, list->move[i])) (*errors)++;
+
+        MakePositionMove(position, list->move[i], &undo);
+        nodes += Perft(position, depth - 1, errors);
+        UnmakePositionMove(position, list->move[i], &undo);
+
+    }
+
+    return nodes;
+
+}
+
+/*!
+ * \brief Counts the leaf nodes of every perft position at every depth and checks them against the known counts
+ * \details Every move above the last ply also has to read back from its UCI and SAN notation
+ * \param file: File to print the counts to
+ * \param depth: Deepest depth to count, zero for BENCH_PERFT_DEPTH, at most BENCH_PERFT_MAX
+ * \returns bool: True if every count matched and every move read back
+ */
+bool RunPerftCheck(FILE* const file, const uint8_t depth)
+{
+
+    STATIC_ASSERT(file, "Invalid File Pointer");
+
+    uint8_t deepest = depth? depth: BENCH_PERFT_DEPTH;
+    bool passed = true;
+
+    if(deepest > BENCH_PERFT_MAX) deepest = BENCH_PERFT_MAX;
+
+    fprintf(file, "%-5s %12s %12s %8s %12s %s\n", "depth", "nodes", "expected", "errors", "time (ms)", "position");
+
+    for(size_t i = 0; i < sizeof(PerftPositions) / sizeof(PerftPositions[0]); i++)
+    {
+
+        Position position[1];
+
+        if(!SetPositionFromFEN(position, PerftPositions[i].fen))
+        {
+
+            fprintf(file, "Can't read %s\n", PerftPositions[i].fen);
+            passed = false;
+            continue;
+
+        }
+
+        for(uint8_t d = 1; d <= deepest; d++)
+        {
+
+            struct timespec start;
+            struct timespec end;
+            uint64_t errors = 0;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+
+            uint64_t nodes = Perft(position, d, &errors);
+
+            clock_gettime(CLOCK_MONOTONIC, &end);
+
+            uint64_t time = (uint64_t)((end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000);
+            bool matched = nodes == PerftPositions[i].nodes[d - 1] && !errors;
+
+            fprintf(file, "%-5u %12llu %12llu %8llu %12llu %s%s\n", d, (unsigned long long)nodes, (unsigned long long)PerftPositions[i].nodes[d - 1],
+                (unsigned long long)errors, (unsigned long long)time, PerftPositions[i].fen, matched? "": " FAILED");
+
+            passed &= matched;
+
+        }
+    }
+
+    fprintf(file, "%s\n", passed? "Every count matched": "Some counts didn't match");
+
+    return passed;
+
+}
+
+/*!
+ * \brief Checks GetBookKey against the keys the Polyglot format publishes for its test positions
+ * \param file: File to print the keys to
+ * \returns bool: True if every key matched
+ */
+bool RunBookKeyCheck(FILE* const file)
+{
+
+    STATIC_ASSERT(file, "Invalid File Pointer");
+
+    bool passed = true;
+
+    for(size_t i = 0; i < sizeof(BookKeys) / sizeof(BookKeys[0]); i++)
+    {
+
+        Position position[1];
+        uint64_t key = SetBenchPosition(position, BookKeyLines[i])? GetBookKey(position): 0;
+
+        fprintf(file, "%016llx %016llx %s%s\n", (unsigned long long)key, (unsigned long long)BookKeys[i], *BookKeyLines[i]? BookKeyLines[i]: "startpos",
+            (key == BookKeys[i])? "": " FAILED");
+
+        passed &= key == BookKeys[i];
+
+    }
+
+    fprintf(file, "%s\n", passed? "Every key matched": "Some keys didn't match");
+
+    return passed;
+
+}
+
+/*!
+ * \brief Works out the table value a position should have from the values of the positions after each of its moves
+ * \details A win takes the fastest move that leaves the opponent lost, a loss the slowest move, a capture or pawn move counting as one ply
+ * \param tablebase: Tables of the position and every capture and promotion from it
+ * \param position: Position to work out, left as it was
+ * \param value: Set to the value the table should hold
+ * \returns bool: True if every child was in the tables
+ */
+static bool GetChildrenValue(const Tablebase* const tablebase, Position* const position, int8_t* const value)
+{
+
+    PositionMoveList list[1];
+    PositionUndo undo;
+    int16_t win = INT16_MAX;
+    int16_t loss = 0;
+    bool drawn = false;
+    bool found = true;
+
+    GenerateLegalMoves(position, list);
+
+    if(!list->size)
+    {
+
+        *value = IsPositionInCheck(position)? -1: 0;
+        return true;
+
+    }
+
+    for(size_t i = 0; i < list->size && found; i++)
+    {
+
+        Move move = list->move[i];
+        bool zeroing = IsCaptureMove(position, move) || GetPieceType(move.piece) == PawnType;
+        int8_t child = 0;
+
+        MakePositionMove(position, move, &undo);
+
+        if(CountSquares(position->occupancy[WHITE] | position->occupancy[BLACK]) > 2) found = ProbeTablebase(tablebase, position, &child);
+
+        UnmakePositionMove(position, move, &undo);
+
+        int16_t plies = zeroing? 1: TablebaseDTZ(child) + 1;
+
+        if(child < 0 && plies < win) win = plies;
+        else if(!child) drawn = true;
+        else if(child > 0 && plies > loss) loss = plies;
+
+    }
+
+    *value = (win < INT16_MAX)? win + 1: drawn? 0: -(loss + 1);
+
+    return found;
+
+}
+
+/*!
+ * \brief Checks the value of every entry of a table against the one its children give
+ * \param tablebase: Tables of the directory, the table and every table it leads to
+ * \param table: Table to check
+ * \param longest: Set to the most plies to zeroing of any entry
+ * \returns uint64_t: Entries whose value didn't match
+ */
+static uint64_t CheckTablebaseFile(const Tablebase* const tablebase, const TablebaseFile* const table, uint8_t* const longest)
+{
+
+    uint64_t errors = 0;
+
+    *longest = 0;
+
+    for(size_t index = 0; index < table->entries; index++)
+    {
+
+        Position position[1];
+        int8_t value = 0;
+        int8_t expected = 0;
+
+        if(!SetTablebasePosition(position, table->material, index)) continue; // Not a legal position, never looked up
+
+        if(!ProbeTablebase(tablebase, position, &value) || !GetChildrenValue(tablebase, position, &expected) || value != expected)
+        {
+
+            errors++;
+            continue;
+
+        }
+
+        if(value && TablebaseDTZ(value) > *longest) *longest = (uint8_t)TablebaseDTZ(value);
+
+    }
+
+    return errors;
+
+}
+
+/*!
+ * \brief Generates the checked endgame tables if they aren't there yet, checks every entry against its children and the longest distance of each
+ * \param file: File to print the results to
+ * \param directory: Directory of the tables, created if it isn't there
+ * \param threads: Threads the generation uses, zero for one per processor
+ * \returns bool: True if every entry and every longest distance matched
+ */
+bool RunTablebaseCheck(FILE* const file, const char* const directory, const uint8_t threads)
+{
+
+    STATIC_ASSERT(file, "Invalid File Pointer");
+    STATIC_ASSERT(directory, "Invalid Directory Pointer");
+
+    bool passed = true;
+
+    for(size_t i = 0; i < sizeof(TablebaseChecks) / sizeof(TablebaseChecks[0]); i++)
+    {
+
+        if(!GenerateTablebase(directory, TablebaseChecks[i].material, threads, NULL))
+        {
+
+            fprintf(file, "Couldn't generate %s into %s\n", TablebaseChecks[i].material, directory);
+            return false;
+
+        }
+    }
+
+    Tablebase* tablebase = CreateTablebase(directory);
+
+    fprintf(file, "%-6s %8s %8s %8s %12s\n", "table", "longest", "expected", "errors", "time (ms)");
+
+    for(size_t i = 0; i < sizeof(TablebaseChecks) / sizeof(TablebaseChecks[0]); i++)
+    {
+
+        const TablebaseFile* table = NULL;
+        Position position[1];
+        struct timespec start;
+        struct timespec end;
+        uint64_t errors = 0;
+        uint8_t longest = 0;
+
+        SetPositionFromFEN(position, TablebaseChecks[i].fen);
+
+        for(uint8_t k = 0; tablebase && k < tablebase->count && !table; k++)
+            if(tablebase->files[k].material == GetMaterialKey(position, false) && tablebase->files[k].distances) table = &tablebase->files[k];
+
+        if(!table)
+        {
+
+            fprintf(file, "%-6s missing from %s FAILED\n", TablebaseChecks[i].material, directory);
+            passed = false;
+            continue;
+
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        errors = CheckTablebaseFile(tablebase, table, &longest);
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        uint64_t time = (uint64_t)((end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000);
+        bool matched = !errors && longest == TablebaseChecks[i].longest;
+
+        fprintf(file, "%-6s %8u %8u %8llu %12llu%s\n", TablebaseChecks[i].material, longest, TablebaseChecks[i].longest, (unsigned long long)errors,
+            (unsigned long long)time, matched? "": " FAILED");
+
+        passed &= matched;
+
+    }
+
+    if(tablebase) DeleteTablebase(tablebase);
+
+    fprintf(file, "%s\n", passed? "Every table matched": "Some tables didn't match");
+
+    return passed;
+
+}
+
+// EOF //
@@ -34,6 +34,32 @@ static const Board DefaultBoard =
     }
 };
 
+/*!
+ * \brief Dense type of every piece ID
+ * \details Indexed by the ID character so GetPieceType is a single load, anything that isn't a piece is NoType
+ */
+const uint8_t IDTypes[128] = 
+{
+
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, BishopType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, KingType, NoType, NoType, KnightType, NoType,
+    PawnType, QueenType, RookType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType,
+    NoType, NoType, NoType, NoType, NoType, NoType, NoType, NoType
+
+};
+
 /*!
  * \brief Gets the default board
  * \param board: Takes in the game board
@@ -271,6 +297,20 @@ uint8_t GetPieceNumber(const Piece piece)
 
 }
 
+/*!
+ * \brief Gets the piece ID of a dense type
+ * \param type: Type to convert
+ * \returns uint8_t: The piece ID, EMPTY for NoType
+ */
+uint8_t GetTypeID(const PieceType type)
+{
+
+    static const uint8_t ids[7] = { PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING, EMPTY }; // In PieceType order
+
+    return ids[type];
+
+}
+
 /*!
  * \brief Gets the row of the selected location
  * \param index: The index of a location on the board
@@ -168,12 +168,21 @@ static Status PlayerVsAIGame(GameData* const data)
 {  
 
     Status status = InProgress; // Sets the game to start
-    AI ai[1]; // Initializes an AI
+    AI ai[1] = {GetDefaultAI()}; // Initializes an AI
     Player* currplayer = GetPlayer(data, WHITE); // Sets the current player to white
     Move move = CreateMove(0, 0, 0); // Creates an empty move
+    Ponder ponder[1]; // Searches while the player thinks
+    bool pondering = false;
 
     PromptPlayerSelection(); // Prompts the player to choose a side
     SetAIPlayer(ai, GetPlayerSelection()? GetPlayer(data, BLACK): GetPlayer(data, WHITE)); // Sets the AI to the opposite of the player 
+    SetDifficulty(ai, GetAIDifficulty(GetSettings(data))); // Picked in the settings menu or with --difficulty
+    SetAITable(ai, CreateTable(GetHashSize(GetSettings(data)))); // Kept for the whole game
+
+    if(GetDifficulty(ai) == Impossible) SetAINetwork(ai, CreateNetwork(GetNetworkFile(GetSettings(data)))); // Falls back to the hand written evaluation without a file
+
+    SetAIBook(ai, CreateBook(GetBookFile(GetSettings(data)))); // Searches every move without a book
+    SetAITablebase(ai, CreateTablebase(GetTablebaseDirectory(GetSettings(data))));
 
     do // The actual game
     {   
@@ -183,13 +192,24 @@ static Status PlayerVsAIGame(GameData* const data)
         PrintBoard(GetBoard(data), GetSettings(data)); // Prints the board
 
         if(currplayer != GetAIPlayer(ai))
-            move = GetPlayerMove(data, currplayer);        
+        {
+
+            pondering = StartPonder(ponder, data, ai); // The AI thinks on the player's time
+            move = GetPlayerMove(data, currplayer);
+            StopPonder(ponder);
+
+        }
         
         if(move.piece == QUIT)
-            return IsPlayerWhite(currplayer)? WhiteQuit: BlackQuit; // If the player types QQ it quits
+        {
+
+            status = IsPlayerWhite(currplayer)? WhiteQuit: BlackQuit; // If the player types QQ it quits
+            break;
+
+        }
         
         if(currplayer == ai->player)
-            move = GenerateBestMove(data, ai);
+            move = GeneratePonderedMove(data, ai, pondering? ponder: NULL);
 
         MakeMove(data, currplayer, move);
 
@@ -199,6 +219,11 @@ static Status PlayerVsAIGame(GameData* const data)
 
     } while (status == InProgress); // Repeats as long as the game is still going
 
+    DeleteTable(GetAITable(ai));
+    DeleteNetwork(GetAINetwork(ai));
+    DeleteBook(GetAIBook(ai));
+    DeleteTablebase(GetAITablebase(ai));
+
     return status;
 
 }
@@ -214,6 +239,18 @@ static Status AIVsAIGame(GameData* const data)
 
     SetAIPlayer(&ai[0], GetPlayer(data, WHITE)); // Sets one to white
     SetAIPlayer(&ai[1], GetPlayer(data, BLACK)); // Sets the other to black
+    SetDifficulty(&ai[0], GetAIDifficulty(GetSettings(data))); // Both play at the difficulty of the settings
+    SetDifficulty(&ai[1], GetAIDifficulty(GetSettings(data)));
+    SetAITable(&ai[0], CreateTable(GetHashSize(GetSettings(data)))); // Each AI keeps its own table for the game
+    SetAITable(&ai[1], CreateTable(GetHashSize(GetSettings(data))));
+
+    for(uint8_t i = 0; i < 2; i++) // Falls back to the hand written evaluation without a file
+        if(GetDifficulty(&ai[i]) == Impossible) SetAINetwork(&ai[i], CreateNetwork(GetNetworkFile(GetSettings(data))));
+
+    SetAIBook(&ai[0], CreateBook(GetBookFile(GetSettings(data)))); // Mapping the file twice shares the same pages
+    SetAIBook(&ai[1], CreateBook(GetBookFile(GetSettings(data))));
+    SetAITablebase(&ai[0], CreateTablebase(GetTablebaseDirectory(GetSettings(data))));
+    SetAITablebase(&ai[1], CreateTablebase(GetTablebaseDirectory(GetSettings(data))));
     
     Player* currplayer = GetPlayer(data, WHITE); // Sets the current player to white
     Move move = CreateMove(0, 0, 0); // Creates a blank move
@@ -238,6 +275,15 @@ static Status AIVsAIGame(GameData* const data)
 
     } while (status == InProgress); // Repeats as long as the game is still going
 
+    DeleteTable(GetAITable(&ai[0]));
+    DeleteTable(GetAITable(&ai[1]));
+    DeleteNetwork(GetAINetwork(&ai[0]));
+    DeleteNetwork(GetAINetwork(&ai[1]));
+    DeleteBook(GetAIBook(&ai[0]));
+    DeleteBook(GetAIBook(&ai[1]));
+    DeleteTablebase(GetAITablebase(&ai[0]));
+    DeleteTablebase(GetAITablebase(&ai[1]));
+
     return status;
 
 }
@@ -403,7 +449,7 @@ static void PrintStatusMessage(const Status status)
 Move GetPlayerMove(const GameData* const data, Player* const player)
 {
 
-    Move move;
+    Move move = CreateMove(EMPTY, 0, 0); // Blank move, the promotion is asked for when the pawn gets there
 
     for(;;)
     { 
@@ -413,7 +459,7 @@ Move GetPlayerMove(const GameData* const data, Player* const player)
         move.start = GetIndex(); // Sets from to where the piece is located
     
         if(move.start == QUIT) 
-            return (Move){QUIT, QUIT, QUIT}; // if the user puts in the QUIT code then quit the game
+            return (Move){QUIT, QUIT, QUIT, EMPTY}; // if the user puts in the QUIT code then quit the game
 
         move.piece = GetPiece(GetBoard(data), move.start); // Sets the piece to the piece at the selected location   
 
@@ -424,7 +470,7 @@ Move GetPlayerMove(const GameData* const data, Player* const player)
         move.end = GetIndex(); // Gets the ending index
 
         if(move.end == QUIT) 
-            return (Move){QUIT, QUIT, QUIT}; // if the user puts in the QUIT code then quit the game
+            return (Move){QUIT, QUIT, QUIT, EMPTY}; // if the user puts in the QUIT code then quit the game
 
         bool CanTakePiece = IsValidMove(data, player, move);
         bool PutInCheck = MovesIntoCheck(data, player, move);
@@ -442,7 +488,7 @@ Move GetPlayerMove(const GameData* const data, Player* const player)
 Move MakeOnlineMove(const GameData* const data, Player* const player, char *hostname, int PortNo, int DataFD)
 {
 
-    Move move;
+    Move move = CreateMove(EMPTY, 0, 0); // Blank move, the promotion is asked for when the pawn gets there
 
     for(;;)
     { 
@@ -458,7 +504,7 @@ Move MakeOnlineMove(const GameData* const data, Player* const player, char *host
 	    }*/
     
         if(move.start == QUIT) 
-            return (Move){QUIT, QUIT, QUIT}; // if the user puts in the QUIT code then quit the game
+            return (Move){QUIT, QUIT, QUIT, EMPTY}; // if the user puts in the QUIT code then quit the game
 
         move.piece = GetPiece(GetBoard(data), move.start); // Sets the piece to the piece at the selected location   
 
@@ -475,7 +521,7 @@ Move MakeOnlineMove(const GameData* const data, Player* const player, char *host
 	    }*/
 
         if(move.end == QUIT) 
-            return (Move){QUIT, QUIT, QUIT}; // if the user puts in the QUIT code then quit the game
+            return (Move){QUIT, QUIT, QUIT, EMPTY}; // if the user puts in the QUIT code then quit the game
 
         bool CanTakePiece = IsValidMove(data, player, move);
         bool PutInCheck = MovesIntoCheck(data, player, move);
@@ -19,7 +19,8 @@
 /// Prompts the user for the promotion
 static void PromptPromotion();
 
-static void PromotePawn(GameData* const data, Player* const player, const Index index);
+/// Replaces a pawn on the last row, asks the player when no piece is given
+static uint8_t PromotePawn(GameData* const data, Player* const player, const Index index, uint8_t option);
 
 // ------------------------- Definintions ------------------------- //
 
@@ -176,27 +177,29 @@ bool IsInStalemate(const GameData* const data, Player* const player)
  * \param player: The player
  * \returns bool: of whether there is a lack of mating material
  */
-bool IsLackOfMaterial( Player* const player)
+bool IsLackOfMaterial(Player* const player)
 {
 
-    uint8_t counter = 0;
+    STATIC_ASSERT(player, "Invalid Player Pointer");
 
-    for(uint8_t i = 0; i < 8; i++) // Goes through all the pawns
-        if(GetPieceLoc(player, PAWN, i) < 64) return false; // Checks how many pieces there are of pawns if any return false
+    if(GetMaterialCount(player, PAWN) || GetMaterialCount(player, QUEEN) || GetMaterialCount(player, ROOK)) 
+        return false; // Any pawn, queen or rook can still mate
 
-    for(uint8_t i = 0; i < GetNumPieces(player, BISHOP); i++) // Goes through all the bishops
-        if(GetPieceLoc(player, BISHOP, i) < 64) counter++; // Checks how many pieces there are of bishops if any up the counter
+    return GetMaterialCount(player, BISHOP) + GetMaterialCount(player, KNIGHT) < 2; // A single minor piece can't
 
-    for(uint8_t i = 0; i < GetNumPieces(player, QUEEN); i++) // Goes through all the queens
-        if(GetPieceLoc(player, QUEEN, i) < 64) return false; // Checks how many pieces there are of queens if any return false
+}
 
-    for(uint8_t i = 0; i < GetNumPieces(player, ROOK); i++) // Goes through all the rooks
-        if(GetPieceLoc(player, ROOK, i) < 64) return false; // Checks how many pieces there are of rooks if any return false
+/*!
+ * \brief Checks if the game has reached the endgame from the pieces left on the board
+ * \param data: Current gamedata
+ * \returns bool: If both players together have no more than a third of the starting phase weight
+ */
+bool IsEndgame(const GameData* const data)
+{
 
-    for(uint8_t i = 0; i < GetNumPieces(player, KNIGHT); i++) // Goes through all the knights
-        if(GetPieceLoc(player, KNIGHT, i) < 64) counter++; // Checks how many pieces there are of knights if any up the counter
+    STATIC_ASSERT(data, "Invalid Gamedata Pointer");
 
-    return(counter < 2);
+    return GetPhase(GetPlayer(data, WHITE)) + GetPhase(GetPlayer(data, BLACK)) <= PHASE_MAX / 3;
 
 }
 
@@ -306,12 +309,12 @@ Move MakeMove(GameData* const data, Player* const player, const Move move)
     {
 
         SetPiece(GetBoard(data), temp.end, EMPTY); // If in en passant capture the piece
-        SetPieceLoc(next, temp.piece, INDEX_MAX); // Set the piece to be index_max for the enemy
+        RemovePiece(next, temp.piece); // Take the piece away from the enemy
         AddCapturedPiece(player, temp.piece); // Add the captured piece to the list
         
     }
     
-    if(inpromotion) PromotePawn(data, player, move.end); // If the pawn made it to the end promote it
+    if(inpromotion) GetMoveStack(data)->head->move.promotion = PromotePawn(data, player, move.end, move.promotion); // If the pawn made it to the end promote it and remember the choice
 
     Index king = GetPieceLoc(next, KING, 0); // The opponents king
     
@@ -331,29 +334,34 @@ Move MakeMove(GameData* const data, Player* const player, const Move move)
  * \param data: Current gamedata
  * \param player: The player of the piece
  * \param index: Index to promote at
+ * \param option: Piece ID to promote to, EMPTY to ask the player
+ * \returns uint8_t: The piece ID that was chosen
  */
-void PromotePawn(GameData* const data, Player* const player, const Index index)
+uint8_t PromotePawn(GameData* const data, Player* const player, const Index index, uint8_t option)
 {
 
     STATIC_ASSERT(data, "Invalid Gamedata Pointer");
     STATIC_ASSERT(player, "Invalid Player Pointer");
 
-    uint8_t option = 0; // The selection for promoting the pawn
-    
-    do
+    while(option != 'Q' && option != 'R' && option != 'B' && option != 'N') // Only ask when the move didn't already say
     {
 
         PromptPromotion(); // The promotion message
         getchar(); // Gets rid of the new line 
         option = toupper(getchar()); // The user selection
+
+        if(option != 'Q' && option != 'R' && option != 'B' && option != 'N') 
+            puts("\nInvalid selection, try again\n"); // If its a bad input retry
     
-    } while (option != 'Q' && option != 'R' && option != 'B' && option != 'N' && puts("\nInvalid selection, try again\n")); // If its a bad input retry
+    }
 
     Piece newpiece = AddPiece(player, option, index); // the New piece
     Piece oldpiece = GetPiece(GetBoard(data), index); // The old pawn
 
     SetPiece(GetBoard(data), index, newpiece); // Sets the new piece
-    SetPieceLoc(player, oldpiece, INDEX_MAX); // Removes the old pawn
+    RemovePiece(player, oldpiece); // Removes the old pawn
+
+    return option;
 
 }
 
@@ -388,6 +396,7 @@ bool MovesIntoCheck(const GameData* const data, Player* const player, const Move
     Player* nextplayer = IsPlayerWhite(player)? GetPlayer(data, BLACK): GetPlayer(data, WHITE); // The next player
 
     Piece temp = GetPiece(GetBoard(data), move.end); // Make the move except don't put it on the stack
+    Player saved = *nextplayer; // Keep the opponent as it was so the capture can be put back exactly
     
     MoveList list[1];
 
@@ -403,7 +412,7 @@ bool MovesIntoCheck(const GameData* const data, Player* const player, const Move
     SetPiece(GetBoard(data), move.start, move.piece); // Puts the piece back into its old spot
     SetPieceLoc(player, move.piece, move.start); // Moves the piece back
 
-    SetPieceLoc(nextplayer, temp, move.end); // Sets the opponents piece back into its location
+    *nextplayer = saved; // Sets the opponents piece back into its location and restores its counts
 
     return numoftakes != 0;
 
@@ -41,6 +41,9 @@ static void BoardColorMenu(Settings* const settings);
 /// Menu for setting piece color
 static void PieceColorMenu(Settings* const settings);
 
+/// Menu for setting the AI difficulty
+static void DifficultyMenu(Settings* const settings);
+
 //Print the sign in menu
 void PrintSigninMenu();
 
@@ -269,7 +272,8 @@ void PrintSettingsMenu()
     puts("Ultimate Chess: Settings\n");
     puts("\t1. Board color");
     puts("\t2. Piece color");
-    puts("\t3. Back to main menu\n");
+    puts("\t3. AI difficulty");
+    puts("\t4. Back to main menu\n");
     printf("Please select an option: ");
 }
 
@@ -300,7 +304,10 @@ void SettingsMenu(Settings* const settings)
             case '2': 
                 PieceColorMenu(settings); // Goes to the piece color menu
                 break;
-            case '3': return;
+            case '3':
+                DifficultyMenu(settings); // Goes to the AI difficulty menu
+                break;
+            case '4': return;
             default: break;
 
         }
@@ -383,6 +390,38 @@ void PieceColorMenu(Settings* const settings)
     }
 }
 
+/*!
+ * \brief Prints the difficulties the AIs can play at and sets the new one
+ * \param settings: The game settings struct
+ */
+void DifficultyMenu(Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    static const char* const names[] = {"Novice", "Beginner", "Intermediate", "Hard", "Pro", "Impossible"};
+
+    while(1) // Loops indefinitely
+    {
+
+        ClearScreen(); // Clears screen
+
+        puts("Ultimate Chess: AI Difficulty Settings\n");
+
+        for(uint8_t i = 0; i < 6; i++)
+            printf("\t%u. %s%s\n", i + 1, names[i], (GetAIDifficulty(settings) == i)? " (current)": "");
+
+        puts("\t7. Exit difficulty menu\n");
+        printf("Please select an option: ");
+
+        uint8_t selection = getchar(); // Players selection
+
+        if(selection >= '1' && selection <= '6') SetAIDifficulty(settings, selection - '1'); // Every AI of the next game plays at it
+        else if(selection == '7') return;
+
+    }
+}
+
 /*!
  * \brief Takes in an int from the player and returns a color based off of the int
  * \returns Color: The selected color
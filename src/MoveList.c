@@ -186,37 +186,37 @@ uint8_t GenerateKnightMoves(const GameData* const data, MoveList* const list, Pl
 {
 
     Piece piece = IsPlayerWhite(player)? WKNIGHT: BKNIGHT; // Checks the color of the piece
-    pthread_t threads[8]; // A thread for every possible move
+    CheckMove checks[8]; // A check for every possible move
     Move moves[8]; // Eight possible moves
     bool possible[8]; // Bool to track if possible
 
     moves[0] = CreateMove(piece, index, index + 10); // Creates the move
-    CreateCheckMoveThread(&threads[0], data, player, moves[0]); // Checks the move
+    SubmitCheckMove(&checks[0], data, player, moves[0]); // Checks the move
 
     moves[1] = CreateMove(piece, index, index + 6); // Creates the move
-    CreateCheckMoveThread(&threads[1], data, player, moves[1]); // Checks the move
+    SubmitCheckMove(&checks[1], data, player, moves[1]); // Checks the move
 
     moves[2] = CreateMove(piece, index, index + 15); // Creates the move
-    CreateCheckMoveThread(&threads[2], data, player, moves[2]); // Checks the move
+    SubmitCheckMove(&checks[2], data, player, moves[2]); // Checks the move
 
     moves[3] = CreateMove(piece, index, index + 17); // Creates the move
-    CreateCheckMoveThread(&threads[3], data, player, moves[3]); // Checks the move
+    SubmitCheckMove(&checks[3], data, player, moves[3]); // Checks the move
 
     moves[4] = CreateMove(piece, index, index - 10); // Creates the move
-    CreateCheckMoveThread(&threads[4], data, player, moves[4]); // Checks the move
+    SubmitCheckMove(&checks[4], data, player, moves[4]); // Checks the move
 
     moves[5] = CreateMove(piece, index, index - 6); // Creates the move
-    CreateCheckMoveThread(&threads[5], data, player, moves[5]); // Checks the move
+    SubmitCheckMove(&checks[5], data, player, moves[5]); // Checks the move
 
     moves[6] = CreateMove(piece, index, index - 15); // Creates the move
-    CreateCheckMoveThread(&threads[6], data, player, moves[6]); // Checks the move
+    SubmitCheckMove(&checks[6], data, player, moves[6]); // Checks the move
 
     moves[7] = CreateMove(piece, index, index - 17); // Creates the move
-    CreateCheckMoveThread(&threads[7], data, player, moves[7]); // Checks the move
+    SubmitCheckMove(&checks[7], data, player, moves[7]); // Checks the move
 
    for(uint8_t i = 0; i < 8; i++) // Goes through all moves
     {
-        pthread_join(threads[i], (void*)&possible[i]); // Joins the threads back together and closes them
+        possible[i] = WaitCheckMove(&checks[i]); // Waits for the check to finish
         if(possible[i]) AppendMove(list, moves[i]); // If its a valid move append it
     }
 
@@ -237,25 +237,25 @@ uint8_t GeneratePawnMoves(const GameData* const data, MoveList* const list, Play
     int8_t direction = IsPlayerWhite(player)? 1: -1; // Direction the pawns move
     Piece piece = GetPiece(GetBoard(data), index);
 
-    pthread_t threads[4]; // a thread for every possible move
+    CheckMove checks[4]; // A check for every possible move
     Move moves[4]; // 4 possible moves
     bool possible[4]; // bool to track if possible
 
     moves[0] = CreateMove(piece, index, index + direction*8); // Creates the move
-    CreateCheckMoveThread(&threads[0], data, player, moves[0]); // Checks the move
+    SubmitCheckMove(&checks[0], data, player, moves[0]); // Checks the move
 
     moves[1] = CreateMove(piece, index, index + direction*16); // Creates the move
-    CreateCheckMoveThread(&threads[1], data, player, moves[1]); // Checks the move
+    SubmitCheckMove(&checks[1], data, player, moves[1]); // Checks the move
 
     moves[2] = CreateMove(piece, index, index + direction*8 + 1); // Creates the move
-    CreateCheckMoveThread(&threads[2], data, player, moves[2]); // Checks the move
+    SubmitCheckMove(&checks[2], data, player, moves[2]); // Checks the move
 
     moves[3] = CreateMove(piece, index, index + direction*8 - 1); // Creates the move
-    CreateCheckMoveThread(&threads[3], data, player, moves[3]); // Checks the move
+    SubmitCheckMove(&checks[3], data, player, moves[3]); // Checks the move
 
     for(uint8_t i = 0; i < 4; i++) // Goes through all moves
     {
-        pthread_join(threads[i], (void*)&possible[i]); // Joins the threads back together and closes them
+        possible[i] = WaitCheckMove(&checks[i]); // Waits for the check to finish
         if(possible[i]) AppendMove(list, moves[i]); // If its a valid move append it
     }
 
@@ -274,36 +274,36 @@ uint8_t GeneratePawnMoves(const GameData* const data, MoveList* const list, Play
 uint8_t GenerateKingMoves(const GameData* const data, MoveList* list, Player* const player, const Index index)
 {
     Piece piece = IsPlayerWhite(player)? WKING: BKING; // Checks the color of the piece
-    pthread_t threads[8]; // a thread for every possible move
+    CheckMove checks[8]; // A check for every possible move
     Move moves[8]; // 4 possible moves
     bool possible[8]; // bool to track if possible
 
     moves[0] = CreateMove(piece, index, index + 1);  // Creates the move
-    CreateCheckMoveThread(&threads[0], data, player, moves[0]); // Checks the move
+    SubmitCheckMove(&checks[0], data, player, moves[0]); // Checks the move
 
     moves[1] = CreateMove(piece, index, index + 9); // Creates the move
-    CreateCheckMoveThread(&threads[1], data, player, moves[1]); // Checks the move
+    SubmitCheckMove(&checks[1], data, player, moves[1]); // Checks the move
 
     moves[2] = CreateMove(piece, index, index + 8); // Creates the move
-    CreateCheckMoveThread(&threads[2], data, player, moves[2]); // Checks the move
+    SubmitCheckMove(&checks[2], data, player, moves[2]); // Checks the move
 
     moves[3] = CreateMove(piece, index, index + 7); // Creates the move
-    CreateCheckMoveThread(&threads[3], data, player, moves[3]); // Checks the move
+    SubmitCheckMove(&checks[3], data, player, moves[3]); // Checks the move
 
     moves[4] = CreateMove(piece, index, index - 1); // Creates the move
-    CreateCheckMoveThread(&threads[4], data, player, moves[4]); // Checks the move
+    SubmitCheckMove(&checks[4], data, player, moves[4]); // Checks the move
 
     moves[5] = CreateMove(piece, index, index - 7); // Creates the move
-    CreateCheckMoveThread(&threads[5], data, player, moves[5]); // Checks the move
+    SubmitCheckMove(&checks[5], data, player, moves[5]); // Checks the move
 
     moves[6] = CreateMove(piece, index, index - 8); // Creates the move
-    CreateCheckMoveThread(&threads[6], data, player, moves[6]); // Checks the move
+    SubmitCheckMove(&checks[6], data, player, moves[6]); // Checks the move
 
     moves[7] = CreateMove(piece, index, index - 9); // Creates the move
-    CreateCheckMoveThread(&threads[7], data, player, moves[7]); // Checks the move
+    SubmitCheckMove(&checks[7], data, player, moves[7]); // Checks the move
 
     for(uint8_t i = 0; i < 8; i++) // Goes through all moves
-        pthread_join(threads[i], (void*)&possible[i]); // Joins the threads back together and closes them
+        possible[i] = WaitCheckMove(&checks[i]); // Waits for the check to finish
 
     for(uint8_t i = 0; i < 8; i++) // Goes through all moves
         if(possible[i]) AppendMove(list, moves[i]); // If its a valid move append it
@@ -322,7 +322,7 @@ uint8_t GenerateKingMoves(const GameData* const data, MoveList* list, Player* co
 uint8_t GenerateRookMoves(const GameData* const data, MoveList* const list, Player* const player, const Index index)
 {
     Piece piece = GetPiece(GetBoard(data), index); // Checks the color of the piece
-    pthread_t threads[14]; // a thread for every possible move
+    CheckMove checks[14]; // A check for every possible move
     Move moves[14]; // 4 possible moves
     bool possible[14]; // bool to track if possible
 
@@ -333,15 +333,15 @@ uint8_t GenerateRookMoves(const GameData* const data, MoveList* const list, Play
     {
         
         moves[i - 1] = CreateMove(piece, index, CreateIndex(row, column + i)); // loop around the left and right
-        CreateCheckMoveThread(&threads[i - 1], data, player, moves[i - 1]); // Checks the move
+        SubmitCheckMove(&checks[i - 1], data, player, moves[i - 1]); // Checks the move
 
         moves[i + 6] = CreateMove(piece, index, CreateIndex(row + i, column)); // loop around top and bottom
-        CreateCheckMoveThread(&threads[i + 6], data, player, moves[i + 6]); // Checks the move
+        SubmitCheckMove(&checks[i + 6], data, player, moves[i + 6]); // Checks the move
 
     }
 
     for(uint8_t i = 0; i < 14; i++) // Goes through all moves
-        pthread_join(threads[i], (void*)&possible[i]); // Joins the threads back together and closes them
+        possible[i] = WaitCheckMove(&checks[i]); // Waits for the check to finish
 
     for(uint8_t i = 0; i < 14; i++) // Goes through all moves
         if(possible[i]) AppendMove(list, moves[i]); // If its a valid move append it
@@ -363,7 +363,7 @@ uint8_t GenerateBishopMoves(const GameData* const data, MoveList* const list, Pl
     
     Piece piece = GetPiece(GetBoard(data), index); // Checks the color of the piece
 
-    pthread_t threads[14]; // a thread for every possible move
+    CheckMove checks[14]; // A check for every possible move
     
     Move moves[14]; // 4 possible moves
     bool possible[14]; // bool to track if possible
@@ -375,16 +375,16 @@ uint8_t GenerateBishopMoves(const GameData* const data, MoveList* const list, Pl
     {
         
         moves[i - 1] = CreateMove(piece, index, CreateIndex(row + i, column + i)); // loop around the +slope direction
-        CreateCheckMoveThread(&threads[i - 1], data, player, moves[i - 1]); // Checks the move
+        SubmitCheckMove(&checks[i - 1], data, player, moves[i - 1]); // Checks the move
 
         moves[i + 6] = CreateMove(piece, index, CreateIndex(row - i, column + i)); // loop around the -slope direction
-        CreateCheckMoveThread(&threads[i + 6], data, player, moves[i + 6]); // Checks the move
+        SubmitCheckMove(&checks[i + 6], data, player, moves[i + 6]); // Checks the move
 
     }
 
     for(uint8_t i = 0; i < 14; i++) // Goes through all moves
     {
-        pthread_join(threads[i], (void*)&possible[i]); // Joins the threads back together and closes them
+        possible[i] = WaitCheckMove(&checks[i]); // Waits for the check to finish
         if(possible[i]) AppendMove(list, moves[i]); // If its a valid move append it
     }
 
@@ -441,7 +441,7 @@ uint8_t GenerateTakingMoves(const GameData* const data, MoveList* const list, Pl
 
     ClearMoveList(list); // Clears the move list
 
-    pthread_t threads[10]; // maximum number of pieces 
+    CheckMove checks[10]; // maximum number of pieces 
     Move moves[10]; // maximum of 10 pieces per type thus ten moves
     bool possible[10]; // same as before
 
@@ -453,17 +453,17 @@ uint8_t GenerateTakingMoves(const GameData* const data, MoveList* const list, Pl
     for(uint8_t i = 0; i < 7; i++) // Scans through all the pieces
     {   
         uint8_t numpieces = GetNumPieces(player, pieces[i]);
-        for(uint8_t j = 0; j < numpieces; j++)  // start all of the threads
+        for(uint8_t j = 0; j < numpieces; j++)  // start all of the checks
         {   
             piece = CreatePiece(IsPlayerWhite(player), pieces[i], j);
             location = GetPieceLoc(player, pieces[i], j);
             moves[j] = CreateMove(piece, location, index);
-            CreateCheckMoveThread(&threads[j], data, player, moves[j]);
+            SubmitCheckMove(&checks[j], data, player, moves[j]);
         }
         
         for(uint8_t k = 0; k < numpieces && k < 10; k++)
         {
-            pthread_join(threads[k], (void*)&possible[k]);
+            possible[k] = WaitCheckMove(&checks[k]);
             if(possible[k]) AppendMove(list, moves[k]);
         }
     }
@@ -0,0 +1,309 @@
+/*!
+ * \file MoveOrder.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the MoveOrder Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "MoveOrder.h"
+#include "AIGameplay.h"
+
+// ------------------------- Functions ------------------------- //
+
+/// Gets the MVV-LVA score of a capture or promotion
+static inline int32_t GetCaptureScore(const Position* const position, const Move move);
+
+/// Gets the value of a piece type in centipawns
+static inline int32_t GetTypeValue(const PieceType type);
+
+/// Moves a history score towards the bonus, the closer it is to the limit the less it moves
+static inline void AddHistory(int32_t* const entry, const int32_t bonus);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Scores a capture by the most valuable victim and then the least valuable attacker
+ * \details Queen promotions count as winning the difference between a queen and the pawn
+ * \param position: Position before the move
+ * \param move: Capture or promotion to score
+ * \returns int32_t: Score on top of ORDER_CAPTURE_SCORE
+ */
+static inline int32_t GetCaptureScore(const Position* const position, const Move move)
+{
+
+    Piece victim = position->grid[move.end];
+    int32_t value = victim? (int32_t)GetPieceValue(victim): 0;
+
+    if(!victim && !move.promotion) value = PAWNVAL; // En passant
+
+    if(move.promotion) value += (int32_t)GetPieceValue(CreatePiece(WHITE, move.promotion, 0)) - PAWNVAL;
+
+    return value * 100 - (int32_t)GetPieceValue(move.piece); // Victims are at least a pawn apart so they always come first
+
+}
+
+/*!
+ * \brief Gets the value of a piece type
+ * \param type: Type of the piece
+ * \returns int32_t: Same value as GetPieceValue gives the piece
+ */
+static inline int32_t GetTypeValue(const PieceType type)
+{
+
+    return (int32_t)GetPieceValue(CreatePiece(WHITE, GetTypeID(type), 0));
+
+}
+
+/*!
+ * \brief Adds a bonus to a history score keeping it within HISTORY_MAX
+ * \param entry: History score to change
+ * \param bonus: Amount to add, negative to punish the move
+ */
+static inline void AddHistory(int32_t* const entry, const int32_t bonus)
+{
+
+    *entry += bonus - *entry * abs(bonus) / HISTORY_MAX;
+
+}
+
+/*!
+ * \brief Forgets the killers, history and counter moves
+ * \param order: Move ordering state to clear
+ */
+void ClearMoveOrder(MoveOrder* const order)
+{
+
+    STATIC_ASSERT(order, "Invalid Move Order Pointer");
+
+    memset(order, 0, sizeof(MoveOrder)); // No real move has the same start and end so empty slots never match
+
+}
+
+/*!
+ * \brief Compares two moves ignoring the piece
+ * \param first: First move
+ * \param second: Second move
+ * \returns bool: True if the start, end and promotion are the same
+ */
+bool IsSameMove(const Move first, const Move second)
+{
+
+    return first.start == second.start && first.end == second.end && first.promotion == second.promotion;
+
+}
+
+/*!
+ * \brief Checks if a move is quiet, only quiet moves are killers or have a history
+ * \param position: Position before the move
+ * \param move: Move to check
+ * \returns bool: True if the move doesn't capture or promote
+ */
+bool IsQuietMove(const Position* const position, const Move move)
+{
+
+    return !move.promotion && !IsCaptureMove(position, move);
+
+}
+
+/*!
+ * \brief Scores every move in the list
+ * \details The stored move comes first, then captures and queen promotions by MVV-LVA, then the killers, the counter move,
+ * the rest of the quiet moves by history, the captures that lose material and finally the underpromotions
+ * \param order: What the search has learned so far
+ * \param position: Position the moves are for
+ * \param list: Moves to score
+ * \param hashmove: Move from the table, an empty move if none
+ * \param previous: Move that led to the position, an empty move at the root
+ * \param ply: Distance from the root
+ */
+void ScoreMoves(const MoveOrder* const order, const Position* const position, PositionMoveList* const list, const Move hashmove, const Move previous, const uint8_t ply)
+{
+
+    STATIC_ASSERT(order, "Invalid Move Order Pointer");
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(list, "Invalid List Pointer");
+
+    const Move* killers = order->killers[(ply < ORDER_MAX_PLY)? ply: ORDER_MAX_PLY - 1];
+    const int32_t (*history)[64] = order->history[position->isWhite];
+    Move counter = (previous.start < 64 && previous.end < 64)? order->counters[previous.start][previous.end]: CreateMove(EMPTY, INDEX_MAX, INDEX_MAX);
+
+    for(size_t i = 0; i < list->size; i++)
+    {
+
+        Move move = list->move[i];
+
+        if(IsSameMove(move, hashmove)) list->score[i] = ORDER_HASH_SCORE;
+
+        else if(move.promotion && move.promotion != QUEEN) list->score[i] = ORDER_UNDERPROMOTION_SCORE;
+
+        else if(!IsQuietMove(position, move)) // Captures that lose material go after the quiet moves
+        {
+
+            bool losing = !move.promotion && position->grid[move.end] && GetPieceValue(position->grid[move.end]) < GetPieceValue(move.piece)
+                && StaticExchangeEval(position, move) < 0; // Taking something worth as much never loses
+
+            list->score[i] = (losing? ORDER_LOSING_SCORE: ORDER_CAPTURE_SCORE) + GetCaptureScore(position, move);
+
+        }
+
+        else if(IsSameMove(move, killers[0])) list->score[i] = ORDER_KILLER_SCORE;
+
+        else if(IsSameMove(move, killers[1])) list->score[i] = ORDER_KILLER_SCORE - 1;
+
+        else if(IsSameMove(move, counter)) list->score[i] = ORDER_COUNTER_SCORE;
+
+        else list->score[i] = history[move.start][move.end];
+
+    }
+}
+
+/*!
+ * \brief Picks the next move to search, one step of a selection sort so lists cut off early are never fully sorted
+ * \param list: Scored moves, the moves before the index have already been picked
+ * \param index: Position in the list to fill
+ * \returns Move: The best scored move that hasn't been picked
+ */
+Move PickMove(PositionMoveList* const list, const size_t index)
+{
+
+    STATIC_ASSERT(list, "Invalid List Pointer");
+
+    size_t best = index;
+
+    for(size_t i = index + 1; i < list->size; i++)
+        if(list->score[i] > list->score[best]) best = i;
+
+    if(best != index) // Swap the move and its score into place
+    {
+
+        Move move = list->move[best];
+        int32_t score = list->score[best];
+
+        list->move[best] = list->move[index];
+        list->score[best] = list->score[index];
+
+        list->move[index] = move;
+        list->score[index] = score;
+
+    }
+
+    return list->move[index];
+
+}
+
+/*!
+ * \brief Plays out every capture on the square of a move, each side taking with its least valuable piece
+ * \details Pieces are taken off a copy of the occupancy as they capture so sliders behind them join in, either side can stop
+ * capturing when going on would lose more, a king only captures if the square isn't defended anymore
+ * \param position: Position before the move
+ * \param move: Capture to look at, any move works and quiet moves tell if the square is safe
+ * \returns int32_t: Material the side to move wins with the move in centipawns, negative if it loses material
+ */
+int32_t StaticExchangeEval(const Position* const position, const Move move)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    int32_t gain[32]; // Each side has at most 16 pieces to capture with
+    uint8_t depth = 0;
+    Index to = move.end;
+    Piece victim = position->grid[to];
+    Bitboard occupied = (position->occupancy[WHITE] | position->occupancy[BLACK]) ^ SquareBit(move.start);
+    int32_t attacker = (int32_t)GetPieceValue(move.piece); // Value of the piece standing on the square
+
+    gain[0] = victim? (int32_t)GetPieceValue(victim): 0;
+
+    if(!victim && to == position->enpassant && GetPieceType(move.piece) == PawnType) // The pawn taken en passant isn't on the square
+    {
+
+        gain[0] = PAWNVAL;
+        occupied ^= SquareBit(position->isWhite? to - 8: to + 8);
+
+    }
+
+    if(move.promotion)
+    {
+
+        attacker = GetTypeValue(GetPieceType(CreatePiece(WHITE, move.promotion, 0)));
+        gain[0] += attacker - PAWNVAL;
+
+    }
+
+    bool side = !position->isWhite;
+    Bitboard attackers = GetAttackersTo(position, to, occupied);
+
+    for(;;) // The side to capture takes with its least valuable attacker
+    {
+
+        Bitboard mine = attackers & position->occupancy[side];
+        PieceType type = PawnType;
+
+        if(!mine) break;
+
+        while(!(mine & position->pieces[side][type])) type++;
+
+        if(type == KingType && (attackers & position->occupancy[!side])) break; // The king can't capture into a defended square
+
+        Bitboard bits = mine & position->pieces[side][type];
+
+        depth++;
+        gain[depth] = attacker - gain[depth - 1]; // Takes the piece on the square and risks its own
+        attacker = GetTypeValue(type);
+
+        occupied ^= bits & (~bits + 1); // Lowest of them
+        attackers = GetAttackersTo(position, to, occupied); // Sliders behind it can now see the square
+        side = !side;
+
+    }
+
+    for(; depth; depth--) // Either side can stop capturing, so each only goes on if it gains
+        if(gain[depth] > -gain[depth - 1]) gain[depth - 1] = -gain[depth];
+
+    return gain[0];
+
+}
+
+/*!
+ * \brief Learns from a quiet move that caused a beta cutoff
+ * \details The move becomes the newest killer of the ply and the counter of the previous move,
+ * its history gets a bonus of the depth squared and every quiet move searched before it loses as much
+ * \param order: Move ordering state to update
+ * \param position: Position the move was played from
+ * \param best: Quiet move that caused the cutoff
+ * \param previous: Move that led to the position, an empty move at the root
+ * \param ply: Distance from the root
+ * \param depth: Plies that were left to search
+ * \param quiets: Quiet moves searched before the best move
+ * \param count: Number of quiet moves before the best move
+ */
+void UpdateMoveOrder(MoveOrder* const order, const Position* const position, const Move best, const Move previous, const uint8_t ply, const uint8_t depth, const Move* const quiets, const size_t count)
+{
+
+    STATIC_ASSERT(order, "Invalid Move Order Pointer");
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    int32_t (*history)[64] = order->history[position->isWhite];
+    int32_t bonus = (int32_t)depth * depth;
+
+    if(ply < ORDER_MAX_PLY && !IsSameMove(order->killers[ply][0], best))
+    {
+
+        order->killers[ply][1] = order->killers[ply][0];
+        order->killers[ply][0] = best;
+
+    }
+
+    if(previous.start < 64 && previous.end < 64) order->counters[previous.start][previous.end] = best;
+
+    AddHistory(&history[best.start][best.end], bonus);
+
+    for(size_t i = 0; i < count; i++)
+        AddHistory(&history[quiets[i].start][quiets[i].end], -bonus);
+
+}
+
+// EOF //
@@ -13,22 +13,6 @@
 #include "Gameplay.h"
 #include "MoveList.h"
 
-// ---------------------------- Custom Types -------------------- //
-
-/*!
- * \brief Stores the threaddata 
- * \details Store the game data player data and move data
- */
-typedef struct 
-{
-    
-    GameData* data;       ///< Gamedata for board and stack
-    Player* player;             ///< Player to check move For
-    Move move;                  ///< Move to check 
-
-} ThreadData;
-
-
 // ------------------------- Functions ------------------------- //
 
 /// Checks if the move is valid for a pawn
@@ -52,8 +36,8 @@ static bool IsValidKingMove(const GameData* const data, const Player* const play
 /// Checks if a player can castle in a given direction
 static bool IsAbleToCastle(const GameData* const data, const Player* const player, const int8_t direction);
 
-/// Thread Implementation Of Checking Valid Moves
-static void* CheckMoveThread(void* threaddata);
+/// Task that checks a move in its own copy of the game
+static void* CheckMoveTask(void* check);
 
 // ------------------------- Definintions ------------------------- //
 
@@ -364,66 +348,62 @@ bool IsAbleToCastle(const GameData* const data, const Player* const player, cons
 }
 
 /*!
- * \brief Creates the move thread
- * \param data: The game data
- * \param player: The player currently up
+ * \brief Starts a move check on the shared thread pool
+ * \param check: Check to fill, it has to stay alive until WaitCheckMove returns
+ * \param data: The game data, copied so the check doesn't touch it
+ * \param player: The player making the move
  * \param move: The intended move
- * \returns ThreadData: Data about the move for the thread
  */
-ThreadData CreateThreadData(const GameData* const data, Player* const player, const Move move)
+void SubmitCheckMove(CheckMove* const check, const GameData* const data, const Player* const player, const Move move)
 {
-    
-    ThreadData temp;
-    temp.player = player;
-    temp.data = (GameData*)data;
-    temp.move = move;
 
-    return temp;
+    STATIC_ASSERT(check, "Invalid Check Pointer");
+    STATIC_ASSERT(data, "Invalid Game Data Pointer");
+    STATIC_ASSERT(player, "Invalid Player Pointer");
+
+    check->data = *data; // The board and players are plain values, the stack is only read
+    check->player = GetPlayer(&check->data, IsPlayerWhite(player));
+    check->move = move;
+    check->valid = false;
+
+    SubmitTask(GetThreadPool(), &check->task, CheckMoveTask, check);
 
 }
 
 /*!
- * \brief Function pointer to feed a thread
- * \param CheckMoveFunc: Move Checking Function
- * \param data: Current Game Data
- * \param player: Current Player
- * \param move: Move to Check
+ * \brief Waits for a move check to finish
+ * \param check: Check started with SubmitCheckMove
+ * \returns bool: If the move is valid and doesn't move into check
  */
-void CreateCheckMoveThread(pthread_t* const thread, const GameData* const data, Player* const player, const Move move)
+bool WaitCheckMove(CheckMove* const check)
 {
 
-    STATIC_ASSERT(thread, "Invalid Thread Pointer");
+    STATIC_ASSERT(check, "Invalid Check Pointer");
 
-    static ThreadData td;
-    td = CreateThreadData(data, player, move); // Creates the thread data
-
-    if(pthread_create(thread, NULL, CheckMoveThread, &td)) // Checks for bad threads
-        perror("Faulty Creation of Thread");
+    WaitTask(GetThreadPool(), &check->task);
 
+    return check->valid;
 
 }
 
 /*!
- * \brief Checks the move thread
- * \param data: The game data
+ * \brief Checks a move in the copy of the game
+ * \param check: The CheckMove to run
+ * \returns void*: NULL, the answer is stored in the check
  */
-void* CheckMoveThread(void* threaddata)
+static void* CheckMoveTask(void* check)
 {
     
-    STATIC_ASSERT(threaddata, "Invalid Thread Data Pointer");
-
-    ThreadData* td = (ThreadData*)threaddata; // Takes the threaddata
+    STATIC_ASSERT(check, "Invalid Check Pointer");
 
-    STATIC_ASSERT(td->player, "Invalid Player Pointer");
-    STATIC_ASSERT(td->data, "Invalid Game Data Pointer");
+    CheckMove* self = (CheckMove*)check;
 
-    if(td->move.start > 64 || td->move.end > 64 || !td->move.piece) // Checks foe bad indexes
-        pthread_exit(NULL);
+    if(self->move.start > 63 || self->move.end > 63 || !self->move.piece) // Checks for bad indexes
+        return NULL;
 
-    if(IsValidMove(td->data, td->player, td->move) && !MovesIntoCheck(td->data, td->player, td->move)) // Checks if the move is valid
-        pthread_exit((void*)0xff);
+    self->valid = IsValidMove(&self->data, self->player, self->move) && !MovesIntoCheck(&self->data, self->player, self->move);
 
-    pthread_exit(NULL);
+    return NULL;
 
 }
 
@@ -45,6 +45,7 @@ Move CreateMove(const Piece piece, const Index from, const Index to)
     temp.piece = piece;
     temp.end = to;
     temp.start = from; 
+    temp.promotion = EMPTY;
 
     return temp; // The created of the move
 
@@ -166,7 +167,7 @@ Move PeekMove(const MoveStack* const stack)
 
     if(stack->size)
         return stack->head->move;
-    else return (Move){0, 0, 0};
+    else return (Move){0, 0, 0, EMPTY};
 
 }
 
@@ -0,0 +1,416 @@
+/*!
+ * \file Network.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the Network Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#define _POSIX_C_SOURCE 200809L // posix_memalign isn't part of plain C99
+
+#include "Network.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// ------------------------- Functions ------------------------- //
+
+/// Gets the input of a piece on a square seen from one side
+static inline uint32_t GetFeature(const bool side, Index king, const Piece piece, Index square);
+
+/// Adds the first layer weights of a feature to a half of the accumulator
+static inline void AddFeature(const Network* const network, int16_t* const values, const uint32_t feature);
+
+/// Subtracts the first layer weights of a feature from a half of the accumulator
+static inline void SubFeature(const Network* const network, int16_t* const values, const uint32_t feature);
+
+/// Builds one half of the accumulator from scratch
+static void RefreshSide(const Network* const network, const Position* const position, const bool side, int16_t* const values);
+
+/// Multiplies clipped neurons with a row of int8 weights
+static inline int32_t DotProduct(const uint8_t* const input, const int8_t* const weights, const size_t size);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Gets the feature index of a piece
+ * \details Black sees the board flipped so both sides use the same weights, the color of the piece is relative to the side
+ * \param side: Side the accumulator half belongs to
+ * \param king: Square of that side's king
+ * \param piece: Piece other than a king
+ * \param square: Square the piece is on
+ * \returns uint32_t: Index of the feature, below NETWORK_FEATURES
+ */
+static inline uint32_t GetFeature(const bool side, Index king, const Piece piece, Index square)
+{
+
+    if(!side) // Flip the rows for black
+    {
+
+        king ^= 56;
+        square ^= 56;
+
+    }
+
+    return ((uint32_t)king * 10 + GetPieceType(piece) * 2 + (IsPieceWhite(piece) != side)) * 64 + square;
+
+}
+
+/*!
+ * \brief Adds a row of first layer weights
+ * \param network: Network with the weights
+ * \param values: Half of an accumulator, NETWORK_HIDDEN values aligned to 32 bytes
+ * \param feature: Feature that became active
+ */
+static inline void AddFeature(const Network* const network, int16_t* const values, const uint32_t feature)
+{
+
+    const int16_t* row = &network->features[(size_t)feature * NETWORK_HIDDEN];
+
+    #if defined(__AVX2__)
+
+    for(size_t i = 0; i < NETWORK_HIDDEN; i += 16)
+        _mm256_store_si256((__m256i*)&values[i], _mm256_add_epi16(_mm256_load_si256((const __m256i*)&values[i]), _mm256_load_si256((const __m256i*)&row[i])));
+
+    #elif defined(__SSE2__)
+
+    for(size_t i = 0; i < NETWORK_HIDDEN; i += 8)
+        _mm_store_si128((__m128i*)&values[i], _mm_add_epi16(_mm_load_si128((const __m128i*)&values[i]), _mm_load_si128((const __m128i*)&row[i])));
+
+    #else
+
+    for(size_t i = 0; i < NETWORK_HIDDEN; i++)
+        values[i] += row[i];
+
+    #endif
+
+}
+
+/*!
+ * \brief Subtracts a row of first layer weights
+ * \param network: Network with the weights
+ * \param values: Half of an accumulator, NETWORK_HIDDEN values aligned to 32 bytes
+ * \param feature: Feature that stopped being active
+ */
+static inline void SubFeature(const Network* const network, int16_t* const values, const uint32_t feature)
+{
+
+    const int16_t* row = &network->features[(size_t)feature * NETWORK_HIDDEN];
+
+    #if defined(__AVX2__)
+
+    for(size_t i = 0; i < NETWORK_HIDDEN; i += 16)
+        _mm256_store_si256((__m256i*)&values[i], _mm256_sub_epi16(_mm256_load_si256((const __m256i*)&values[i]), _mm256_load_si256((const __m256i*)&row[i])));
+
+    #elif defined(__SSE2__)
+
+    for(size_t i = 0; i < NETWORK_HIDDEN; i += 8)
+        _mm_store_si128((__m128i*)&values[i], _mm_sub_epi16(_mm_load_si128((const __m128i*)&values[i]), _mm_load_si128((const __m128i*)&row[i])));
+
+    #else
+
+    for(size_t i = 0; i < NETWORK_HIDDEN; i++)
+        values[i] -= row[i];
+
+    #endif
+
+}
+
+/*!
+ * \brief Sums the biases and the weights of every piece but the kings seen from one side
+ * \param network: Network with the weights
+ * \param position: Position to build from
+ * \param side: Side the half belongs to
+ * \param values: Half of the accumulator to fill
+ */
+static void RefreshSide(const Network* const network, const Position* const position, const bool side, int16_t* const values)
+{
+
+    Index king = GetPositionKing(position, side);
+
+    memcpy(values, network->biases, sizeof(network->biases));
+
+    if(king > 63) return; // Only happens in positions made up for testing
+
+    for(uint8_t color = 0; color < 2; color++)
+        for(PieceType type = PawnType; type < KingType; type++)
+            for(Bitboard bits = position->pieces[color][type]; bits; bits &= bits - 1)
+            {
+
+                Index square = FirstSquare(bits);
+
+                AddFeature(network, values, GetFeature(side, king, position->grid[square], square));
+
+            }
+}
+
+/*!
+ * \brief Computes the dot product of clipped neurons and int8 weights
+ * \details The vector paths multiply unsigned bytes by signed bytes into pairs of int16, neurons are at most NETWORK_CLIP so the pairs can't saturate
+ * \param input: Neurons between 0 and NETWORK_CLIP, aligned to 32 bytes
+ * \param weights: Weights, aligned to 32 bytes
+ * \param size: Number of inputs, a multiple of 32
+ * \returns int32_t: The dot product
+ */
+static inline int32_t DotProduct(const uint8_t* const input, const int8_t* const weights, const size_t size)
+{
+
+    #if defined(__AVX2__)
+
+    __m256i total = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+
+    for(size_t i = 0; i < size; i += 32)
+    {
+
+        __m256i products = _mm256_maddubs_epi16(_mm256_load_si256((const __m256i*)&input[i]), _mm256_load_si256((const __m256i*)&weights[i]));
+
+        total = _mm256_add_epi32(total, _mm256_madd_epi16(products, ones)); // Widen the pairs to int32
+
+    }
+
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E)); // Add the halves, then the pairs
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+
+    return _mm_cvtsi128_si32(sum);
+
+    #elif defined(__SSSE3__)
+
+    __m128i total = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    for(size_t i = 0; i < size; i += 16)
+    {
+
+        __m128i products = _mm_maddubs_epi16(_mm_load_si128((const __m128i*)&input[i]), _mm_load_si128((const __m128i*)&weights[i]));
+
+        total = _mm_add_epi32(total, _mm_madd_epi16(products, ones));
+
+    }
+
+    total = _mm_add_epi32(total, _mm_shuffle_epi32(total, 0x4E));
+    total = _mm_add_epi32(total, _mm_shuffle_epi32(total, 0xB1));
+
+    return _mm_cvtsi128_si32(total);
+
+    #else
+
+    int32_t total = 0;
+
+    for(size_t i = 0; i < size; i++)
+        total += (int32_t)input[i] * weights[i];
+
+    return total;
+
+    #endif
+
+}
+
+/*!
+ * \brief Loads a network
+ * \details The file is NETWORK_MAGIC, then the version, NETWORK_HIDDEN and NETWORK_L2 as uint32, then the first layer weights
+ * feature by feature, the first layer biases, the second layer weights neuron by neuron, its biases, the output weights and the output bias
+ * Every value is little endian and the sizes have to match the ones this program was built with
+ * \param path: Path of the weights file, may be NULL or empty
+ * \returns Network*: The network, NULL if there is no file or it doesn't match
+ */
+Network* CreateNetwork(const char* const path)
+{
+
+    if(!path || !*path) return NULL;
+
+    FILE* file = fopen(path, "rb");
+
+    if(!file) return NULL;
+
+    Network* network = NULL;
+    char magic[4];
+    uint32_t header[3];
+
+    bool valid = fread(magic, 1, 4, file) == 4 && !memcmp(magic, NETWORK_MAGIC, 4) && fread(header, sizeof(uint32_t), 3, file) == 3
+        && header[0] == NETWORK_VERSION && header[1] == NETWORK_HIDDEN && header[2] == NETWORK_L2;
+
+    if(valid && !posix_memalign((void**)&network, 64, sizeof(Network))) // Aligned so the vector loads never fault
+    {
+
+        network->features = NULL;
+
+        valid = !posix_memalign((void**)&network->features, 64, (size_t)NETWORK_FEATURES * NETWORK_HIDDEN * sizeof(int16_t))
+            && fread(network->features, sizeof(int16_t), (size_t)NETWORK_FEATURES * NETWORK_HIDDEN, file) == (size_t)NETWORK_FEATURES * NETWORK_HIDDEN
+            && fread(network->biases, sizeof(int16_t), NETWORK_HIDDEN, file) == NETWORK_HIDDEN
+            && fread(network->hidden, sizeof(int8_t), NETWORK_L2 * 2 * NETWORK_HIDDEN, file) == NETWORK_L2 * 2 * NETWORK_HIDDEN
+            && fread(network->hiddenbiases, sizeof(int32_t), NETWORK_L2, file) == NETWORK_L2
+            && fread(network->output, sizeof(int8_t), NETWORK_L2, file) == NETWORK_L2
+            && fread(&network->outputbias, sizeof(int32_t), 1, file) == 1;
+
+    }
+
+    fclose(file);
+
+    if(!valid)
+    {
+
+        DeleteNetwork(network);
+        return NULL;
+
+    }
+
+    return network;
+
+}
+
+/*!
+ * \brief Deletes a network and its weights
+ * \param network: Network to delete, may be NULL
+ */
+void DeleteNetwork(Network* const network)
+{
+
+    if(!network) return;
+
+    free(network->features);
+    free(network);
+
+}
+
+/*!
+ * \brief Builds both halves of an accumulator from scratch
+ * \param network: Network with the weights
+ * \param position: Position to build from
+ * \param accumulator: Accumulator to fill
+ */
+void RefreshAccumulator(const Network* const network, const Position* const position, Accumulator* const accumulator)
+{
+
+    STATIC_ASSERT(network, "Invalid Network Pointer");
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(accumulator, "Invalid Accumulator Pointer");
+
+    RefreshSide(network, position, WHITE, accumulator->values[WHITE]);
+    RefreshSide(network, position, BLACK, accumulator->values[BLACK]);
+
+}
+
+/*!
+ * \brief Builds the accumulator after a move by changing only the pieces that moved
+ * \details A king move changes every feature of its own side so that half is rebuilt, the accumulator before the move is left alone so
+ * taking the move back is just going back to it
+ * \param network: Network with the weights
+ * \param position: Position after the move
+ * \param move: Move that was played
+ * \param undo: Undo information of the move
+ * \param before: Accumulator of the position before the move
+ * \param after: Accumulator to fill
+ */
+void UpdateAccumulator(const Network* const network, const Position* const position, const Move move, const PositionUndo* const undo,
+    const Accumulator* const before, Accumulator* const after)
+{
+
+    STATIC_ASSERT(network, "Invalid Network Pointer");
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    bool mover = !position->isWhite;
+    PieceType type = GetPieceType(move.piece);
+
+    Piece removed[3] = {move.piece}; // At most the piece, a capture and a castled rook
+    Index removedsquares[3] = {move.start};
+    uint8_t removedcount = 1;
+
+    Piece added[2] = {position->grid[move.end]}; // The promoted piece if it promoted
+    Index addedsquares[2] = {move.end};
+    uint8_t addedcount = 1;
+
+    if(undo->captured)
+    {
+
+        removed[removedcount] = undo->captured;
+        removedsquares[removedcount++] = (type == PawnType && move.end == undo->enpassant)? (mover? move.end - 8: move.end + 8): move.end;
+
+    }
+
+    if(type == KingType && abs(move.end - move.start) == 2) // The rook of a castle moves too
+    {
+
+        Index corner = (move.end > move.start)? move.start + 3: move.start - 4;
+        Index rookto = (move.end > move.start)? move.start + 1: move.start - 1;
+
+        removed[removedcount] = position->grid[rookto];
+        removedsquares[removedcount++] = corner;
+
+        added[addedcount] = position->grid[rookto];
+        addedsquares[addedcount++] = rookto;
+
+    }
+
+    for(uint8_t side = 0; side < 2; side++)
+    {
+
+        Index king = GetPositionKing(position, side);
+
+        if((type == KingType && side == mover) || king > 63) // Every feature of this side is relative to the king that moved
+        {
+
+            RefreshSide(network, position, side, after->values[side]);
+            continue;
+
+        }
+
+        memcpy(after->values[side], before->values[side], sizeof(after->values[side]));
+
+        for(uint8_t i = 0; i < removedcount; i++)
+            if(GetPieceType(removed[i]) != KingType) SubFeature(network, after->values[side], GetFeature(side, king, removed[i], removedsquares[i]));
+
+        for(uint8_t i = 0; i < addedcount; i++)
+            if(GetPieceType(added[i]) != KingType) AddFeature(network, after->values[side], GetFeature(side, king, added[i], addedsquares[i]));
+
+    }
+}
+
+/*!
+ * \brief Runs the layers after the accumulator
+ * \details Both halves are clipped to 0 to NETWORK_CLIP with the side to move first, the second layer is shifted back and clipped the same way
+ * \param network: Network with the weights
+ * \param accumulator: Accumulator of the position
+ * \param isWhite: Side to move
+ * \returns int32_t: Score for the side to move in centipawns
+ */
+int32_t EvaluateNetwork(const Network* const network, const Accumulator* const accumulator, const bool isWhite)
+{
+
+    STATIC_ASSERT(network, "Invalid Network Pointer");
+    STATIC_ASSERT(accumulator, "Invalid Accumulator Pointer");
+
+    uint8_t input[2 * NETWORK_HIDDEN] __attribute__((aligned(32)));
+    uint8_t hidden[NETWORK_L2] __attribute__((aligned(32)));
+    const int16_t* halves[2] = {accumulator->values[isWhite], accumulator->values[!isWhite]};
+
+    for(uint8_t half = 0; half < 2; half++)
+        for(size_t i = 0; i < NETWORK_HIDDEN; i++)
+        {
+
+            int16_t value = halves[half][i];
+
+            input[half * NETWORK_HIDDEN + i] = (value < 0)? 0: (value > NETWORK_CLIP)? NETWORK_CLIP: (uint8_t)value;
+
+        }
+
+    for(size_t i = 0; i < NETWORK_L2; i++)
+    {
+
+        int32_t sum = network->hiddenbiases[i] + DotProduct(input, network->hidden[i], 2 * NETWORK_HIDDEN);
+
+        hidden[i] = (sum <= 0)? 0: ((sum >> NETWORK_SHIFT) > NETWORK_CLIP)? NETWORK_CLIP: (uint8_t)(sum >> NETWORK_SHIFT);
+
+    }
+
+    return (network->outputbias + DotProduct(hidden, network->output, NETWORK_L2)) / NETWORK_SCALE;
+
+}
+
+// EOF //
@@ -0,0 +1,373 @@
+/*!
+ * \file Notation.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the Notation Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Notation.h"
+
+// ------------------------- Functions ------------------------- //
+
+/// Writes a square as a lowercase file and a rank eg 'e4'
+static inline char* WriteSquare(char* str, const Index index);
+
+/// Reads a lowercase square, returns INDEX_MAX if it isn't one
+static inline Index ReadSquare(const char* const str);
+
+/// Gets the legal moves, generating them only if the caller didn't
+static const PositionMoveList* GetLegal(Position* const position, const PositionMoveList* const legal, PositionMoveList* const buffer);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Writes a square in lowercase coordinates
+ * \param str: Where to write the two characters
+ * \param index: Square to write
+ * \returns char*: The character after the square
+ */
+static inline char* WriteSquare(char* str, const Index index)
+{
+
+    *str++ = 'a' + GetColumn(index); // Column is the file
+    *str++ = '1' + GetRow(index); // Row is the rank
+
+    return str;
+
+}
+
+/*!
+ * \brief Reads a square in lowercase coordinates
+ * \param str: The two characters to read
+ * \returns Index: The square, INDEX_MAX if it isn't one
+ */
+static inline Index ReadSquare(const char* const str)
+{
+
+    if(str[0] < 'a' || str[0] > 'h' || str[1] < '1' || str[1] > '8') return INDEX_MAX;
+
+    return CreateIndex(str[0] - 'a', str[1] - '1');
+
+}
+
+/*!
+ * \brief Gets the legal move list for the codecs
+ * \param position: Position the moves are for
+ * \param legal: List the caller already generated, may be NULL
+ * \param buffer: Where to generate the list if the caller didn't
+ * \returns const PositionMoveList*: The list to search
+ */
+static const PositionMoveList* GetLegal(Position* const position, const PositionMoveList* const legal, PositionMoveList* const buffer)
+{
+
+    if(legal) return legal; // Generated once by the caller and shared between every lookup
+
+    GenerateLegalMoves(position, buffer);
+
+    return buffer;
+
+}
+
+/*!
+ * \brief Writes a move in UCI notation eg 'e2e4' or 'e7e8q'
+ * \param move: Move to write
+ * \param str: String to write to
+ * \returns uint8_t: The length of the string
+ */
+uint8_t MoveToUCI(const Move move, char str[UCI_LENGTH])
+{
+
+    STATIC_ASSERT(str, "Invalid String");
+
+    char* end = WriteSquare(WriteSquare(str, move.start), move.end);
+
+    if(move.promotion) *end++ = tolower(move.promotion); // Promotions add the lowercase piece letter
+
+    *end = '\0';
+
+    return (uint8_t)(end - str);
+
+}
+
+/*!
+ * \brief Reads a move in UCI notation
+ * \param position: Position the move is played in
+ * \param legal: Legal moves of the position, NULL to generate them
+ * \param str: String to read
+ * \returns Move: The legal move, with an EMPTY piece if there is no such move
+ */
+Move UCIToMove(Position* const position, const PositionMoveList* const legal, const char* const str)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(str, "Invalid String");
+
+    PositionMoveList buffer[1];
+    Move move = CreateMove(EMPTY, INDEX_MAX, INDEX_MAX);
+
+    if(strlen(str) < 4) return move;
+
+    Index start = ReadSquare(str);
+    Index end = ReadSquare(str + 2);
+    uint8_t promotion = (str[4] && !isspace(str[4]))? toupper(str[4]): EMPTY;
+
+    if(start > 63 || end > 63) return move;
+
+    const PositionMoveList* list = GetLegal(position, legal, buffer);
+
+    for(size_t i = 0; i < list->size; i++) // Only the squares and promotion need to match
+        if(list->move[i].start == start && list->move[i].end == end && list->move[i].promotion == promotion)
+            return list->move[i];
+
+    return move;
+
+}
+
+/*!
+ * \brief Writes a move in standard algebraic notation eg 'Nbd2', 'exd6' or 'O-O+'
+ * \param position: Position before the move, left unchanged
+ * \param legal: Legal moves of the position, NULL to generate them
+ * \param move: Legal move to write
+ * \param str: String to write to
+ * \returns uint8_t: The length of the string
+ */
+uint8_t MoveToSAN(Position* const position, const PositionMoveList* const legal, const Move move, char str[SAN_LENGTH])
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(str, "Invalid String");
+
+    char* end = str;
+    PieceType type = GetPieceType(move.piece);
+
+    if(type == KingType && abs(move.end - move.start) == 2) // Castling has its own notation
+    {
+
+        strcpy(str, (move.end > move.start)? "O-O": "O-O-O");
+        end += strlen(str);
+
+    }
+
+    else
+    {
+
+        bool capture = IsCaptureMove(position, move);
+
+        if(type == PawnType)
+        {
+
+            if(capture) // Pawn captures name the file they came from
+            {
+
+                *end++ = 'a' + GetColumn(move.start);
+                *end++ = 'x';
+
+            }
+        }
+
+        else
+        {
+
+            PositionMoveList buffer[1];
+            const PositionMoveList* list = GetLegal(position, legal, buffer);
+
+            bool ambiguous = false;
+            bool samecolumn = false;
+            bool samerow = false;
+
+            *end++ = GetPieceID(move.piece); // The piece IDs are the SAN letters
+
+            for(size_t i = 0; i < list->size; i++) // Look for another piece of the same kind going to the same square
+            {
+
+                const Move other = list->move[i];
+
+                if(other.end != move.end || other.start == move.start || GetPieceType(other.piece) != type) continue;
+
+                ambiguous = true;
+                samecolumn |= GetColumn(other.start) == GetColumn(move.start);
+                samerow |= GetRow(other.start) == GetRow(move.start);
+
+            }
+
+            if(ambiguous) // Use the file if it is enough, then the rank, then both
+            {
+
+                if(!samecolumn) *end++ = 'a' + GetColumn(move.start);
+                else if(!samerow) *end++ = '1' + GetRow(move.start);
+                else end = WriteSquare(end, move.start);
+
+            }
+
+            if(capture) *end++ = 'x';
+
+        }
+
+        end = WriteSquare(end, move.end);
+
+        if(move.promotion) // Promotions name the new piece
+        {
+
+            *end++ = '=';
+            *end++ = move.promotion;
+
+        }
+    }
+
+    PositionUndo undo;
+
+    MakePositionMove(position, move, &undo);
+
+    if(IsPositionInCheck(position)) *end++ = HasLegalMoves(position)? '+': '#'; // Only look for replies when it is check
+
+    UnmakePositionMove(position, move, &undo);
+
+    *end = '\0';
+
+    return (uint8_t)(end - str);
+
+}
+
+/*!
+ * \brief Reads a move in standard algebraic notation
+ * \param position: Position the move is played in
+ * \param legal: Legal moves of the position, NULL to generate them
+ * \param str: String to read, check marks and annotations are ignored
+ * \returns Move: The legal move, with an EMPTY piece if there is no such move or more than one
+ */
+Move SANToMove(Position* const position, const PositionMoveList* const legal, const char* const str)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(str, "Invalid String");
+
+    Move move = CreateMove(EMPTY, INDEX_MAX, INDEX_MAX);
+    char san[16];
+    uint8_t length = 0;
+
+    for(const char* c = str; *c && !isspace(*c) && length < sizeof(san) - 1; c++) // Copy the move without the decorations
+        if(!strchr("+#!?", *c)) san[length++] = *c;
+
+    san[length] = '\0';
+
+    PositionMoveList buffer[1];
+    const PositionMoveList* list = GetLegal(position, legal, buffer);
+
+    Index start = INDEX_MAX;
+    Index end = INDEX_MAX;
+    PieceType type = PawnType;
+    int8_t column = -1;
+    int8_t row = -1;
+    uint8_t promotion = EMPTY;
+
+    if(!strcmp(san, "O-O") || !strcmp(san, "0-0") || !strcmp(san, "O-O-O") || !strcmp(san, "0-0-0")) // Castling is a king move of two squares
+    {
+
+        start = GetPositionKing(position, position->isWhite);
+        end = (length == 3)? start + 2: start - 2;
+        type = KingType;
+
+    }
+
+    else
+    {
+
+        char* c = san;
+
+        if(*c && strchr("KQRBN", *c)) type = GetPieceType(CreatePiece(WHITE, *c++, 0)); // Pieces start with their letter, pawns don't
+
+        if(length > 2 && strchr("QRBN", san[length - 1])) // Promotions with or without the equals sign
+        {
+
+            promotion = san[--length];
+            san[length] = '\0';
+
+            if(san[length - 1] == '=') san[--length] = '\0';
+
+        }
+
+        if(length < 2 || (end = ReadSquare(&san[length - 2])) > 63) return move; // The target is always the last square
+
+        san[length - 2] = '\0';
+
+        for(; *c; c++) // Whatever is left is the disambiguation and capture mark
+        {
+
+            if(*c >= 'a' && *c <= 'h') column = *c - 'a';
+            else if(*c >= '1' && *c <= '8') row = *c - '1';
+            else if(*c != 'x' && *c != ':') return move;
+
+        }
+    }
+
+    uint8_t matches = 0;
+
+    for(size_t i = 0; i < list->size; i++) // Find the one legal move that fits
+    {
+
+        const Move other = list->move[i];
+
+        if(other.end != end || GetPieceType(other.piece) != type || other.promotion != promotion) continue;
+        if(start < 64 && other.start != start) continue;
+        if(column >= 0 && GetColumn(other.start) != column) continue;
+        if(row >= 0 && GetRow(other.start) != row) continue;
+
+        move = other;
+        matches++;
+
+    }
+
+    if(matches > 1) move = CreateMove(EMPTY, INDEX_MAX, INDEX_MAX); // Ambiguous moves aren't accepted
+
+    return move;
+
+}
+
+/*!
+ * \brief Prints the moves of the movestack in standard algebraic notation with move numbers
+ * \param file: File to print to
+ * \param stack: Stack to print, replayed from the starting position
+ */
+void fprintsanmovestack(FILE* const file, const MoveStack* const stack)
+{
+
+    STATIC_ASSERT(file, "Invalid File Pointer");
+    STATIC_ASSERT(stack, "Invalid Stack Handle");
+
+    Position position[1];
+    PositionMoveList legal[1];
+    PositionUndo undo;
+    char san[SAN_LENGTH];
+
+    ResetPosition(position);
+
+    MoveNode* node = stack->tail; // Oldest move first
+
+    for(size_t ply = 0; node && ply < stack->size; ply++, node = node->prev)
+    {
+
+        GenerateLegalMoves(position, legal);
+        MoveToUCI(node->move, san);
+
+        Move move = UCIToMove(position, legal, san); // Match on the squares, the piece numbers can differ
+
+        if(!move.piece) break; // Stop if the stack doesn't follow the rules
+
+        if(!(ply & 1)) fprintf(file, "%zu. ", ply / 2 + 1);
+
+        MoveToSAN(position, legal, move, san);
+        fprintf(file, "%s ", san);
+
+        MakePositionMove(position, move, &undo);
+
+    }
+
+    fputc('\n', file);
+
+}
+
+// EOF //
@@ -0,0 +1,272 @@
+/*!
+ * \file PawnTable.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the PawnTable Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "PawnTable.h"
+
+// ------------------------- Scores ------------------------- //
+
+/// Midgame and endgame penalty for each extra pawn on a column
+static const int16_t DoubledPenalty[2] = {-10, -20};
+
+/// Midgame and endgame penalty for a pawn without friendly pawns on the columns next to it
+static const int16_t IsolatedPenalty[2] = {-10, -15};
+
+/// Midgame and endgame penalty for a pawn that can't be supported and can't safely move up
+static const int16_t BackwardPenalty[2] = {-8, -10};
+
+/// Midgame bonus of a passed pawn by its row counted from its own side
+static const int16_t PassedMidgame[8] = {0, 5, 5, 10, 20, 35, 60, 0};
+
+/// Endgame bonus of a passed pawn by its row counted from its own side
+static const int16_t PassedEndgame[8] = {0, 10, 15, 25, 45, 75, 120, 0};
+
+/// Extra endgame bonus of a passed pawn that isn't blocked by its row
+static const int16_t FreePassedEndgame[8] = {0, 0, 5, 10, 15, 25, 40, 0};
+
+/// Midgame bonus for each pawn shielding the king
+static const int16_t ShelterBonus = 10;
+
+// ------------------------- Tables ------------------------- //
+
+/// Squares of each column
+static Bitboard ColumnMasks[8];
+
+/// Squares of the columns next to each column
+static Bitboard AdjacentMasks[8];
+
+/// Squares an enemy pawn has to be on to stop a pawn of each color on each square
+static Bitboard PassedMasks[2][64];
+
+/// Squares on the columns next to a pawn of each color that are level with it or behind it
+static Bitboard SupportMasks[2][64];
+
+/// Squares in front of a king of each color on each square where its pawns shelter it
+static Bitboard ShelterMasks[2][64];
+
+/// Makes sure the masks are only built once
+static pthread_once_t MasksOnce = PTHREAD_ONCE_INIT;
+
+// ------------------------- Globals ------------------------- //
+
+/// Pawn table of each thread
+static __thread PawnTable ThreadPawnTable;
+
+// ------------------------- Functions ------------------------- //
+
+/// Fills the masks
+static void InitPawnMasks();
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Fills the column, passed, support and shelter masks
+ */
+static void InitPawnMasks()
+{
+
+    for(uint8_t col = 0; col < 8; col++)
+        ColumnMasks[col] = 0x0101010101010101ull << col;
+
+    for(uint8_t col = 0; col < 8; col++)
+        AdjacentMasks[col] = (col? ColumnMasks[col - 1]: 0) | ((col < 7)? ColumnMasks[col + 1]: 0);
+
+    for(Index index = 0; index < 64; index++)
+    {
+
+        uint8_t col = GetColumn(index);
+        uint8_t row = GetRow(index);
+        Bitboard span = ColumnMasks[col] | AdjacentMasks[col];
+
+        for(Index other = 0; other < 64; other++) // Sort every square by whether it is in front of or behind the row
+        {
+
+            if(!(span & SquareBit(other))) continue;
+
+            uint8_t otherrow = GetRow(other);
+
+            if(otherrow > row) PassedMasks[WHITE][index] |= SquareBit(other);
+            if(otherrow < row) PassedMasks[BLACK][index] |= SquareBit(other);
+
+            if(!(AdjacentMasks[col] & SquareBit(other))) continue;
+
+            if(otherrow <= row) SupportMasks[WHITE][index] |= SquareBit(other);
+            if(otherrow >= row) SupportMasks[BLACK][index] |= SquareBit(other);
+
+            if(otherrow == row + 1 || otherrow == row + 2) ShelterMasks[WHITE][index] |= SquareBit(other);
+            if(otherrow + 1 == row || otherrow + 2 == row) ShelterMasks[BLACK][index] |= SquareBit(other);
+
+        }
+
+        for(uint8_t ahead = 1; ahead <= 2; ahead++) // The king's own column shelters it too
+        {
+
+            if(row + ahead < 8) ShelterMasks[WHITE][index] |= SquareBit(index + 8 * ahead);
+            if(row >= ahead) ShelterMasks[BLACK][index] |= SquareBit(index - 8 * ahead);
+
+        }
+    }
+}
+
+/*!
+ * \brief Scores the doubled, isolated, backward and passed pawns of both colors
+ * \param position: Position to look at, only its pawns are used
+ * \param entry: Entry to fill, keyed with the pawn key of the position
+ */
+void AnalyzePawns(const Position* const position, PawnEntry* const entry)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(entry, "Invalid Pawn Entry Pointer");
+
+    pthread_once(&MasksOnce, InitPawnMasks);
+
+    int32_t midgame = 0;
+    int32_t endgame = 0;
+
+    entry->key = position->pawnkey;
+    entry->passed[WHITE] = entry->passed[BLACK] = 0;
+
+    for(uint8_t color = 0; color < 2; color++)
+    {
+
+        int32_t sign = color? 1: -1;
+        Bitboard own = position->pieces[color][PawnType];
+        Bitboard enemy = position->pieces[!color][PawnType];
+
+        for(uint8_t col = 0; col < 8; col++) // Doubled
+        {
+
+            uint8_t count = CountSquares(own & ColumnMasks[col]);
+
+            if(count < 2) continue;
+
+            midgame += sign * DoubledPenalty[0] * (count - 1);
+            endgame += sign * DoubledPenalty[1] * (count - 1);
+
+        }
+
+        for(Bitboard pawns = own; pawns; pawns &= pawns - 1)
+        {
+
+            Index index = FirstSquare(pawns);
+            uint8_t col = GetColumn(index);
+            uint8_t rank = color? GetRow(index): 7 - GetRow(index); // Rows the pawn has come up
+            Index stop = color? index + 8: index - 8;
+
+            if(!(own & AdjacentMasks[col])) // Isolated
+            {
+
+                midgame += sign * IsolatedPenalty[0];
+                endgame += sign * IsolatedPenalty[1];
+
+            }
+
+            else if(!(own & SupportMasks[color][index]) && (GetPawnAttacks(color, stop) & enemy)) // Backward
+            {
+
+                midgame += sign * BackwardPenalty[0];
+                endgame += sign * BackwardPenalty[1];
+
+            }
+
+            if(!(enemy & PassedMasks[color][index]) && !(own & PassedMasks[color][index] & ColumnMasks[col])) // Passed, only the front pawn of a column
+            {
+
+                entry->passed[color] |= SquareBit(index);
+
+                midgame += sign * PassedMidgame[rank];
+                endgame += sign * PassedEndgame[rank];
+
+            }
+        }
+    }
+
+    entry->midgame = (int16_t)midgame;
+    entry->endgame = (int16_t)endgame;
+
+}
+
+/*!
+ * \brief Looks up the pawn skeleton in the table of the calling thread
+ * \param position: Position to look up
+ * \returns const PawnEntry*: The skeleton, valid until the thread probes again
+ */
+const PawnEntry* ProbePawnTable(const Position* const position)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    PawnTable* table = &ThreadPawnTable;
+    PawnEntry* entry = &table->entries[position->pawnkey & (PAWN_TABLE_SIZE - 1)];
+
+    table->probes++;
+
+    if(entry->key == position->pawnkey) table->hits++; // An empty entry has key zero which is also the key without pawns, and that analysis is all zero
+
+    else AnalyzePawns(position, entry);
+
+    return entry;
+
+}
+
+/*!
+ * \brief Adds the pawn terms to the running scores of the position
+ * \details The skeleton comes from the table, only the terms that depend on other pieces are worked out every time
+ * \param position: Position to evaluate
+ * \param midgame: Midgame score for white to add to
+ * \param endgame: Endgame score for white to add to
+ */
+void AddPawnScores(const Position* const position, int32_t* const midgame, int32_t* const endgame)
+{
+
+    STATIC_ASSERT(midgame, "Invalid Score Pointer");
+    STATIC_ASSERT(endgame, "Invalid Score Pointer");
+
+    pthread_once(&MasksOnce, InitPawnMasks); // The shelter masks are needed even if the analysis is skipped
+
+    const PawnEntry* entry = ProbePawnTable(position);
+    Bitboard occupied = position->occupancy[WHITE] | position->occupancy[BLACK];
+
+    *midgame += entry->midgame;
+    *endgame += entry->endgame;
+
+    for(uint8_t color = 0; color < 2; color++)
+    {
+
+        int32_t sign = color? 1: -1;
+        Index king = GetPositionKing(position, color);
+
+        if(king < 64) *midgame += sign * ShelterBonus * CountSquares(position->pieces[color][PawnType] & ShelterMasks[color][king]);
+
+        for(Bitboard passed = entry->passed[color]; passed; passed &= passed - 1) // Passed pawns that can move up
+        {
+
+            Index index = FirstSquare(passed);
+            Index stop = color? index + 8: index - 8;
+
+            if(!(occupied & SquareBit(stop))) *endgame += sign * FreePassedEndgame[color? GetRow(index): 7 - GetRow(index)];
+
+        }
+    }
+}
+
+/*!
+ * \brief Gets the table of the calling thread, mostly to look at its counters
+ * \returns PawnTable*: Table of the calling thread
+ */
+PawnTable* GetPawnTable()
+{
+
+    return &ThreadPawnTable;
+
+}
+
+// EOF //
@@ -0,0 +1,187 @@
+/*!
+ * \file PieceSquare.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the PieceSquare Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "PieceSquare.h"
+#include "AIGameplay.h"
+
+// ------------------------- Tables ------------------------- //
+
+#ifdef TUNED_WEIGHTS
+
+#include "TunedWeights.h" // Written by --tune, the same four tables with tuned numbers
+
+#else
+
+/// Midgame value of each piece type in centipawns
+static const int16_t MidgameValues[6] = {PAWNVAL, KNIGHTVAL, BISHOPVAL, ROOKVAL, QUEENVAL, KINGVAL};
+
+/// Endgame value of each piece type in centipawns
+static const int16_t EndgameValues[6] = {PAWNVAL, KNIGHTVAL, BISHOPVAL, ROOKVAL, QUEENVAL, KINGVAL};
+
+/// Midgame bonus of each piece type on each square in centipawns, drawn from white's side with the eighth row on top
+static const int16_t MidgameTables[6][64] =
+{
+
+    { // Pawns, push the center pawns and keep the ones in front of the castled king
+          0,   0,   0,   0,   0,   0,   0,   0,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         10,  10,  20,  30,  30,  20,  10,  10,
+          5,   5,  10,  25,  25,  10,   5,   5,
+          0,   0,   0,  20,  20,   0,   0,   0,
+          5,  -5, -10,   0,   0, -10,  -5,   5,
+          5,  10,  10, -20, -20,  10,  10,   5,
+          0,   0,   0,   0,   0,   0,   0,   0
+    },
+    { // Knights, away from the edges
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   0,  15,  20,  20,  15,   0, -30,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50
+    },
+    { // Bishops, on long diagonals and out of the corners
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   5,   5,  10,  10,   5,   5, -10,
+        -10,   0,  10,  10,  10,  10,   0, -10,
+        -10,  10,  10,  10,  10,  10,  10, -10,
+        -10,   5,   0,   0,   0,   0,   5, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20
+    },
+    { // Rooks, on the seventh row and central columns
+          0,   0,   0,   0,   0,   0,   0,   0,
+          5,  10,  10,  10,  10,  10,  10,   5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+          0,   0,   0,   5,   5,   0,   0,   0
+    },
+    { // Queens, slightly central
+        -20, -10, -10,  -5,  -5, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+         -5,   0,   5,   5,   5,   5,   0,  -5,
+          0,   0,   5,   5,   5,   5,   0,  -5,
+        -10,   5,   5,   5,   5,   5,   0, -10,
+        -10,   0,   5,   0,   0,   0,   0, -10,
+        -20, -10, -10,  -5,  -5, -10, -10, -20
+    },
+    { // King, castled behind its pawns
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+         20,  20,   0,   0,   0,   0,  20,  20,
+         20,  30,  10,   0,   0,  10,  30,  20
+    }
+
+};
+
+/// Endgame bonus of each piece type on each square in centipawns, laid out like the midgame tables
+static const int16_t EndgameTables[6][64] =
+{
+
+    { // Pawns, the closer to promoting the better
+          0,   0,   0,   0,   0,   0,   0,   0,
+         90,  90,  90,  90,  90,  90,  90,  90,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         30,  30,  30,  30,  30,  30,  30,  30,
+         15,  15,  15,  15,  15,  15,  15,  15,
+          5,   5,   5,   5,   5,   5,   5,   5,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0
+    },
+    { // Knights, central on either side of the board
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50
+    },
+    { // Bishops, central
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20
+    },
+    { // Rooks, cutting off the king from behind
+         10,  10,  10,  10,  10,  10,  10,  10,
+         15,  15,  15,  15,  15,  15,  15,  15,
+          5,   5,   5,   5,   5,   5,   5,   5,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0
+    },
+    { // Queens, central
+        -20, -10, -10,  -5,  -5, -10, -10, -20,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+        -10,   5,  10,  10,  10,  10,   5, -10,
+         -5,   5,  10,  15,  15,  10,   5,  -5,
+         -5,   5,  10,  15,  15,  10,   5,  -5,
+        -10,   5,  10,  10,  10,  10,   5, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+        -20, -10, -10,  -5,  -5, -10, -10, -20
+    },
+    { // King, out in the center helping the pawns
+        -50, -40, -30, -20, -20, -30, -40, -50,
+        -30, -20, -10,   0,   0, -10, -20, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -30,   0,   0,   0,   0, -30, -30,
+        -50, -30, -30, -30, -30, -30, -30, -50
+    }
+
+};
+
+#endif
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Gets the value of a piece on a square
+ * \details The tables are drawn from white's side so white flips the row to look up its square and black uses it as is
+ * \param piece: Piece to value
+ * \param index: Square the piece is on
+ * \param endgame: True for the endgame value, false for the midgame value
+ * \returns int32_t: Value for the owner of the piece in centipawns, the value of its type plus the bonus of the square
+ */
+int32_t GetPieceSquareValue(const Piece piece, const Index index, const bool endgame)
+{
+
+    PieceType type = GetPieceType(piece);
+    Index square = IsPieceWhite(piece)? index ^ 56: index;
+
+    if(type == NoType || index > 63) return 0;
+
+    return endgame? EndgameValues[type] + EndgameTables[type][square]: MidgameValues[type] + MidgameTables[type][square];
+
+}
+
+// EOF //
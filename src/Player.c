@@ -22,6 +22,17 @@ static void IncNumPieces(Player* const player, const uint8_t pieceid);
 /// Decrements the number of pieces
 static void DecNumPieces(Player* const player, const uint8_t pieceid);
 
+/// Adds or removes a piece from the material counts
+static void ChangeMaterial(Player* const player, const PieceType type, const int8_t amount);
+
+// ------------------------- Tables ------------------------- //
+
+/// Phase weight of each piece type, minor pieces count one, rooks two and queens four, the starting position adds up to PHASE_MAX
+static const uint8_t PhaseWeights[6] = { 0, 1, 1, 2, 4, 0 };
+
+/// Number of pieces of each type at the start of the game
+static const uint8_t StartingMaterial[6] = { 8, 2, 2, 2, 1, 1 };
+
 // ------------------------- Definintions ------------------------- //
 
 /*!
@@ -51,6 +62,17 @@ static void DecNumPieces(Player* const player, const uint8_t pieceid);
     player->numqueens  = 1;
     player->numrooks = 2;
 
+    player->signature = 0;
+    player->phase = 0;
+
+    for(PieceType type = PawnType; type <= KingType; type++) // Count the starting pieces
+    {
+
+        player->material[type] = 0;
+        ChangeMaterial(player, type, StartingMaterial[type]);
+
+    }
+
 }
 
 /*!
@@ -207,6 +229,24 @@ void DecNumPieces(Player* const player, const uint8_t pieceid)
     }
 }
 
+/*!
+ * \brief Keeps the material counts, signature and phase in step
+ * \param player: The player to change
+ * \param type: The type of piece added or removed
+ * \param amount: How many were added, negative if removed
+ */
+static void ChangeMaterial(Player* const player, const PieceType type, const int8_t amount)
+{
+
+    if(type == NoType) return;
+
+    player->material[type] += amount;
+    player->phase += PhaseWeights[type] * amount;
+
+    if(type != KingType) player->signature += (uint32_t)(amount * (1 << (SIGNATURE_BITS * type))); // Kings are always there so they aren't part of it
+
+}
+
 /*!
  * \brief Removes a piece from the board and decrements it
  * \param player: the player to remove the piece from
@@ -215,6 +255,10 @@ void DecNumPieces(Player* const player, const uint8_t pieceid)
 void RemovePiece(Player* const player, const Piece piece)
 {
 
+    if(piece == EMPTY) return; // Nothing to remove
+
+    ChangeMaterial(player, GetPieceType(piece), -1); // One less of the piece on the board
+
     uint8_t piecenum = GetPieceNumber(piece); // Get the piece number of the one to be removed
     
     SetPieceLoc(player, piece, 0xff); // Sets the piece location to off the board
@@ -266,11 +310,69 @@ Piece AddPiece(Player* const player, const uint8_t pieceid, const Index index)
     }
     
     IncNumPieces(player, pieceid); // Increments the number of pieces
+    ChangeMaterial(player, GetPieceType(piece), 1); // One more of the piece on the board
 
     return piece;
 
 }
 
+/*!
+ * \brief Gets how many pieces of a type the player has on the board
+ * \param player: The player to check
+ * \param pieceid: The piece ID for the type of piece
+ * \returns uint8_t: The number of pieces still on the board
+ */
+uint8_t GetMaterialCount(const Player* const player, const uint8_t pieceid)
+{
+
+    STATIC_ASSERT(player, "Invalid Player Pointer");
+
+    PieceType type = GetPieceType(CreatePiece(WHITE, pieceid, 0));
+
+    return (type == NoType)? 0: player->material[type];
+
+}
+
+/*!
+ * \brief Gets the material signature, the count of each piece type packed into one number
+ * \param player: The player to check
+ * \returns uint32_t: The signature, equal signatures mean equal material
+ */
+uint32_t GetMaterialSignature(const Player* const player)
+{
+
+    STATIC_ASSERT(player, "Invalid Player Pointer");
+
+    return player->signature;
+
+}
+
+/*!
+ * \brief Gets the phase weight of the players pieces
+ * \param player: The player to check
+ * \returns uint8_t: Phase weight, 12 with every piece and 0 with only pawns and the king
+ */
+uint8_t GetPhase(const Player* const player)
+{
+
+    STATIC_ASSERT(player, "Invalid Player Pointer");
+
+    return player->phase;
+
+}
+
+/*!
+ * \brief Gets the phase weight of a piece type
+ * \param type: Type of the piece
+ * \returns uint8_t: Amount the type adds to the phase, pawns and kings add nothing
+ */
+uint8_t GetPhaseWeight(const PieceType type)
+{
+
+    return (type < NoType)? PhaseWeights[type]: 0;
+
+}
+
 /*!
  * \brief Sets the index of the piece that is checking the player
  * \param player: Player to set index of
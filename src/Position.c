@@ -0,0 +1,1143 @@
+/*!
+ * \file Position.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the Position Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Position.h"
+#include "PieceSquare.h"
+
+// ------------------------- Directions ------------------------- //
+
+/// Ray directions, the first four go up the board and the last four go down
+enum { North, NorthEast, East, NorthWest, South, SouthWest, West, SouthEast };
+
+// ------------------------- Tables ------------------------- //
+
+/// Squares a knight attacks from each square
+static Bitboard KnightAttacks[64];
+
+/// Squares a king attacks from each square
+static Bitboard KingAttacks[64];
+
+/// Squares a pawn attacks from each square, indexed by color
+static Bitboard PawnAttacks[2][64];
+
+/// Squares along each direction from each square on an empty board
+static Bitboard Rays[8][64];
+
+/// Castling rights kept when a piece leaves or lands on each square
+static uint8_t CastleMask[64];
+
+/// Midgame and endgame value of each piece type of each color on each square, negative for black
+static int32_t PieceSquareScores[2][6][64][2];
+
+/// Random keys for each piece type of each color on each square
+static uint64_t ZobristPieces[2][6][64];
+
+/// Random keys for each set of castling rights
+static uint64_t ZobristCastling[16];
+
+/// Random keys for the column of the en passant square
+static uint64_t ZobristEnPassant[8];
+
+/// Random key toggled when black is to move
+static uint64_t ZobristSide;
+
+/// Makes sure the tables are only built once
+static pthread_once_t TablesOnce = PTHREAD_ONCE_INIT;
+
+// ------------------------- Functions ------------------------- //
+
+/// Fills the attack tables
+static void InitPositionTables();
+
+/// Gets the next number of a fixed pseudo random sequence
+static inline uint64_t NextZobrist(uint64_t* const state);
+
+/// Gets the attacks along one ray stopping at the first blocker
+static inline Bitboard GetRayAttacks(const Index index, const uint8_t direction, const Bitboard occupied);
+
+/// Adds a piece to the grid and bitboards
+static inline void PutPiece(Position* const position, const Index index, const Piece piece);
+
+/// Removes the piece on a square from the grid and bitboards
+static inline void TakePiece(Position* const position, const Index index);
+
+/// Sets the en passant square if an enemy pawn could use it
+static inline void SetEnPassant(Position* const position, const Index index, const bool byWhite);
+
+/// Appends a move to the position move list
+static inline void AddPositionMove(PositionMoveList* const list, const Piece piece, const Index from, const Index to, const uint8_t promotion);
+
+/// Appends all four promotions of a pawn move
+static inline void AddPromotions(PositionMoveList* const list, const Piece piece, const Index from, const Index to);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Steps a splitmix64 generator, the seed is fixed so hashes are the same every run
+ * \param state: Generator state
+ * \returns uint64_t: The next number
+ */
+static inline uint64_t NextZobrist(uint64_t* const state)
+{
+
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+    return z ^ (z >> 31);
+
+}
+
+/*!
+ * \brief Fills the attack and hash tables used by the move generator
+ */
+static void InitPositionTables()
+{
+
+    const int8_t knightsteps[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+    const int8_t kingsteps[8][2] = {{0, 1}, {1, 1}, {1, 0}, {-1, 1}, {0, -1}, {-1, -1}, {-1, 0}, {1, -1}}; // Same order as the directions
+
+    for(Index index = 0; index < 64; index++) // For every square
+    {
+
+        int8_t col = GetColumn(index);
+        int8_t row = GetRow(index);
+
+        for(uint8_t i = 0; i < 8; i++)
+        {
+
+            int8_t x = col + knightsteps[i][0];
+            int8_t y = row + knightsteps[i][1];
+
+            if(x >= 0 && x < 8 && y >= 0 && y < 8) KnightAttacks[index] |= SquareBit(CreateIndex(x, y)); // If the jump stays on the board
+
+            x = col + kingsteps[i][0];
+            y = row + kingsteps[i][1];
+
+            if(x >= 0 && x < 8 && y >= 0 && y < 8) KingAttacks[index] |= SquareBit(CreateIndex(x, y)); // If the step stays on the board
+
+            for(x = col + kingsteps[i][0], y = row + kingsteps[i][1]; x >= 0 && x < 8 && y >= 0 && y < 8; x += kingsteps[i][0], y += kingsteps[i][1])
+                Rays[i][index] |= SquareBit(CreateIndex(x, y)); // Walk the ray until it leaves the board
+
+        }
+
+        if(row < 7 && col > 0) PawnAttacks[WHITE][index] |= SquareBit(index + 7);
+        if(row < 7 && col < 7) PawnAttacks[WHITE][index] |= SquareBit(index + 9);
+        if(row > 0 && col > 0) PawnAttacks[BLACK][index] |= SquareBit(index - 9);
+        if(row > 0 && col < 7) PawnAttacks[BLACK][index] |= SquareBit(index - 7);
+
+        CastleMask[index] = 0xf; // Most squares keep every right
+
+    }
+
+    CastleMask[0] = (uint8_t)~CASTLE_WHITE_QUEEN; // Rook squares lose their own right
+    CastleMask[7] = (uint8_t)~CASTLE_WHITE_KING;
+    CastleMask[56] = (uint8_t)~CASTLE_BLACK_QUEEN;
+    CastleMask[63] = (uint8_t)~CASTLE_BLACK_KING;
+    CastleMask[4] = (uint8_t)~(CASTLE_WHITE_KING | CASTLE_WHITE_QUEEN); // King squares lose both
+    CastleMask[60] = (uint8_t)~(CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN);
+
+    for(uint8_t color = 0; color < 2; color++) // Cache the scores so moving a piece is two adds
+        for(PieceType type = PawnType; type < NoType; type++)
+            for(Index index = 0; index < 64; index++)
+                for(uint8_t phase = 0; phase < 2; phase++)
+                    PieceSquareScores[color][type][index][phase] = (color? 1: -1) * GetPieceSquareValue(CreatePiece(color, GetTypeID(type), 0), index, phase);
+
+    uint64_t state = 0x5EED; // Same seed every run so stored hashes stay valid
+
+    for(uint8_t color = 0; color < 2; color++)
+        for(uint8_t type = 0; type < 6; type++)
+            for(Index index = 0; index < 64; index++)
+                ZobristPieces[color][type][index] = NextZobrist(&state);
+
+    for(uint8_t rights = 1; rights < 16; rights++) // No rights hashes to zero
+        ZobristCastling[rights] = NextZobrist(&state);
+
+    for(uint8_t col = 0; col < 8; col++)
+        ZobristEnPassant[col] = NextZobrist(&state);
+
+    ZobristSide = NextZobrist(&state);
+
+}
+
+/*!
+ * \brief Computes the hash of a position without the incremental updates
+ * \param position: Position to hash
+ * \returns uint64_t: Zobrist hash of the pieces, side to move, castling rights and en passant column
+ */
+uint64_t ComputePositionKey(const Position* const position)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    uint64_t key = ZobristCastling[position->castling];
+
+    for(Index index = 0; index < 64; index++)
+        if(position->grid[index]) key ^= ZobristPieces[IsPieceWhite(position->grid[index])][GetPieceType(position->grid[index])][index];
+
+    if(position->enpassant < 64) key ^= ZobristEnPassant[GetColumn(position->enpassant)];
+
+    if(!position->isWhite) key ^= ZobristSide;
+
+    return key;
+
+}
+
+/*!
+ * \brief Computes the pawn hash of a position without the incremental updates
+ * \param position: Position to hash
+ * \returns uint64_t: Zobrist hash of the pawns of both colors, zero without pawns
+ */
+uint64_t ComputePawnKey(const Position* const position)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    uint64_t key = 0;
+
+    for(uint8_t color = 0; color < 2; color++)
+        for(Bitboard pawns = position->pieces[color][PawnType]; pawns; pawns &= pawns - 1)
+            key ^= ZobristPieces[color][PawnType][FirstSquare(pawns)];
+
+    return key;
+
+}
+
+/*!
+ * \brief Gets the attacks along one direction
+ * \param index: Square the slider is on
+ * \param direction: Direction to look along
+ * \param occupied: All of the pieces on the board
+ * \returns Bitboard: Squares attacked up to and including the first blocker
+ */
+static inline Bitboard GetRayAttacks(const Index index, const uint8_t direction, const Bitboard occupied)
+{
+
+    Bitboard attacks = Rays[direction][index];
+    Bitboard blockers = attacks & occupied;
+
+    if(blockers) // Cut the ray off behind the closest blocker
+    {
+
+        Index blocker = (direction < South)? FirstSquare(blockers): (Index)(63 - __builtin_clzll(blockers));
+        attacks ^= Rays[direction][blocker];
+
+    }
+
+    return attacks;
+
+}
+
+/*!
+ * \brief Gets the squares a knight attacks
+ * \param index: Square of the knight
+ * \returns Bitboard: Attacked squares
+ */
+Bitboard GetKnightAttacks(const Index index)
+{
+
+    return KnightAttacks[index];
+
+}
+
+/*!
+ * \brief Gets the squares a king attacks
+ * \param index: Square of the king
+ * \returns Bitboard: Attacked squares
+ */
+Bitboard GetKingAttacks(const Index index)
+{
+
+    return KingAttacks[index];
+
+}
+
+/*!
+ * \brief Gets the squares a pawn attacks
+ * \param isWhite: Color of the pawn
+ * \param index: Square of the pawn
+ * \returns Bitboard: Attacked squares
+ */
+Bitboard GetPawnAttacks(const bool isWhite, const Index index)
+{
+
+    return PawnAttacks[isWhite][index];
+
+}
+
+/*!
+ * \brief Gets the squares a bishop attacks
+ * \param index: Square of the bishop
+ * \param occupied: All of the pieces on the board
+ * \returns Bitboard: Attacked squares
+ */
+Bitboard GetBishopAttacks(const Index index, const Bitboard occupied)
+{
+
+    return GetRayAttacks(index, NorthEast, occupied) | GetRayAttacks(index, NorthWest, occupied)
+        | GetRayAttacks(index, SouthEast, occupied) | GetRayAttacks(index, SouthWest, occupied);
+
+}
+
+/*!
+ * \brief Gets the squares a rook attacks
+ * \param index: Square of the rook
+ * \param occupied: All of the pieces on the board
+ * \returns Bitboard: Attacked squares
+ */
+Bitboard GetRookAttacks(const Index index, const Bitboard occupied)
+{
+
+    return GetRayAttacks(index, North, occupied) | GetRayAttacks(index, East, occupied)
+        | GetRayAttacks(index, South, occupied) | GetRayAttacks(index, West, occupied);
+
+}
+
+/*!
+ * \brief Gets every piece attacking a square
+ * \param position: Position to look in
+ * \param index: Square being attacked
+ * \param occupied: Pieces considered on the board, lets exchanges see through removed pieces
+ * \returns Bitboard: Attackers of both colors
+ */
+Bitboard GetAttackersTo(const Position* const position, const Index index, const Bitboard occupied)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    Bitboard diagonal = position->pieces[WHITE][BishopType] | position->pieces[BLACK][BishopType] | position->pieces[WHITE][QueenType] | position->pieces[BLACK][QueenType];
+    Bitboard straight = position->pieces[WHITE][RookType] | position->pieces[BLACK][RookType] | position->pieces[WHITE][QueenType] | position->pieces[BLACK][QueenType];
+
+    return ((PawnAttacks[BLACK][index] & position->pieces[WHITE][PawnType]) // White pawns attack like black pawns seen from the target
+        | (PawnAttacks[WHITE][index] & position->pieces[BLACK][PawnType])
+        | (KnightAttacks[index] & (position->pieces[WHITE][KnightType] | position->pieces[BLACK][KnightType]))
+        | (KingAttacks[index] & (position->pieces[WHITE][KingType] | position->pieces[BLACK][KingType]))
+        | (GetBishopAttacks(index, occupied) & diagonal)
+        | (GetRookAttacks(index, occupied) & straight)) & occupied;
+
+}
+
+/*!
+ * \brief Checks if a square is attacked by a color
+ * \param position: Position to look in
+ * \param index: Square to check
+ * \param byWhite: Color of the attackers
+ * \returns bool: If any piece of the color attacks the square
+ */
+bool IsSquareAttacked(const Position* const position, const Index index, const bool byWhite)
+{
+
+    const Bitboard* pieces = position->pieces[byWhite];
+    Bitboard occupied = position->occupancy[WHITE] | position->occupancy[BLACK];
+
+    if(PawnAttacks[!byWhite][index] & pieces[PawnType]) return true; // Look from the square as the other color's pawn
+    if(KnightAttacks[index] & pieces[KnightType]) return true;
+    if(KingAttacks[index] & pieces[KingType]) return true;
+    if(GetBishopAttacks(index, occupied) & (pieces[BishopType] | pieces[QueenType])) return true;
+    if(GetRookAttacks(index, occupied) & (pieces[RookType] | pieces[QueenType])) return true;
+
+    return false;
+
+}
+
+/*!
+ * \brief Gets the square of a king
+ * \param position: Position to look in
+ * \param isWhite: Color of the king
+ * \returns Index: Square of the king, INDEX_MAX if there is none
+ */
+Index GetPositionKing(const Position* const position, const bool isWhite)
+{
+
+    Bitboard king = position->pieces[isWhite][KingType];
+
+    return king? FirstSquare(king): INDEX_MAX;
+
+}
+
+/*!
+ * \brief Checks if the side to move is in check
+ * \param position: Position to look in
+ * \returns bool: If the king of the side to move is attacked
+ */
+bool IsPositionInCheck(const Position* const position)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    Index king = GetPositionKing(position, position->isWhite);
+
+    return king < 64 && IsSquareAttacked(position, king, !position->isWhite);
+
+}
+
+/*!
+ * \brief Checks if a move captures something
+ * \param position: Position before the move
+ * \param move: Move to check
+ * \returns bool: If the move captures, en passant included
+ */
+bool IsCaptureMove(const Position* const position, const Move move)
+{
+
+    return position->grid[move.end] != EMPTY || (move.end == position->enpassant && GetPieceType(move.piece) == PawnType);
+
+}
+
+/*!
+ * \brief Adds a piece to a square
+ * \param position: Position to change
+ * \param index: Square to put the piece on
+ * \param piece: Piece to put down
+ */
+static inline void PutPiece(Position* const position, const Index index, const Piece piece)
+{
+
+    bool isWhite = IsPieceWhite(piece);
+
+    position->grid[index] = piece;
+    position->pieces[isWhite][GetPieceType(piece)] |= SquareBit(index);
+    position->occupancy[isWhite] |= SquareBit(index);
+    position->key ^= ZobristPieces[isWhite][GetPieceType(piece)][index];
+    position->midgame += PieceSquareScores[isWhite][GetPieceType(piece)][index][0];
+    position->endgame += PieceSquareScores[isWhite][GetPieceType(piece)][index][1];
+    position->phase += GetPhaseWeight(GetPieceType(piece));
+
+    if(GetPieceType(piece) == PawnType) position->pawnkey ^= ZobristPieces[isWhite][PawnType][index];
+
+}
+
+/*!
+ * \brief Removes the piece on a square
+ * \param position: Position to change
+ * \param index: Square to clear
+ */
+static inline void TakePiece(Position* const position, const Index index)
+{
+
+    Piece piece = position->grid[index];
+    bool isWhite = IsPieceWhite(piece);
+
+    position->grid[index] = EMPTY;
+    position->pieces[isWhite][GetPieceType(piece)] &= ~SquareBit(index);
+    position->occupancy[isWhite] &= ~SquareBit(index);
+    position->key ^= ZobristPieces[isWhite][GetPieceType(piece)][index];
+    position->midgame -= PieceSquareScores[isWhite][GetPieceType(piece)][index][0];
+    position->endgame -= PieceSquareScores[isWhite][GetPieceType(piece)][index][1];
+    position->phase -= GetPhaseWeight(GetPieceType(piece));
+
+    if(GetPieceType(piece) == PawnType) position->pawnkey ^= ZobristPieces[isWhite][PawnType][index];
+
+}
+
+/*!
+ * \brief Sets the en passant square only when a pawn could actually take there
+ * \param position: Position to change
+ * \param index: Square that was skipped by the double move
+ * \param byWhite: Color that would make the capture
+ */
+static inline void SetEnPassant(Position* const position, const Index index, const bool byWhite)
+{
+
+    if(PawnAttacks[!byWhite][index] & position->pieces[byWhite][PawnType]) // If a pawn of the capturing color attacks the square
+        position->enpassant = index;
+
+}
+
+/*!
+ * \brief Sets the position to the start of a game
+ * \param position: Position to reset
+ */
+void ResetPosition(Position* const position)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    Board board[1];
+
+    ResetBoard(board); // Start from the default board
+
+    pthread_once(&TablesOnce, InitPositionTables);
+
+    memset(position, 0, sizeof(Position));
+
+    for(Index i = 0; i < 64; i++)
+        if(GetPiece(board, i)) PutPiece(position, i, GetPiece(board, i));
+
+    position->isWhite = WHITE;
+    position->castling = CASTLE_WHITE_KING | CASTLE_WHITE_QUEEN | CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN;
+    position->enpassant = INDEX_MAX;
+    position->halfmove = 0;
+    position->key = ComputePositionKey(position);
+
+}
+
+/*!
+ * \brief Builds a position from the game data
+ * \param position: Position to fill
+ * \param data: Current gamedata
+ * \param isWhite: Side to move
+ */
+void SetPositionFromGameData(Position* const position, const GameData* const data, const bool isWhite)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(data, "Invalid Gamedata Pointer");
+
+    pthread_once(&TablesOnce, InitPositionTables);
+
+    memset(position, 0, sizeof(Position));
+
+    for(Index i = 0; i < 64; i++)
+        if(GetPiece(GetBoard(data), i)) PutPiece(position, i, GetPiece(GetBoard(data), i));
+
+    position->isWhite = isWhite;
+    position->enpassant = INDEX_MAX;
+    position->halfmove = GetTurnCounter(data);
+    position->castling = 0;
+
+    const uint8_t rights[2][2] = {{CASTLE_BLACK_QUEEN, CASTLE_BLACK_KING}, {CASTLE_WHITE_QUEEN, CASTLE_WHITE_KING}}; // Indexed by color then rook number
+
+    for(uint8_t color = 0; color < 2; color++) // The flags only say the pieces never moved, make sure they are still home
+    {
+
+        Player* player = GetPlayer(data, color);
+        Index home = color? 4: 60;
+
+        if(GetPieceType(position->grid[home]) != KingType || IsPieceWhite(position->grid[home]) != color) continue;
+
+        for(uint8_t rooknum = 0; rooknum < 2; rooknum++)
+        {
+
+            Index corner = home + (rooknum? 3: -4);
+
+            if(CanCastle(player, rooknum) && GetPieceType(position->grid[corner]) == RookType && IsPieceWhite(position->grid[corner]) == color)
+                position->castling |= rights[color][rooknum];
+
+        }
+    }
+
+    Move last = PeekMove(GetMoveStack(data)); // A double pawn move opens up en passant
+
+    if(GetPieceID(last.piece) == PAWN && abs(GetRow(last.start) - GetRow(last.end)) == 2 && IsPieceWhite(last.piece) != isWhite)
+        SetEnPassant(position, (last.start + last.end) / 2, isWhite);
+
+    position->key = ComputePositionKey(position);
+
+}
+
+/*!
+ * \brief Builds a position from the fields of a FEN string
+ * \details Reads the placement, side to move, castling and en passant fields, then the halfmove and fullmove numbers if they are there
+ * EPD lines leave the numbers out and carry operations instead, those are left for the caller
+ * \param position: Position to fill
+ * \param fen: String to read, eg "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"
+ * \returns const char*: Rest of the string after the fields that were read, NULL if it isn't a legal position
+ */
+const char* SetPositionFromFEN(Position* const position, const char* const fen)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(fen, "Invalid FEN Pointer");
+
+    const char* c = fen;
+    uint8_t row = 7;
+    uint8_t column = 0;
+
+    pthread_once(&TablesOnce, InitPositionTables);
+
+    memset(position, 0, sizeof(Position));
+
+    while(isspace((unsigned char)*c)) c++;
+
+    for(; *c && *c != ' '; c++) // Placement, rank 8 first
+    {
+
+        if(*c == '/')
+        {
+
+            if(column != 8 || !row--) return NULL;
+
+            column = 0;
+
+        }
+
+        else if(*c >= '1' && *c <= '8') column += *c - '0';
+
+        else if(strchr("PNBRQK", toupper((unsigned char)*c)) && column < 8)
+            PutPiece(position, CreateIndex(column++, row), CreatePiece(isupper((unsigned char)*c), toupper((unsigned char)*c), 0));
+
+        else return NULL;
+
+        if(column > 8) return NULL;
+
+    }
+
+    if(row || column != 8 || CountSquares(position->pieces[WHITE][KingType]) != 1 || CountSquares(position->pieces[BLACK][KingType]) != 1) return NULL;
+
+    while(*c == ' ') c++;
+
+    if(*c != 'w' && *c != 'b') return NULL;
+
+    position->isWhite = (*c++ == 'w');
+
+    while(*c == ' ') c++;
+
+    for(; *c && *c != ' '; c++) // Castling, '-' for none
+    {
+
+        if(*c == 'K') position->castling |= CASTLE_WHITE_KING;
+        else if(*c == 'Q') position->castling |= CASTLE_WHITE_QUEEN;
+        else if(*c == 'k') position->castling |= CASTLE_BLACK_KING;
+        else if(*c == 'q') position->castling |= CASTLE_BLACK_QUEEN;
+        else if(*c != '-') return NULL;
+
+    }
+
+    const Index homes[4][2] = {{4, 7}, {4, 0}, {60, 63}, {60, 56}}; // King and rook of each right, in the order of the flags
+
+    for(uint8_t i = 0; i < 4; i++) // Rights whose pieces aren't home can't be used
+    {
+
+        bool isWhite = i < 2;
+
+        if(!(position->pieces[isWhite][KingType] & SquareBit(homes[i][0])) || !(position->pieces[isWhite][RookType] & SquareBit(homes[i][1])))
+            position->castling &= ~(1 << i);
+
+    }
+
+    while(*c == ' ') c++;
+
+    position->enpassant = INDEX_MAX;
+
+    if(*c >= 'a' && *c <= 'h' && (c[1] == '3' || c[1] == '6'))
+    {
+
+        SetEnPassant(position, CreateIndex(c[0] - 'a', c[1] - '1'), position->isWhite); // Only kept if a pawn can take
+        c += 2;
+
+    }
+
+    else if(*c == '-') c++;
+
+    else return NULL;
+
+    while(*c == ' ') c++;
+
+    if(isdigit((unsigned char)*c)) // The move numbers of a FEN, an EPD goes straight to its operations
+    {
+
+        position->halfmove = (uint8_t)strtoul(c, (char**)&c, 10);
+
+        while(*c == ' ') c++;
+
+        if(isdigit((unsigned char)*c)) strtoul(c, (char**)&c, 10);
+
+        while(*c == ' ') c++;
+
+    }
+
+    if(IsSquareAttacked(position, GetPositionKing(position, !position->isWhite), position->isWhite)) return NULL; // The side that just moved can't be in check
+
+    position->key = ComputePositionKey(position);
+
+    return c;
+
+}
+
+/*!
+ * \brief Builds a position from a list of pieces and their squares, with no castling rights, en passant or halfmove clock
+ * \param position: Position to fill
+ * \param pieces: Pieces to put down, one king of each color among them
+ * \param squares: Square of each piece
+ * \param count: Number of pieces
+ * \param isWhite: Side to move
+ * \returns bool: False if two pieces share a square, a pawn is on the first or last row or the side that just moved is in check
+ */
+bool SetPositionFromPieces(Position* const position, const Piece* const pieces, const Index* const squares, const uint8_t count, const bool isWhite)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(pieces, "Invalid Pieces Pointer");
+    STATIC_ASSERT(squares, "Invalid Squares Pointer");
+
+    pthread_once(&TablesOnce, InitPositionTables);
+
+    memset(position, 0, sizeof(Position));
+
+    for(uint8_t i = 0; i < count; i++)
+    {
+
+        if(position->grid[squares[i]]) return false;
+
+        if(GetPieceType(pieces[i]) == PawnType && (GetRow(squares[i]) == 0 || GetRow(squares[i]) == 7)) return false;
+
+        PutPiece(position, squares[i], pieces[i]);
+
+    }
+
+    position->isWhite = isWhite;
+    position->enpassant = INDEX_MAX;
+
+    if(CountSquares(position->pieces[WHITE][KingType]) != 1 || CountSquares(position->pieces[BLACK][KingType]) != 1) return false;
+
+    if(IsSquareAttacked(position, GetPositionKing(position, !isWhite), isWhite)) return false; // The side that just moved can't be in check
+
+    position->key = ComputePositionKey(position);
+
+    return true;
+
+}
+
+/*!
+ * \brief Plays a move on the position
+ * \param position: Position to change
+ * \param move: Pseudo legal move to play
+ * \param undo: Filled with what is needed to take the move back
+ */
+void MakePositionMove(Position* const position, const Move move, PositionUndo* const undo)
+{
+
+    Piece piece = position->grid[move.start];
+    PieceType type = GetPieceType(piece);
+    bool isWhite = position->isWhite;
+
+    undo->captured = position->grid[move.end];
+    undo->castling = position->castling;
+    undo->enpassant = position->enpassant;
+    undo->halfmove = position->halfmove;
+    undo->key = position->key;
+
+    if(undo->enpassant < 64) position->key ^= ZobristEnPassant[GetColumn(undo->enpassant)];
+
+    position->halfmove++;
+    position->enpassant = INDEX_MAX;
+    position->castling &= CastleMask[move.start] & CastleMask[move.end]; // Moving from or onto a corner loses the rights
+    position->key ^= ZobristCastling[undo->castling] ^ ZobristCastling[position->castling] ^ ZobristSide;
+
+    if(undo->captured) // Take the captured piece off
+    {
+
+        TakePiece(position, move.end);
+        position->halfmove = 0;
+
+    }
+
+    TakePiece(position, move.start);
+
+    if(type == PawnType)
+    {
+
+        position->halfmove = 0;
+
+        if(move.end == undo->enpassant) // The captured pawn is behind the target square
+        {
+
+            Index victim = isWhite? move.end - 8: move.end + 8;
+
+            undo->captured = position->grid[victim];
+            TakePiece(position, victim);
+
+        }
+
+        else if(abs(move.end - move.start) == 16) // A double move lets the other side capture en passant
+            SetEnPassant(position, (move.start + move.end) / 2, !isWhite);
+
+        if(move.promotion) piece = CreatePiece(isWhite, move.promotion, 0); // Swap the pawn for its promotion
+
+    }
+
+    PutPiece(position, move.end, piece);
+
+    if(type == KingType && abs(move.end - move.start) == 2) // Castling also moves the rook
+    {
+
+        Index corner = (move.end > move.start)? move.start + 3: move.start - 4;
+        Index rookto = (move.end > move.start)? move.start + 1: move.start - 1;
+        Piece rook = position->grid[corner];
+
+        TakePiece(position, corner);
+        PutPiece(position, rookto, rook);
+
+    }
+
+    if(position->enpassant < 64) position->key ^= ZobristEnPassant[GetColumn(position->enpassant)];
+
+    position->isWhite = !isWhite;
+
+}
+
+/*!
+ * \brief Takes a move back
+ * \param position: Position to change
+ * \param move: Move that was played
+ * \param undo: Undo information filled when the move was played
+ */
+void UnmakePositionMove(Position* const position, const Move move, const PositionUndo* const undo)
+{
+
+    bool isWhite = !position->isWhite; // The side that made the move
+    Piece piece = move.piece;
+    PieceType type = GetPieceType(piece);
+
+    position->isWhite = isWhite;
+    position->castling = undo->castling;
+    position->enpassant = undo->enpassant;
+    position->halfmove = undo->halfmove;
+
+    if(type == KingType && abs(move.end - move.start) == 2) // Put the castled rook back
+    {
+
+        Index corner = (move.end > move.start)? move.start + 3: move.start - 4;
+        Index rookfrom = (move.end > move.start)? move.start + 1: move.start - 1;
+        Piece rook = position->grid[rookfrom];
+
+        TakePiece(position, rookfrom);
+        PutPiece(position, corner, rook);
+
+    }
+
+    TakePiece(position, move.end);
+    PutPiece(position, move.start, piece);
+
+    if(undo->captured)
+    {
+
+        if(type == PawnType && move.end == undo->enpassant) // En passant victims go back behind the target
+            PutPiece(position, isWhite? move.end - 8: move.end + 8, undo->captured);
+        else PutPiece(position, move.end, undo->captured);
+
+    }
+
+    position->key = undo->key; // Cheaper than undoing each change
+
+}
+
+/*!
+ * \brief Passes the turn without moving a piece
+ * \details Only the search uses it, to see if the side to move would still be doing well after giving the opponent a free move
+ * \param position: Position to change, the side to move must not be in check
+ * \param undo: Filled with what is needed to take the pass back
+ */
+void MakeNullMove(Position* const position, PositionUndo* const undo)
+{
+
+    undo->captured = EMPTY;
+    undo->castling = position->castling;
+    undo->enpassant = position->enpassant;
+    undo->halfmove = position->halfmove;
+    undo->key = position->key;
+
+    if(position->enpassant < 64) position->key ^= ZobristEnPassant[GetColumn(position->enpassant)];
+
+    position->key ^= ZobristSide;
+    position->enpassant = INDEX_MAX;
+    position->halfmove++;
+    position->isWhite = !position->isWhite;
+
+}
+
+/*!
+ * \brief Takes back a pass played with MakeNullMove
+ * \param position: Position to change
+ * \param undo: Undo information filled when the pass was played
+ */
+void UnmakeNullMove(Position* const position, const PositionUndo* const undo)
+{
+
+    position->isWhite = !position->isWhite;
+    position->enpassant = undo->enpassant;
+    position->halfmove = undo->halfmove;
+    position->key = undo->key;
+
+}
+
+/*!
+ * \brief Appends a move to the position move list
+ * \param list: List to append to
+ * \param piece: Piece being moved
+ * \param from: Starting square
+ * \param to: Ending square
+ * \param promotion: Promotion piece ID, EMPTY if none
+ */
+static inline void AddPositionMove(PositionMoveList* const list, const Piece piece, const Index from, const Index to, const uint8_t promotion)
+{
+
+    Move* move = &list->move[list->size++];
+
+    move->piece = piece;
+    move->start = from;
+    move->end = to;
+    move->promotion = promotion;
+
+}
+
+/*!
+ * \brief Appends every promotion of a pawn move
+ * \param list: List to append to
+ * \param piece: Pawn being moved
+ * \param from: Starting square
+ * \param to: Square on the last row
+ */
+static inline void AddPromotions(PositionMoveList* const list, const Piece piece, const Index from, const Index to)
+{
+
+    AddPositionMove(list, piece, from, to, QUEEN);
+    AddPositionMove(list, piece, from, to, KNIGHT);
+    AddPositionMove(list, piece, from, to, ROOK);
+    AddPositionMove(list, piece, from, to, BISHOP);
+
+}
+
+/*!
+ * \brief Generates every pseudo legal move for the side to move
+ * \param position: Position to generate for
+ * \param list: List to fill
+ * \returns uint8_t: The number of moves
+ */
+uint8_t GeneratePseudoMoves(const Position* const position, PositionMoveList* const list)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(list, "Invalid Move List Pointer");
+
+    bool us = position->isWhite;
+    const Bitboard* pieces = position->pieces[us];
+    Bitboard own = position->occupancy[us];
+    Bitboard enemy = position->occupancy[!us];
+    Bitboard occupied = own | enemy;
+    Bitboard targets;
+
+    list->size = 0;
+
+    int8_t forward = us? 8: -8; // Direction the pawns move
+    uint8_t startrow = us? 1: 6; // Row the pawns can double move from
+    uint8_t lastrow = us? 7: 0; // Row the pawns promote on
+
+    for(Bitboard pawns = pieces[PawnType]; pawns; pawns &= pawns - 1) // Pawns
+    {
+
+        Index from = FirstSquare(pawns);
+        Index to = from + forward;
+        Piece piece = position->grid[from];
+
+        if(!(occupied & SquareBit(to))) // Moves forward onto an empty square
+        {
+
+            if(GetRow(to) == lastrow) AddPromotions(list, piece, from, to);
+            else
+            {
+
+                AddPositionMove(list, piece, from, to, EMPTY);
+
+                if(GetRow(from) == startrow && !(occupied & SquareBit(to + forward)))
+                    AddPositionMove(list, piece, from, to + forward, EMPTY);
+
+            }
+        }
+
+        targets = PawnAttacks[us][from] & enemy;
+
+        if(position->enpassant < 64) targets |= PawnAttacks[us][from] & SquareBit(position->enpassant);
+
+        for(; targets; targets &= targets - 1) // Captures
+        {
+
+            to = FirstSquare(targets);
+
+            if(GetRow(to) == lastrow) AddPromotions(list, piece, from, to);
+            else AddPositionMove(list, piece, from, to, EMPTY);
+
+        }
+    }
+
+    for(PieceType type = KnightType; type <= KingType; type++) // Every other piece
+    {
+
+        for(Bitboard bits = pieces[type]; bits; bits &= bits - 1)
+        {
+
+            Index from = FirstSquare(bits);
+
+            switch(type)
+            {
+
+                case KnightType: targets = KnightAttacks[from]; break;
+                case BishopType: targets = GetBishopAttacks(from, occupied); break;
+                case RookType: targets = GetRookAttacks(from, occupied); break;
+                case QueenType: targets = GetBishopAttacks(from, occupied) | GetRookAttacks(from, occupied); break;
+                default: targets = KingAttacks[from]; break;
+
+            }
+
+            for(targets &= ~own; targets; targets &= targets - 1)
+                AddPositionMove(list, position->grid[from], from, FirstSquare(targets), EMPTY);
+
+        }
+    }
+
+    uint8_t kingside = us? CASTLE_WHITE_KING: CASTLE_BLACK_KING;
+    uint8_t queenside = us? CASTLE_WHITE_QUEEN: CASTLE_BLACK_QUEEN;
+    Index home = us? 4: 60;
+
+    if((position->castling & kingside) && !(occupied & (SquareBit(home + 1) | SquareBit(home + 2))) // Kingside needs two empty squares
+        && !IsSquareAttacked(position, home, !us) && !IsSquareAttacked(position, home + 1, !us) && !IsSquareAttacked(position, home + 2, !us))
+        AddPositionMove(list, position->grid[home], home, home + 2, EMPTY);
+
+    if((position->castling & queenside) && !(occupied & (SquareBit(home - 1) | SquareBit(home - 2) | SquareBit(home - 3))) // Queenside needs three
+        && !IsSquareAttacked(position, home, !us) && !IsSquareAttacked(position, home - 1, !us) && !IsSquareAttacked(position, home - 2, !us))
+        AddPositionMove(list, position->grid[home], home, home - 2, EMPTY);
+
+    return (uint8_t)list->size;
+
+}
+
+/*!
+ * \brief Generates the captures and queen promotions of the side to move, the moves that change the material
+ * \details Underpromotions are left out, they almost never change the outcome of a capture sequence
+ * \param position: Position to generate for
+ * \param list: List to fill
+ * \returns uint8_t: The number of moves
+ */
+uint8_t GenerateTacticalMoves(const Position* const position, PositionMoveList* const list)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(list, "Invalid Move List Pointer");
+
+    bool us = position->isWhite;
+    const Bitboard* pieces = position->pieces[us];
+    Bitboard enemy = position->occupancy[!us];
+    Bitboard occupied = position->occupancy[us] | enemy;
+    Bitboard targets;
+
+    list->size = 0;
+
+    int8_t forward = us? 8: -8; // Direction the pawns move
+    uint8_t lastrow = us? 7: 0; // Row the pawns promote on
+
+    for(Bitboard pawns = pieces[PawnType]; pawns; pawns &= pawns - 1) // Pawns
+    {
+
+        Index from = FirstSquare(pawns);
+        Index to = from + forward;
+        Piece piece = position->grid[from];
+
+        if(GetRow(to) == lastrow && !(occupied & SquareBit(to))) AddPositionMove(list, piece, from, to, QUEEN);
+
+        targets = PawnAttacks[us][from] & enemy;
+
+        if(position->enpassant < 64) targets |= PawnAttacks[us][from] & SquareBit(position->enpassant);
+
+        for(; targets; targets &= targets - 1) // Captures
+        {
+
+            to = FirstSquare(targets);
+
+            AddPositionMove(list, piece, from, to, (GetRow(to) == lastrow)? QUEEN: EMPTY);
+
+        }
+    }
+
+    for(PieceType type = KnightType; type <= KingType; type++) // Every other piece
+    {
+
+        for(Bitboard bits = pieces[type]; bits; bits &= bits - 1)
+        {
+
+            Index from = FirstSquare(bits);
+
+            switch(type)
+            {
+
+                case KnightType: targets = KnightAttacks[from]; break;
+                case BishopType: targets = GetBishopAttacks(from, occupied); break;
+                case RookType: targets = GetRookAttacks(from, occupied); break;
+                case QueenType: targets = GetBishopAttacks(from, occupied) | GetRookAttacks(from, occupied); break;
+                default: targets = KingAttacks[from]; break;
+
+            }
+
+            for(targets &= enemy; targets; targets &= targets - 1)
+                AddPositionMove(list, position->grid[from], from, FirstSquare(targets), EMPTY);
+
+        }
+    }
+
+    return (uint8_t)list->size;
+
+}
+
+/*!
+ * \brief Checks if a pseudo legal move keeps the mover's king out of check
+ * \param position: Position before the move, left unchanged
+ * \param move: Move to check
+ * \returns bool: If the move is legal
+ */
+bool IsLegalPositionMove(Position* const position, const Move move)
+{
+
+    PositionUndo undo;
+
+    MakePositionMove(position, move, &undo);
+
+    Index king = GetPositionKing(position, !position->isWhite);
+    bool legal = king > 63 || !IsSquareAttacked(position, king, position->isWhite);
+
+    UnmakePositionMove(position, move, &undo);
+
+    return legal;
+
+}
+
+/*!
+ * \brief Generates every legal move for the side to move
+ * \param position: Position to generate for, left unchanged
+ * \param list: List to fill
+ * \returns uint8_t: The number of moves
+ */
+uint8_t GenerateLegalMoves(Position* const position, PositionMoveList* const list)
+{
+
+    GeneratePseudoMoves(position, list);
+
+    size_t size = 0;
+
+    for(size_t i = 0; i < list->size; i++) // Keep only the moves that don't leave the king in check
+        if(IsLegalPositionMove(position, list->move[i])) list->move[size++] = list->move[i];
+
+    list->size = size;
+
+    return (uint8_t)size;
+
+}
+
+/*!
+ * \brief Checks if the side to move can move at all
+ * \param position: Position to look in, left unchanged
+ * \returns bool: If there is at least one legal move
+ */
+bool HasLegalMoves(Position* const position)
+{
+
+    PositionMoveList list[1];
+
+    GeneratePseudoMoves(position, list);
+
+    for(size_t i = 0; i < list->size; i++) // Stop at the first legal move
+        if(IsLegalPositionMove(position, list->move[i])) return true;
+
+    return false;
+
+}
+
+// EOF //
@@ -0,0 +1,1113 @@
+/*!
+ * \file Retrograde.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the Retrograde Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#define _POSIX_C_SOURCE 200809L // clock_gettime, access and mkdir aren't part of plain C99
+
+#include "Retrograde.h"
+#include "ThreadPool.h"
+
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// ------------------------- Limits ------------------------- //
+
+/// Value of an entry whose distance isn't known yet, no value in a file is ever this low
+#define RETROGRADE_PENDING INT8_MIN
+
+/// Most predecessors of one entry, every piece of a side sliding back as far as a queen can
+#define RETROGRADE_MAX_PREDECESSORS (TABLEBASE_MAX_PIECES * 28)
+
+// ------------------------- Macros ------------------------- //
+
+/// Checks the bit of an entry in one of the bit sets, other threads may be setting bits of the same word
+#define TestEntry(bits, index) ((__atomic_load_n(&(bits)[(index) >> 6], __ATOMIC_RELAXED) >> ((index) & 63)) & 1)
+
+/// Sets the bit of an entry in one of the bit sets
+#define MarkEntry(bits, index) __atomic_fetch_or(&(bits)[(index) >> 6], SquareBit((index) & 63), __ATOMIC_RELAXED)
+
+// ------------------------- Types ------------------------- //
+
+/// Passes over every entry of a table, in the order they run
+typedef enum
+{
+
+    PassSetup,          ///< Marks the legal entries, mates and the entries decided by a capture or promotion
+    PassResults,        ///< Spreads the results of the frontier back to their predecessors
+    PassZeroing,        ///< Counts the quiet moves of each decided entry and finds the ones a capture or pawn move wins or loses right away
+    PassDistances       ///< Spreads the distances of one level back to their predecessors
+
+} RetrogradePass;
+
+/*!
+ * \brief Share of the entries one thread works through
+ * \details The shares start on multiples of 64 so no two threads own the same word of a bit set, though they still update each other's predecessors
+ */
+typedef struct
+{
+
+    Retrograde* table;           ///< Table being worked out
+    RetrogradePass pass;         ///< Pass to run
+    uint8_t level;               ///< Distance being spread by PassDistances
+
+    size_t start;                ///< First entry of the share
+    size_t end;                  ///< Entry after the last one
+
+    size_t changed;              ///< Entries the share decided
+
+} RetrogradeTask;
+
+// ------------------------- Tables ------------------------- //
+
+/// Order the piece types are listed in, both in table names and in the index
+static const PieceType TypeOrder[6] = {KingType, QueenType, RookType, BishopType, KnightType, PawnType};
+
+// ------------------------- Functions ------------------------- //
+
+/// Reads the piece counts of a material name like KQvKR
+static bool ParseMaterialName(const char* const name, uint8_t counts[2][6]);
+
+/// Puts the stronger side of a material first and names it
+static void NameMaterial(uint8_t counts[2][6], char name[TABLEBASE_NAME_MAX]);
+
+/// Gets the squares of an entry
+static bool DecodeEntry(const Retrograde* const table, size_t index, Index* const squares);
+
+/// Gets the entry of squares
+static size_t EncodeEntry(const Retrograde* const table, const Index* const squares, const bool isWhite);
+
+/// Gets the entry of a position of the table
+static size_t GetPositionEntry(const Retrograde* const table, const Position* const position);
+
+/// Gets the entries one move back from an entry
+static uint8_t GetPredecessors(Retrograde* const table, const Index* const squares, const bool isWhite, const bool pawns, const bool lost, size_t* const entries);
+
+/// Looks up the position after a capture or promotion in the smaller tables
+static int8_t ProbeSmallerTable(Retrograde* const table, const Position* const position);
+
+/// Gets the result of the best en passant capture after a double pawn move for the side that can make it
+static int8_t ProbeEnPassant(Retrograde* const table, Position* const position);
+
+/// Works out one entry for PassSetup
+static bool SetupEntry(Retrograde* const table, const size_t index);
+
+/// Works out one entry for PassResults
+static size_t SpreadResult(Retrograde* const table, const size_t index);
+
+/// Works out one entry for PassZeroing
+static bool SetupDistance(Retrograde* const table, const size_t index);
+
+/// Works out one entry for PassDistances
+static size_t SpreadDistance(Retrograde* const table, const size_t index, const uint8_t level);
+
+/// Runs a pass over a share of the entries
+static void* RetrogradeWorker(void* task);
+
+/// Runs a pass over every entry on the threads
+static size_t RunRetrogradePass(Retrograde* const table, const uint8_t threads, const RetrogradePass pass, const uint8_t level);
+
+/// Frees the arrays of a table
+static void FreeRetrograde(Retrograde* const table);
+
+/// Writes one file of a finished table
+static bool WriteTableFile(const char* const path, const char* const magic, const uint8_t pieces, const uint8_t* const data, const size_t size);
+
+/// Writes the result and distance files of a finished table
+static bool WriteTablebase(const Retrograde* const table, const uint8_t material[2][6], const char* const directory);
+
+/// Prints how the entries of a table came out
+static void ReportRetrograde(const Retrograde* const table, FILE* const report, const double seconds);
+
+/// Grows the shared thread pool for a generation and gets the threads it can use
+static uint8_t ReserveRetrogradeThreads(const uint8_t threads);
+
+/// Generates the table of a material after the tables it needs
+static bool BuildTablebase(const char* const directory, const uint8_t material[2][6], const uint8_t threads, FILE* const report);
+
+/// Generates every material with some pieces still to be handed out
+static bool BuildMaterials(const char* const directory, uint8_t counts[2][6], const uint8_t first, const uint8_t left, const uint8_t threads, FILE* const report);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Reads the piece counts of a material name like KQvKR, white being the side before the v
+ * \param name: Name to read
+ * \param counts: Filled with the count of each piece type of each side, indexed by side then type
+ * \returns bool: True if the name has one king on each side and no more pieces than a table can hold
+ */
+static bool ParseMaterialName(const char* const name, uint8_t counts[2][6])
+{
+
+    const char* letters = "PNBRQK"; // Indexed by type
+    uint8_t side = 0;
+    uint8_t pieces = 0;
+
+    memset(counts, 0, 2 * 6 * sizeof(uint8_t));
+
+    for(const char* c = name; *c; c++)
+    {
+
+        const char* letter = strchr(letters, *c);
+
+        if(*c == 'v' && !side) side = 1;
+
+        else if(!letter || ++pieces > TABLEBASE_MAX_PIECES) return false;
+
+        else counts[side][letter - letters]++;
+
+    }
+
+    return side && counts[0][KingType] == 1 && counts[1][KingType] == 1;
+
+}
+
+/*!
+ * \brief Puts the side with more pieces, or the stronger pieces, first so every material has one name
+ * \param counts: Counts of each piece type of each side, swapped if the second side is stronger
+ * \param name: Filled with the name, like KQvKR
+ */
+static void NameMaterial(uint8_t counts[2][6], char name[TABLEBASE_NAME_MAX])
+{
+
+    uint8_t totals[2] = {0, 0};
+    size_t length = 0;
+    int8_t order = 0;
+
+    for(uint8_t side = 0; side < 2; side++)
+        for(PieceType type = PawnType; type < NoType; type++) totals[side] += counts[side][type];
+
+    order = (totals[0] > totals[1]) - (totals[0] < totals[1]);
+
+    for(uint8_t i = 0; i < 6 && !order; i++) // Same number of pieces, the first stronger piece decides
+        order = (counts[0][TypeOrder[i]] > counts[1][TypeOrder[i]]) - (counts[0][TypeOrder[i]] < counts[1][TypeOrder[i]]);
+
+    if(order < 0)
+    {
+
+        uint8_t swapped[6];
+
+        memcpy(swapped, counts[0], sizeof(swapped));
+        memcpy(counts[0], counts[1], sizeof(swapped));
+        memcpy(counts[1], swapped, sizeof(swapped));
+
+    }
+
+    for(uint8_t side = 0; side < 2; side++)
+    {
+
+        if(side) name[length++] = 'v';
+
+        for(uint8_t i = 0; i < 6; i++)
+            for(uint8_t n = 0; n < counts[side][TypeOrder[i]]; n++) name[length++] = (char)GetTypeID(TypeOrder[i]);
+
+    }
+
+    name[length] = '\0';
+
+}
+
+/*!
+ * \brief Gets the squares of each piece of an entry
+ * \details Pieces of the same type and color are only kept lowest square first, any other order is the same position under another entry
+ * \param table: Table of the entry
+ * \param index: Entry to read
+ * \param squares: Filled with the square of each slot
+ * \returns bool: False if the entry repeats another one or puts two pieces on one square
+ */
+static bool DecodeEntry(const Retrograde* const table, size_t index, Index* const squares)
+{
+
+    for(uint8_t i = table->pieces; i--; index >>= 6) squares[i] = index & 63;
+
+    for(uint8_t i = 1; i < table->pieces; i++)
+        if(squares[i - 1] == squares[i] || (table->slots[i - 1] == table->slots[i] && squares[i - 1] > squares[i])) return false;
+
+    return true;
+
+}
+
+/*!
+ * \brief Gets the entry of the squares of each slot, the side to move then a base 64 digit for each slot
+ * \param table: Table of the entry
+ * \param squares: Square of each slot, pieces of the same type may be in any order
+ * \param isWhite: Side to move
+ * \returns size_t: Entry of the squares
+ */
+static size_t EncodeEntry(const Retrograde* const table, const Index* const squares, const bool isWhite)
+{
+
+    Index sorted[TABLEBASE_MAX_PIECES];
+    size_t index = isWhite; // White is always the first side of a table being generated
+
+    memcpy(sorted, squares, table->pieces * sizeof(Index));
+
+    for(uint8_t i = 1; i < table->pieces; i++)
+        for(uint8_t j = i; j && table->slots[j - 1] == table->slots[j] && sorted[j - 1] > sorted[j]; j--)
+        {
+
+            Index square = sorted[j];
+
+            sorted[j] = sorted[j - 1];
+            sorted[j - 1] = square;
+
+        }
+
+    for(uint8_t i = 0; i < table->pieces; i++) index = index * 64 + sorted[i];
+
+    return index;
+
+}
+
+/*!
+ * \brief Gets the entry of a position of the table, the slots of a piece type taking its squares lowest first
+ * \param table: Table of the position
+ * \param position: Position with the pieces of the table, white being the first side of the name
+ * \returns size_t: Entry of the position
+ */
+static size_t GetPositionEntry(const Retrograde* const table, const Position* const position)
+{
+
+    Index squares[TABLEBASE_MAX_PIECES];
+    Bitboard pieces = 0;
+
+    for(uint8_t i = 0; i < table->pieces; i++)
+    {
+
+        if(!i || table->slots[i - 1] != table->slots[i]) pieces = position->pieces[IsPieceWhite(table->slots[i])][GetPieceType(table->slots[i])];
+
+        squares[i] = FirstSquare(pieces);
+        pieces &= pieces - 1;
+
+    }
+
+    return EncodeEntry(table, squares, position->isWhite);
+
+}
+
+/*!
+ * \brief Gets every entry one move before an entry that stays in the same table, taking back a move of the side that just moved
+ * \details A piece goes back along the squares it attacks, since every move but a pawn's can be played the other way
+ * Captures and promotions come from bigger tables so they are never taken back
+ * The entry is a position without en passant, so a double pawn move that lets the side to move take en passant is left out when the
+ * capture keeps the entry's result from carrying over: when it wins, or when it draws and the entry is lost
+ * \param table: Table of the entry
+ * \param squares: Square of each slot of the entry
+ * \param isWhite: Side to move in the entry
+ * \param pawns: False to leave out pawn moves, which zero the clock
+ * \param lost: True if the side to move loses the entry
+ * \param entries: Filled with the predecessors, some may not be legal positions
+ * \returns uint8_t: Number of predecessors
+ */
+static uint8_t GetPredecessors(Retrograde* const table, const Index* const squares, const bool isWhite, const bool pawns, const bool lost, size_t* const entries)
+{
+
+    Bitboard occupied = 0;
+    Bitboard capturers = 0;
+    uint8_t count = 0;
+
+    for(uint8_t i = 0; i < table->pieces; i++)
+    {
+
+        occupied |= SquareBit(squares[i]);
+
+        if(IsPieceWhite(table->slots[i]) == isWhite && GetPieceType(table->slots[i]) == PawnType) capturers |= SquareBit(squares[i]);
+
+    }
+
+    for(uint8_t i = 0; i < table->pieces; i++)
+    {
+
+        Index square = squares[i];
+        Index moved[TABLEBASE_MAX_PIECES];
+        Index skipped = INDEX_MAX;
+        Bitboard from = 0;
+
+        if(IsPieceWhite(table->slots[i]) == isWhite) continue; // Only the side that just moved can take a move back
+
+        switch(GetPieceType(table->slots[i]))
+        {
+
+            case KnightType: from = GetKnightAttacks(square); break;
+            case BishopType: from = GetBishopAttacks(square, occupied); break;
+            case RookType: from = GetRookAttacks(square, occupied); break;
+            case QueenType: from = GetBishopAttacks(square, occupied) | GetRookAttacks(square, occupied); break;
+            case KingType: from = GetKingAttacks(square); break;
+
+            default: // A pawn steps back towards its own side, two squares if it could have come from its starting row
+
+                if(!pawns) break;
+
+                Index back = isWhite? square + 8: square - 8; // The pawn is black if white is to move
+                uint8_t row = GetRow(square);
+
+                if((isWhite? row > 5: row < 2) || (occupied & SquareBit(back))) break;
+
+                from = SquareBit(back);
+
+                if(row == (isWhite? 4: 3) && !(occupied & SquareBit(isWhite? back + 8: back - 8))) from |= SquareBit(isWhite? back + 8: back - 8);
+
+                if(GetPawnAttacks(!isWhite, back) & capturers) skipped = back; // The double move would allow en passant
+
+                break;
+
+        }
+
+        memcpy(moved, squares, table->pieces * sizeof(Index));
+
+        for(from &= ~occupied; from; from &= from - 1)
+        {
+
+            moved[i] = FirstSquare(from);
+
+            if(skipped < 64 && moved[i] != skipped) // Taking back a double move into a position where en passant was possible
+            {
+
+                Position position[1];
+
+                SetPositionFromPieces(position, table->slots, squares, table->pieces, isWhite);
+                position->enpassant = skipped;
+
+                int8_t capture = ProbeEnPassant(table, position);
+
+                if(capture > 0 || (!capture && lost)) continue;
+
+            }
+
+            entries[count++] = EncodeEntry(table, moved, !isWhite);
+
+        }
+    }
+
+    return count;
+
+}
+
+/*!
+ * \brief Looks up the position after a capture or promotion, which is always in a table with other material
+ * \param table: Table being worked out
+ * \param position: Position after the move
+ * \returns int8_t: Value for the side to move, a draw if only the kings are left or the table is missing
+ */
+static int8_t ProbeSmallerTable(Retrograde* const table, const Position* const position)
+{
+
+    int8_t value = 0;
+
+    if(CountSquares(position->occupancy[WHITE] | position->occupancy[BLACK]) == 2) return 0;
+
+    if(!ProbeTablebase(table->smaller, position, &value)) __atomic_store_n(&table->missing, true, __ATOMIC_RELAXED);
+
+    return value;
+
+}
+
+/*!
+ * \brief Gets what en passant is worth after a double pawn move, the position after it keeps the capture the table entry doesn't have
+ * \param table: Table being worked out
+ * \param position: Position after the double move, its en passant square set
+ * \returns int8_t: 1 if the best en passant capture wins for the side to move, 0 if it draws and -1 if it loses or there is none
+ */
+static int8_t ProbeEnPassant(Retrograde* const table, Position* const position)
+{
+
+    PositionMoveList list[1];
+    PositionUndo undo;
+    int8_t best = -1;
+
+    if(position->enpassant >= 64) return -1;
+
+    GenerateLegalMoves(position, list);
+
+    for(size_t i = 0; i < list->size && best < 1; i++)
+    {
+
+        Move move = list->move[i];
+
+        if(move.end != position->enpassant || GetPieceType(move.piece) != PawnType) continue;
+
+        MakePositionMove(position, move, &undo);
+
+        int8_t value = -TablebaseWDL(ProbeSmallerTable(table, position));
+
+        UnmakePositionMove(position, move, &undo);
+
+        if(value > best) best = value;
+
+    }
+
+    return best;
+
+}
+
+/*!
+ * \brief Marks whether an entry is a legal position and decides it if a capture or promotion wins, or if it has no moves
+ * \details Counts the moves that stay in the table plus one if some capture or promotion holds a draw, so the entry is only lost once
+ * every one of them is known to lose, a double pawn move the opponent wins by taking en passant already is
+ * \param table: Table being worked out
+ * \param index: Entry to look at
+ * \returns bool: True if the entry was decided
+ */
+static bool SetupEntry(Retrograde* const table, const size_t index)
+{
+
+    Index squares[TABLEBASE_MAX_PIECES];
+    Position position[1];
+    PositionMoveList list[1];
+    PositionUndo undo;
+    uint8_t moves = 0;
+    bool escape = false;
+    bool won = false;
+
+    if(!DecodeEntry(table, index, squares) || !SetPositionFromPieces(position, table->slots, squares, table->pieces, index >> (6 * table->pieces)))
+        return false;
+
+    MarkEntry(table->valid, index);
+    GenerateLegalMoves(position, list);
+
+    for(size_t i = 0; i < list->size && !won; i++)
+    {
+
+        MakePositionMove(position, list->move[i], &undo);
+
+        if(CountSquares(position->occupancy[WHITE] | position->occupancy[BLACK]) == table->pieces && !list->move[i].promotion)
+            moves += ProbeEnPassant(table, position) < 1;
+
+        else
+        {
+
+            int8_t value = ProbeSmallerTable(table, position);
+
+            won = value < 0;
+            escape |= !value;
+
+        }
+
+        UnmakePositionMove(position, list->move[i], &undo);
+
+    }
+
+    if(won)
+    {
+
+        MarkEntry(table->wins, index);
+        MarkEntry(table->frontier, index);
+
+        return true;
+
+    }
+
+    table->moves[index] = moves + escape;
+
+    if(moves + escape || (!list->size && !IsPositionInCheck(position))) return false; // Still open, or stalemate
+
+    MarkEntry(table->losses, index);
+    MarkEntry(table->frontier, index);
+
+    return true;
+
+}
+
+/*!
+ * \brief Spreads the result of a frontier entry to the entries one move before it
+ * \details A predecessor of a loss is won, a predecessor of a win has one less move that might save it and is lost when none are left
+ * \param table: Table being worked out
+ * \param index: Entry to look at, skipped unless it is on the frontier
+ * \returns size_t: Entries decided
+ */
+static size_t SpreadResult(Retrograde* const table, const size_t index)
+{
+
+    Index squares[TABLEBASE_MAX_PIECES];
+    size_t entries[RETROGRADE_MAX_PREDECESSORS];
+    size_t changed = 0;
+
+    if(!TestEntry(table->frontier, index)) return 0;
+
+    bool lost = TestEntry(table->losses, index);
+    uint8_t count = DecodeEntry(table, index, squares)? GetPredecessors(table, squares, index >> (6 * table->pieces), true, lost, entries): 0;
+
+    for(uint8_t i = 0; i < count; i++)
+    {
+
+        size_t entry = entries[i];
+
+        if(!TestEntry(table->valid, entry) || TestEntry(table->wins, entry) || TestEntry(table->losses, entry)) continue;
+
+        if(lost)
+        {
+
+            MarkEntry(table->wins, entry);
+            MarkEntry(table->next, entry);
+            changed++;
+
+        }
+
+        else if(!__atomic_sub_fetch(&table->moves[entry], 1, __ATOMIC_RELAXED))
+        {
+
+            MarkEntry(table->losses, entry);
+            MarkEntry(table->next, entry);
+            changed++;
+
+        }
+    }
+
+    return changed;
+
+}
+
+/*!
+ * \brief Sets the distance of the entries a capture or pawn move decides right away and counts the quiet moves of the rest
+ * \details A mate is a loss in zero, a win by a capture or pawn move is one ply from zeroing and so is a loss where every move zeroes
+ * Draws get zero and every other decided entry is left pending
+ * \param table: Table with its results known
+ * \param index: Entry to look at
+ * \returns bool: True if a decided entry got its distance
+ */
+static bool SetupDistance(Retrograde* const table, const size_t index)
+{
+
+    Index squares[TABLEBASE_MAX_PIECES];
+    Position position[1];
+    PositionMoveList list[1];
+    PositionUndo undo;
+    bool won = TestEntry(table->wins, index);
+    bool zeroing = false;
+    uint8_t quiet = 0;
+
+    table->values[index] = 0;
+
+    if(!won && !TestEntry(table->losses, index)) return false;
+
+    DecodeEntry(table, index, squares);
+    SetPositionFromPieces(position, table->slots, squares, table->pieces, index >> (6 * table->pieces));
+    GenerateLegalMoves(position, list);
+
+    for(size_t i = 0; i < list->size; i++)
+    {
+
+        Move move = list->move[i];
+
+        if(!IsCaptureMove(position, move) && GetPieceType(move.piece) != PawnType)
+        {
+
+            quiet++;
+            continue;
+
+        }
+
+        if(!won || zeroing) continue;
+
+        MakePositionMove(position, move, &undo);
+
+        if(CountSquares(position->occupancy[WHITE] | position->occupancy[BLACK]) == table->pieces && !move.promotion)
+            zeroing = TestEntry(table->losses, GetPositionEntry(table, position)) && ProbeEnPassant(table, position) < 0;
+
+        else zeroing = ProbeSmallerTable(table, position) < 0;
+
+        UnmakePositionMove(position, move, &undo);
+
+    }
+
+    table->quiet[index] = quiet;
+
+    if(!list->size) table->values[index] = -1;
+    else if(won && zeroing) table->values[index] = 2;
+    else if(!won && !quiet) table->values[index] = -2;
+    else table->values[index] = RETROGRADE_PENDING;
+
+    return table->values[index] != RETROGRADE_PENDING;
+
+}
+
+/*!
+ * \brief Spreads the distance of an entry to the entries one quiet move before it
+ * \details A pending win before a loss at this level wins one ply further, a pending loss before a win has one less quiet move to wait for
+ * and once it has none left its longest defence is one ply further than this level
+ * \param table: Table with its results known
+ * \param index: Entry to look at, skipped unless its distance is the level
+ * \param level: Distance being spread
+ * \returns size_t: Entries that got their distance
+ */
+static size_t SpreadDistance(Retrograde* const table, const size_t index, const uint8_t level)
+{
+
+    Index squares[TABLEBASE_MAX_PIECES];
+    size_t entries[RETROGRADE_MAX_PREDECESSORS];
+    int8_t value = __atomic_load_n(&table->values[index], __ATOMIC_RELAXED);
+    int8_t distance = (level + 2 < INT8_MAX)? level + 2: INT8_MAX;
+    size_t changed = 0;
+
+    if(value == RETROGRADE_PENDING || !value || abs(value) - 1 != level) return 0;
+
+    DecodeEntry(table, index, squares);
+
+    uint8_t count = GetPredecessors(table, squares, index >> (6 * table->pieces), false, value < 0, entries);
+
+    for(uint8_t i = 0; i < count; i++)
+    {
+
+        size_t entry = entries[i];
+        int8_t pending = RETROGRADE_PENDING;
+
+        if(__atomic_load_n(&table->values[entry], __ATOMIC_RELAXED) != RETROGRADE_PENDING) continue;
+
+        if(value < 0 && TestEntry(table->wins, entry))
+            changed += __atomic_compare_exchange_n(&table->values[entry], &pending, distance, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+
+        else if(value > 0 && TestEntry(table->losses, entry) && !__atomic_sub_fetch(&table->quiet[entry], 1, __ATOMIC_RELAXED))
+        {
+
+            __atomic_store_n(&table->values[entry], -distance, __ATOMIC_RELAXED);
+            changed++;
+
+        }
+    }
+
+    return changed;
+
+}
+
+/*!
+ * \brief Runs a pass over a share of the entries
+ * \param task: RetrogradeTask to work through
+ * \returns void*: NULL
+ */
+static void* RetrogradeWorker(void* task)
+{
+
+    RetrogradeTask* share = task;
+    Retrograde* table = share->table;
+
+    share->changed = 0;
+
+    for(size_t index = share->start; index < share->end; index++)
+    {
+
+        Bitboard* skip = (share->pass == PassResults)? table->frontier: (share->pass == PassDistances)? table->next: NULL;
+
+        if(skip && !(index & 63) && !skip[index >> 6]) // Nothing to do for the next 64 entries
+        {
+
+            index += 63;
+            continue;
+
+        }
+
+        switch(share->pass)
+        {
+
+            case PassSetup: share->changed += SetupEntry(table, index); break;
+            case PassResults: share->changed += SpreadResult(table, index); break;
+            case PassZeroing: share->changed += SetupDistance(table, index); break;
+            case PassDistances: share->changed += SpreadDistance(table, index, share->level); break;
+
+        }
+    }
+
+    return NULL;
+
+}
+
+/*!
+ * \brief Runs a pass over every entry, split between the threads
+ * \details Every share but the first goes to a worker of the shared thread pool, the first runs here
+ * \param table: Table being worked out
+ * \param threads: Threads to use, the pool has a worker for each but one
+ * \param pass: Pass to run
+ * \param level: Distance being spread by PassDistances
+ * \returns size_t: Entries the pass decided
+ */
+static size_t RunRetrogradePass(Retrograde* const table, const uint8_t threads, const RetrogradePass pass, const uint8_t level)
+{
+
+    ThreadPool* pool = GetThreadPool();
+    RetrogradeTask shares[POOL_MAX_WORKERS];
+    Task tasks[POOL_MAX_WORKERS];
+    size_t words = table->size / 64;
+    size_t changed = 0;
+
+    for(uint8_t i = 0; i < threads; i++)
+    {
+
+        shares[i] = (RetrogradeTask){table, pass, level, words * i / threads * 64, words * (i + 1) / threads * 64, 0};
+
+        if(i) SubmitTask(pool, &tasks[i], RetrogradeWorker, &shares[i]);
+
+    }
+
+    RetrogradeWorker(&shares[0]);
+
+    for(uint8_t i = 1; i < threads; i++)
+        WaitTask(pool, &tasks[i]);
+
+    for(uint8_t i = 0; i < threads; i++) changed += shares[i].changed;
+
+    return changed;
+
+}
+
+/*!
+ * \brief Frees the arrays and smaller tables of a table
+ * \param table: Table to free
+ */
+static void FreeRetrograde(Retrograde* const table)
+{
+
+    free(table->valid);
+    free(table->wins);
+    free(table->losses);
+    free(table->frontier);
+    free(table->next);
+    free(table->moves);
+    free(table->quiet);
+    free(table->values);
+
+    DeleteTablebase(table->smaller);
+
+}
+
+/*!
+ * \brief Writes one file of a finished table, the magic, version and pieces then the entries
+ * \param path: Path of the file
+ * \param magic: Magic of the file
+ * \param pieces: Pieces of the table
+ * \param data: Entries to write
+ * \param size: Bytes of entries
+ * \returns bool: True if the whole file was written, a file that wasn't is removed
+ */
+static bool WriteTableFile(const char* const path, const char* const magic, const uint8_t pieces, const uint8_t* const data, const size_t size)
+{
+
+    FILE* file = fopen(path, "wb");
+    uint32_t header[2] = {TABLEBASE_VERSION, pieces};
+    bool written;
+
+    if(!file) return false;
+
+    written = fwrite(magic, 1, 4, file) == 4 && fwrite(header, sizeof(uint32_t), 2, file) == 2 && fwrite(data, 1, size, file) == size;
+    written &= !fclose(file);
+
+    if(!written) remove(path); // Never leave a broken table for CreateTablebase to find
+
+    return written;
+
+}
+
+/*!
+ * \brief Writes the result and distance files of a finished table
+ * \details Goes over the entries of the files, which fold the symmetries and like pieces together, and reads each one's value
+ * from the entry of its position in the table. The distance file goes first so a result file is only there once both are
+ * \param table: Finished table
+ * \param material: Counts of each piece type of each side
+ * \param directory: Directory of the tables
+ * \returns bool: True if both files were written
+ */
+static bool WriteTablebase(const Retrograde* const table, const uint8_t material[2][6], const char* const directory)
+{
+
+    char path[SETTINGS_PATH_MAX + TABLEBASE_NAME_MAX];
+    uint64_t key = 0;
+    Position position[1];
+
+    for(uint8_t side = 0; side < 2; side++)
+        for(PieceType type = PawnType; type < NoType; type++) key |= (uint64_t)material[side][type] << (4 * (side * 6 + type));
+
+    size_t entries = GetTablebaseEntries(key);
+    uint8_t* results = calloc((entries + 3) / 4, sizeof(uint8_t));
+    uint8_t* distances = calloc(entries, sizeof(uint8_t));
+    bool written = results && distances;
+
+    for(size_t index = 0; written && index < entries; index++)
+    {
+
+        size_t entry = SetTablebasePosition(position, key, index)? GetPositionEntry(table, position): table->size;
+        uint8_t result = TABLEBASE_BROKEN;
+
+        if(entry < table->size && TestEntry(table->valid, entry))
+        {
+
+            int8_t value = table->values[entry];
+
+            result = (value > 0)? TABLEBASE_WIN: (value < 0)? TABLEBASE_LOSS: TABLEBASE_DRAW;
+            distances[index] = value? (uint8_t)TablebaseDTZ(value): 0;
+
+        }
+
+        results[index >> 2] |= result << ((index & 3) * 2);
+
+    }
+
+    snprintf(path, sizeof(path), "%s/%s%s", directory, table->name, TABLEBASE_DTZ_EXTENSION);
+    written = written && WriteTableFile(path, TABLEBASE_DTZ_MAGIC, table->pieces, distances, entries);
+
+    snprintf(path, sizeof(path), "%s/%s%s", directory, table->name, TABLEBASE_EXTENSION);
+    written = written && WriteTableFile(path, TABLEBASE_MAGIC, table->pieces, results, (entries + 3) / 4);
+
+    free(results);
+    free(distances);
+
+    return written;
+
+}
+
+/*!
+ * \brief Prints the wins, draws and losses of each side to move and the longest distance, to check against known statistics
+ * \param table: Finished table
+ * \param report: Where to print, NULL for nowhere
+ * \param seconds: Time the table took
+ */
+static void ReportRetrograde(const Retrograde* const table, FILE* const report, const double seconds)
+{
+
+    size_t counts[2][3] = {{0}}; // Indexed by side to move then loss, draw and win
+    int32_t longest = 0;
+
+    if(!report) return;
+
+    for(size_t index = 0; index < table->size; index++)
+    {
+
+        if(!TestEntry(table->valid, index)) continue;
+
+        counts[index >> (6 * table->pieces)][TablebaseWDL(table->values[index]) + 1]++;
+
+        if(table->values[index] && TablebaseDTZ(table->values[index]) > longest) longest = TablebaseDTZ(table->values[index]);
+
+    }
+
+    fprintf(report, "%s: white to move %zu won %zu drawn %zu lost, black to move %zu won %zu drawn %zu lost, longest %d plies to zeroing, %.1f seconds\n",
+        table->name, counts[1][2], counts[1][1], counts[1][0], counts[0][2], counts[0][1], counts[0][0], longest, seconds);
+
+}
+
+/*!
+ * \brief Generates the table of a material into a directory, first generating every table its captures and promotions lead to
+ * \details Works out the results first, spreading wins and losses back a move at a time from the mates and the captures and promotions
+ * the smaller tables decide, then works out the distances to zeroing the same way from the entries a capture or pawn move decides
+ * A table that is already in the directory is left as it is
+ * \param directory: Directory of the tables
+ * \param material: Counts of each piece type of each side
+ * \param threads: Threads to use
+ * \param report: Where to print each table as it is finished, NULL for nowhere
+ * \returns bool: True if the table and every table it needs are in the directory
+ */
+static bool BuildTablebase(const char* const directory, const uint8_t material[2][6], const uint8_t threads, FILE* const report)
+{
+
+    Retrograde table = {0};
+    uint8_t counts[2][6];
+    char path[SETTINGS_PATH_MAX + TABLEBASE_NAME_MAX];
+    struct timespec start;
+    struct timespec end;
+    bool built = false;
+
+    memcpy(counts, material, sizeof(counts));
+    NameMaterial(counts, table.name);
+
+    for(uint8_t side = 0; side < 2; side++)
+        for(uint8_t i = 0; i < 6; i++)
+            for(uint8_t n = 0; n < counts[side][TypeOrder[i]]; n++)
+                table.slots[table.pieces++] = CreatePiece(!side, GetTypeID(TypeOrder[i]), 0);
+
+    snprintf(path, sizeof(path), "%s/%s%s", directory, table.name, TABLEBASE_EXTENSION);
+
+    if(table.pieces < RETROGRADE_MIN_PIECES || !access(path, F_OK)) return true;
+
+    for(uint8_t side = 0; side < 2; side++) // Every capture and promotion leads to a smaller table that has to be there first
+        for(PieceType type = PawnType; type < KingType; type++)
+        {
+
+            uint8_t smaller[2][6];
+
+            if(!counts[side][type]) continue;
+
+            memcpy(smaller, counts, sizeof(smaller));
+            smaller[side][type]--;
+
+            if(!BuildTablebase(directory, (const uint8_t(*)[6])smaller, threads, report)) return false;
+
+            for(PieceType promotion = KnightType; type == PawnType && promotion < KingType; promotion++)
+            {
+
+                smaller[side][promotion]++;
+
+                if(!BuildTablebase(directory, (const uint8_t(*)[6])smaller, threads, report)) return false;
+
+                smaller[side][promotion]--;
+
+            }
+        }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    table.size = (size_t)2 << (6 * table.pieces);
+    table.smaller = CreateTablebase(directory);
+    table.valid = calloc(table.size / 64, sizeof(Bitboard));
+    table.wins = calloc(table.size / 64, sizeof(Bitboard));
+    table.losses = calloc(table.size / 64, sizeof(Bitboard));
+    table.frontier = calloc(table.size / 64, sizeof(Bitboard));
+    table.next = calloc(table.size / 64, sizeof(Bitboard));
+    table.moves = calloc(table.size, sizeof(uint8_t));
+    table.quiet = calloc(table.size, sizeof(uint8_t));
+    table.values = calloc(table.size, sizeof(int8_t));
+
+    if(!table.valid || !table.wins || !table.losses || !table.frontier || !table.next || !table.moves || !table.quiet || !table.values)
+    {
+
+        FreeRetrograde(&table);
+        return false;
+
+    }
+
+    RunRetrogradePass(&table, threads, PassSetup, 0);
+
+    while(RunRetrogradePass(&table, threads, PassResults, 0)) // Until a pass decides nothing new
+    {
+
+        Bitboard* frontier = table.frontier;
+
+        table.frontier = table.next;
+        table.next = frontier;
+
+        memset(table.next, 0, table.size / 8);
+
+    }
+
+    for(size_t word = 0; word < table.size / 64; word++) table.next[word] = table.wins[word] | table.losses[word]; // Only these have distances
+
+    RunRetrogradePass(&table, threads, PassZeroing, 0);
+
+    for(uint8_t level = 0; level < RETROGRADE_DTZ_MAX; level++) // Mates are at zero and the rest of the seeds at one, so a quiet level after that is the end
+        if(!RunRetrogradePass(&table, threads, PassDistances, level) && level) break;
+
+    for(size_t index = 0; index < table.size; index++) // Anything still pending is further than a value can say
+        if(table.values[index] == RETROGRADE_PENDING) table.values[index] = TestEntry(table.wins, index)? INT8_MAX: -INT8_MAX;
+
+    if(table.missing) fprintf(stderr, "%s needs a table that isn't in %s\n", table.name, directory);
+
+    else built = WriteTablebase(&table, (const uint8_t(*)[6])counts, directory);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if(built) ReportRetrograde(&table, report, (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+
+    FreeRetrograde(&table);
+
+    return built;
+
+}
+
+/*!
+ * \brief Grows the shared thread pool to one worker for every thread of a generation but the one that runs it
+ * \param threads: Threads wanted, zero for one per processor
+ * \returns uint8_t: Threads the passes can use, fewer if the pool couldn't grow
+ */
+static uint8_t ReserveRetrogradeThreads(const uint8_t threads)
+{
+
+    uint8_t count = threads? threads: GetOnlineProcessors();
+
+    if(count > POOL_MAX_WORKERS) count = POOL_MAX_WORKERS;
+
+    if(count > 1) // The thread running the generation takes the first share
+    {
+
+        uint8_t reserved = ReserveWorkers(GetThreadPool(), count - 1);
+
+        if(reserved < count - 1) count = reserved + 1;
+
+    }
+
+    return count;
+
+}
+
+/*!
+ * \brief Generates the table of a material, and every smaller table it needs, into a directory
+ * \param directory: Directory to write to, created if it isn't there
+ * \param material: Name of the material like KQvKR, the side before the v is white
+ * \param threads: Threads to use, zero for one per processor
+ * \param report: Where to print each table as it is finished, NULL for nowhere
+ * \returns bool: True if every table was generated or already there
+ */
+bool GenerateTablebase(const char* const directory, const char* const material, const uint8_t threads, FILE* const report)
+{
+
+    STATIC_ASSERT(directory, "Invalid Directory Pointer");
+    STATIC_ASSERT(material, "Invalid Material Pointer");
+
+    uint8_t counts[2][6];
+
+    if(!ParseMaterialName(material, counts)) return false;
+
+    mkdir(directory, 0777); // Fails harmlessly if it is already there
+
+    return BuildTablebase(directory, (const uint8_t(*)[6])counts, ReserveRetrogradeThreads(threads), report);
+
+}
+
+/*!
+ * \brief Hands out the rest of the pieces of a material, one piece type and side at a time so each material comes up once
+ * \param directory: Directory of the tables
+ * \param counts: Pieces handed out so far
+ * \param first: First of the ten choices of side and type that may still be used
+ * \param left: Pieces still to hand out
+ * \param threads: Threads to use
+ * \param report: Where to print each table as it is finished
+ * \returns bool: True if every table was generated or already there
+ */
+static bool BuildMaterials(const char* const directory, uint8_t counts[2][6], const uint8_t first, const uint8_t left, const uint8_t threads, FILE* const report)
+{
+
+    if(!left) return BuildTablebase(directory, (const uint8_t(*)[6])counts, threads, report);
+
+    for(uint8_t choice = first; choice < 10; choice++) // Each side can get a queen, rook, bishop, knight or pawn
+    {
+
+        bool built;
+
+        counts[choice / 5][choice % 5]++;
+        built = BuildMaterials(directory, counts, choice, left - 1, threads, report);
+        counts[choice / 5][choice % 5]--;
+
+        if(!built) return false;
+
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief Generates every table with the given number of pieces, kings included, along with the smaller tables they need
+ * \param directory: Directory to write to, created if it isn't there
+ * \param pieces: Pieces of each table, from RETROGRADE_MIN_PIECES to TABLEBASE_MAX_PIECES
+ * \param threads: Threads to use, zero for one per processor
+ * \param report: Where to print each table as it is finished, NULL for nowhere
+ * \returns bool: True if every table was generated or already there
+ */
+bool GenerateTablebases(const char* const directory, const uint8_t pieces, const uint8_t threads, FILE* const report)
+{
+
+    STATIC_ASSERT(directory, "Invalid Directory Pointer");
+
+    uint8_t counts[2][6] = {{0, 0, 0, 0, 0, 1}, {0, 0, 0, 0, 0, 1}};
+
+    if(pieces < RETROGRADE_MIN_PIECES || pieces > TABLEBASE_MAX_PIECES) return false;
+
+    mkdir(directory, 0777); // Fails harmlessly if it is already there
+
+    return BuildMaterials(directory, counts, 0, pieces - 2, ReserveRetrogradeThreads(threads), report);
+
+}
+
+// EOF //
@@ -0,0 +1,964 @@
+/*!
+ * \file Search.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the Search Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#define _POSIX_C_SOURCE 200809L // clock_gettime isn't part of plain C99
+
+#include "Search.h"
+#include "AIGameplay.h"
+#include <time.h>
+
+// ------------------------- Macros ------------------------- //
+
+#ifdef SEARCH_STATS
+
+/// Adds to a counter of the search statistics
+#define CountStat(search, counter, amount) ((search)->stats.counter += (amount))
+
+#else
+
+/// Counting is compiled out without SEARCH_STATS
+#define CountStat(search, counter, amount) ((void)0)
+
+#endif
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief One thread of a search
+ * \details Every thread searches the same root with its own SearchData, only the table and the halt flag are shared
+ */
+typedef struct
+{
+
+    const Position* position;    ///< Root position
+    SearchLimits limits;         ///< Budget of the whole search
+    TranspositionTable* table;   ///< Shared table, NULL for none
+
+    uint8_t id;                  ///< Index of the thread, 0 is the main thread
+    bool* halt;                  ///< Set by the main thread when the helpers have to stop
+    uint64_t start;              ///< Monotonic time the search started
+
+    SearchResult result;         ///< Last finished iteration of this thread
+
+} SearchThread;
+
+// ------------------------- Tables ------------------------- //
+
+/// How many depths in a row each helper searches or skips
+static const uint8_t SkipSize[20] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+
+/// Where each helper starts in its pattern of searched and skipped depths
+static const uint8_t SkipPhase[20] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+// ------------------------- Functions ------------------------- //
+
+/// Gets the time of a clock that never jumps in nanoseconds
+static uint64_t GetMonotonicTime();
+
+/// Checks if the search has reached one of its limits
+static inline bool IsOutOfBudget(SearchData* const search);
+
+/// Converts a score to be stored in the table
+static inline int32_t ScoreToTable(const int32_t score, const uint8_t ply);
+
+/// Converts a score read from the table
+static inline int32_t ScoreFromTable(const int32_t score, const uint8_t ply);
+
+/// Adds the counters of a helper thread to the totals
+static void AddSearchStats(SearchStats* const total, const SearchStats* const stats);
+
+/// Runs iterative deepening on one thread of the search
+static void IterativeDeepening(SearchThread* const thread);
+
+/// Task run by the helper threads
+static void* SearchHelper(void* thread);
+
+/// Checks if a root move is left out of the search
+static inline bool IsExcludedMove(const SearchData* const search, const Move move);
+
+/// Evaluates the position at a ply with the network or the hand written evaluation
+static inline int32_t GetStaticEval(SearchData* const search, const uint8_t ply);
+
+/// Plays a move and keeps the accumulators up to date
+static inline void MakeSearchMove(SearchData* const search, const Move move, PositionUndo* const undo, const uint8_t ply);
+
+/// Searches captures and promotions until the position is quiet
+static int32_t Quiescence(SearchData* const search, int32_t alpha, const int32_t beta, const uint8_t ply);
+
+/// Alpha beta search of the position in negamax form
+static int32_t Negamax(SearchData* const search, uint8_t depth, int32_t alpha, const int32_t beta, const uint8_t ply);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Gets the monotonic time, unlike the wall clock it can't go backwards
+ * \returns uint64_t: Nanoseconds since an arbitrary start
+ */
+static uint64_t GetMonotonicTime()
+{
+
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+
+}
+
+/*!
+ * \brief Checks the node and time limits, the clock is only read every SEARCH_CHECK_NODES nodes
+ * \param search: Search state, stopped is set once a limit is hit
+ * \returns bool: True if the search has to stop
+ */
+static inline bool IsOutOfBudget(SearchData* const search)
+{
+
+    if(search->stopped) return true;
+
+    if(__atomic_load_n(search->halt, __ATOMIC_RELAXED)) search->stopped = true; // The main thread is done
+
+    else if(search->stop && __atomic_load_n(search->stop, __ATOMIC_RELAXED)) search->stopped = true; // Whoever started the search is done with it
+
+    else if(search->maxnodes && search->nodes >= search->maxnodes) search->stopped = true;
+
+    else if(search->deadline && !(search->nodes & (SEARCH_CHECK_NODES - 1)) && GetMonotonicTime() >= search->deadline)
+        search->stopped = true;
+
+    return search->stopped;
+
+}
+
+/*!
+ * \brief Makes mate scores relative to the position instead of the root so they can be used from any ply
+ * \param score: Score from the search
+ * \param ply: Distance from the root
+ * \returns int32_t: Score to store
+ */
+static inline int32_t ScoreToTable(const int32_t score, const uint8_t ply)
+{
+
+    if(score >= MATE_BOUND) return score + ply;
+    if(score <= -MATE_BOUND) return score - ply;
+
+    return score;
+
+}
+
+/*!
+ * \brief Makes a stored mate score relative to the root again
+ * \param score: Score from the table
+ * \param ply: Distance from the root
+ * \returns int32_t: Score for the search
+ */
+static inline int32_t ScoreFromTable(const int32_t score, const uint8_t ply)
+{
+
+    if(score >= MATE_BOUND) return score - ply;
+    if(score <= -MATE_BOUND) return score + ply;
+
+    return score;
+
+}
+
+/*!
+ * \brief Gets the static evaluation of the current position
+ * \param search: Search state, the accumulator of the ply has to be up to date
+ * \param ply: Distance from the root
+ * \returns int32_t: Score for the side to move in centipawns, moved by up to the noise of the search
+ */
+static inline int32_t GetStaticEval(SearchData* const search, const uint8_t ply)
+{
+
+    int32_t eval = search->network? EvaluateNetwork(search->network, &search->accumulators[ply], search->position->isWhite): EvaluatePosition(search->position);
+
+    if(search->noise) // Hashed from the position so every thread and every visit sees the same score
+    {
+
+        uint64_t mixed = (search->seed ^ search->position->key) * 0x9E3779B97F4A7C15ull;
+
+        eval += (int32_t)((mixed >> 32) % (uint64_t)(2 * search->noise + 1)) - search->noise;
+
+    }
+
+    return eval;
+
+}
+
+/*!
+ * \brief Checks if the position at a ply repeats one before it, in the line searched or in the game before the root
+ * \details Only positions since the last capture or pawn move can repeat, and nothing is looked at past a null move since
+ * passing isn't a move that was really played. One repeat is enough, a line that can repeat once can repeat again
+ * \param search: Search state
+ * \param ply: Ply of the position
+ * \returns bool: True if the position came up before with the same side to move
+ */
+static inline bool IsRepetition(const SearchData* const search, const uint8_t ply)
+{
+
+    const Position* position = search->position;
+    uint16_t current = search->rootkey + ply;
+    uint16_t reach = (position->halfmove < current)? position->halfmove: current;
+
+    for(uint16_t back = 1; back <= reach; back++)
+    {
+
+        if(back <= ply && search->played[ply - back].piece == EMPTY) return false; // A null move, what came before never led here
+
+        if(back >= 4 && !(back & 1) && search->keys[current - back] == position->key) return true;
+
+    }
+
+    return false;
+
+}
+
+/*!
+ * \brief Plays a move on the searched position
+ * \details The accumulator of the next ply is built from this ply's, taking the move back needs nothing since the old one is still there
+ * \param search: Search state
+ * \param move: Pseudo legal move to play
+ * \param undo: Filled with what is needed to take the move back
+ * \param ply: Ply the move is played at
+ */
+static inline void MakeSearchMove(SearchData* const search, const Move move, PositionUndo* const undo, const uint8_t ply)
+{
+
+    MakePositionMove(search->position, move, undo);
+
+    if(ply + 1 < MAX_PLY) search->keys[search->rootkey + ply + 1] = search->position->key;
+
+    if(search->network && ply + 1 < MAX_PLY)
+        UpdateAccumulator(search->network, search->position, move, undo, &search->accumulators[ply], &search->accumulators[ply + 1]);
+
+}
+
+/*!
+ * \brief Searches only the moves that change the material so the evaluation is never taken in the middle of a capture sequence
+ * \details The side to move can stand pat on the evaluation instead of capturing, captures that can't raise alpha even
+ * with DELTA_MARGIN to spare or that lose the exchange are skipped and a side in check searches every move since standing pat isn't an option
+ * \param search: Search state, the position is left as it was
+ * \param alpha: Score the side to move is already sure of
+ * \param beta: Score the opponent will not allow
+ * \param ply: Distance from the root
+ * \returns int32_t: Score of the position for the side to move
+ */
+static int32_t Quiescence(SearchData* const search, int32_t alpha, const int32_t beta, const uint8_t ply)
+{
+
+    Position* position = search->position;
+
+    search->nodes++;
+    search->qnodes++;
+
+    if(ply > search->stats.seldepth) search->stats.seldepth = ply; // Cheap enough to keep without SEARCH_STATS
+    search->pvlength[ply] = ply; // Captures at the horizon aren't part of the line
+
+    if(search->stoppable && IsOutOfBudget(search)) return 0; // The score is thrown away
+
+    if(ply >= MAX_PLY - 1) return GetStaticEval(search, ply);
+
+    PositionMoveList list[1];
+    PositionUndo undo;
+
+    bool check = IsPositionInCheck(position);
+    int32_t standpat = check? -INFINITE_SCORE: GetStaticEval(search, ply);
+    int32_t best = standpat;
+    uint8_t legal = 0;
+
+    if(standpat >= beta) return standpat; // Already good enough without capturing
+
+    if(standpat > alpha) alpha = standpat;
+
+    if(check) GeneratePseudoMoves(position, list); // Every evasion
+    else GenerateTacticalMoves(position, list);
+
+    Move none = CreateMove(EMPTY, INDEX_MAX, INDEX_MAX);
+
+    ScoreMoves(&search->order, position, list, none, ply? search->played[ply - 1]: none, ply);
+
+    for(size_t i = 0; i < list->size; i++)
+    {
+
+        Move move = PickMove(list, i);
+
+        if(!check && !move.promotion) // Delta pruning and captures that lose the exchange
+        {
+
+            Piece victim = position->grid[move.end];
+            int32_t gain = victim? (int32_t)GetPieceValue(victim): PAWNVAL; // Empty is en passant
+
+            if(standpat + gain + DELTA_MARGIN <= alpha) continue;
+
+            if(list->score[i] < ORDER_CAPTURE_SCORE && StaticExchangeEval(position, move) < 0) continue; // Only losing captures are scored lower
+
+        }
+
+        MakeSearchMove(search, move, &undo, ply);
+
+        if(IsSquareAttacked(position, GetPositionKing(position, !position->isWhite), position->isWhite)) // Left the king in check
+        {
+
+            UnmakePositionMove(position, move, &undo);
+            continue;
+
+        }
+
+        legal++;
+        search->played[ply] = move;
+
+        int32_t score = -Quiescence(search, -beta, -alpha, ply + 1);
+
+        UnmakePositionMove(position, move, &undo);
+
+        if(search->stopped) return 0; // Don't trust anything from an unfinished subtree
+
+        if(score > best) best = score;
+
+        if(score > alpha)
+        {
+
+            alpha = score;
+
+            if(alpha >= beta) break; // The opponent won't allow this capture
+
+        }
+    }
+
+    if(check && !legal) return -MATE_SCORE + ply; // Checkmate
+
+    return best;
+
+}
+
+/*!
+ * \brief Searches the position with alpha beta pruning
+ * \param search: Search state, the position is left as it was
+ * \param depth: Plies left to search
+ * \param alpha: Score the side to move is already sure of
+ * \param beta: Score the opponent will not allow
+ * \param ply: Distance from the root
+ * \returns int32_t: Score of the position for the side to move
+ */
+static int32_t Negamax(SearchData* const search, uint8_t depth, int32_t alpha, const int32_t beta, const uint8_t ply)
+{
+
+    Position* position = search->position;
+
+    if(!depth) return Quiescence(search, alpha, beta, ply); // Horizon
+
+    search->nodes++;
+    search->pvlength[ply] = ply;
+
+    if(ply > search->stats.seldepth) search->stats.seldepth = ply; // Cheap enough to keep without SEARCH_STATS
+
+    if(search->stoppable && IsOutOfBudget(search)) return 0; // The score is thrown away
+
+    if(ply && position->halfmove >= 100) return 0; // Fifty move rule
+
+    if(ply && IsRepetition(search, ply)) return 0; // Repeating a position is a draw
+
+    if(ply >= MAX_PLY - 1) return GetStaticEval(search, ply);
+
+    PositionMoveList list[1];
+    PositionUndo undo;
+    TableEntry entry;
+    int8_t value;
+
+    bool check = IsPositionInCheck(position);
+    bool pvnode = beta - alpha > 1;
+    bool futile = false;
+    int32_t best = -INFINITE_SCORE;
+    int32_t start = alpha;
+    Move bestmove = CreateMove(EMPTY, INDEX_MAX, INDEX_MAX);
+    Move hashmove = bestmove;
+    Move previous = ply? search->played[ply - 1]: bestmove;
+    Move quiets[MAX_MOVES];
+    size_t quietcount = 0;
+    uint8_t legal = 0;
+
+    if(ply && ProbeTablebase(search->tablebase, position, &value)) // The outcome is known, nothing below can change it
+    {
+
+        search->tbhits++;
+
+        return TablebaseWDL(value) * (TABLEBASE_SCORE - ply);
+
+    }
+
+    if(search->table && ProbeTable(search->table, position->key, &entry, &search->tablestats))
+    {
+
+        int32_t score = ScoreFromTable(entry.score, ply);
+
+        hashmove = entry.move;
+
+        if(ply && entry.depth >= depth && (entry.bound == BoundExact || (entry.bound == BoundLower && score >= beta) || (entry.bound == BoundUpper && score <= alpha)))
+            return score; // Already searched deep enough, not at the root so there is always a move to play
+
+    }
+
+    if(ply && !pvnode && !check && (search->pruning & (PRUNE_NULL_MOVE | PRUNE_FUTILITY | PRUNE_RAZORING))) // Only null window nodes are pruned
+    {
+
+        int32_t eval = GetStaticEval(search, ply);
+
+        if((search->pruning & PRUNE_RAZORING) && depth <= RAZOR_DEPTH && eval + RAZOR_MARGIN * depth <= alpha) // Only a capture can save it
+        {
+
+            int32_t score = Quiescence(search, alpha, beta, ply);
+
+            if(search->stopped) return 0;
+
+            if(score <= alpha)
+            {
+
+                CountStat(search, razors, 1);
+                return score;
+
+            }
+
+        }
+
+        if((search->pruning & PRUNE_FUTILITY) && depth <= FUTILITY_DEPTH && abs(beta) < MATE_BOUND)
+        {
+
+            if(eval - FUTILITY_MARGIN * depth >= beta) // Too far ahead for the opponent to catch up this close to the horizon
+            {
+
+                CountStat(search, futility, 1);
+                return eval;
+
+            }
+
+            futile = eval + FUTILITY_MARGIN * depth <= alpha; // Quiet moves won't catch up either
+
+        }
+
+        if((search->pruning & PRUNE_NULL_MOVE) && !search->verifying && depth >= NULL_MIN_DEPTH && eval >= beta && previous.piece != EMPTY
+            && (position->occupancy[position->isWhite] & ~position->pieces[position->isWhite][PawnType] & ~position->pieces[position->isWhite][KingType])) // Passing is only safe with pieces, pawn endgames are full of zugzwang
+        {
+
+            uint8_t reduction = NULL_REDUCTION + depth / 6;
+            uint8_t reduced = (depth > reduction + 1)? depth - reduction - 1: 0;
+
+            MakeNullMove(position, &undo);
+
+            search->keys[search->rootkey + ply + 1] = position->key;
+
+            if(search->network && ply + 1 < MAX_PLY) search->accumulators[ply + 1] = search->accumulators[ply]; // Nothing moved
+
+            search->played[ply] = CreateMove(EMPTY, INDEX_MAX, INDEX_MAX);
+
+            CountStat(search, nullmoves, 1);
+
+            int32_t score = -Negamax(search, reduced, -beta, -beta + 1, ply + 1);
+
+            UnmakeNullMove(position, &undo);
+
+            if(search->stopped) return 0;
+
+            if(score >= beta)
+            {
+
+                if(score >= MATE_BOUND) score = beta; // A mate found after passing isn't real
+
+                if(depth < NULL_VERIFY_DEPTH)
+                {
+
+                    CountStat(search, nullcutoffs, 1);
+                    return score;
+
+                }
+
+                search->verifying = true; // Deep cutoffs are checked with a real move, a zugzwang would fail low here
+
+                int32_t verified = Negamax(search, reduced, beta - 1, beta, ply);
+
+                search->verifying = false;
+
+                if(search->stopped) return 0;
+
+                if(verified >= beta)
+                {
+
+                    CountStat(search, nullcutoffs, 1);
+                    return score;
+
+                }
+
+            }
+        }
+    }
+
+    GeneratePseudoMoves(position, list);
+    ScoreMoves(&search->order, position, list, hashmove, previous, ply);
+
+    for(size_t i = 0; i < list->size; i++)
+    {
+
+        Move move = PickMove(list, i);
+        bool quiet = IsQuietMove(position, move);
+
+        if(!ply && IsExcludedMove(search, move)) continue; // Already one of the lines found before
+
+        MakeSearchMove(search, move, &undo, ply);
+
+        if(IsSquareAttacked(position, GetPositionKing(position, !position->isWhite), position->isWhite)) // Left the king in check
+        {
+
+            UnmakePositionMove(position, move, &undo);
+            continue;
+
+        }
+
+        legal++;
+        search->played[ply] = move;
+
+        bool checking = IsPositionInCheck(position);
+        uint8_t reduction = 0;
+        int32_t score;
+
+        if(futile && quiet && !checking && legal > 1) // Futility pruning, the first move is always searched so there is a score
+        {
+
+            CountStat(search, futility, 1);
+            UnmakePositionMove(position, move, &undo);
+            continue;
+
+        }
+
+        if((search->pruning & PRUNE_LATE_MOVES) && depth >= LMR_MIN_DEPTH && legal > LMR_MIN_MOVES && quiet && !check && !checking) // Later quiet moves are less likely to be good
+        {
+
+            reduction = 1 + (31 - __builtin_clz(depth)) * (31 - __builtin_clz(legal)) / 4;
+
+            if(pvnode && reduction > 1) reduction--;
+
+            if(reduction > depth - 2) reduction = depth - 2;
+
+            CountStat(search, reductions, 1);
+
+        }
+
+        if(legal == 1 || (!reduction && !(search->pruning & PRUNE_PVS))) score = -Negamax(search, depth - 1, -beta, -alpha, ply + 1);
+
+        else
+        {
+
+            int32_t window = (search->pruning & PRUNE_PVS)? alpha + 1: beta; // Only asks if the move beats alpha
+
+            score = -Negamax(search, depth - 1 - reduction, -window, -alpha, ply + 1);
+
+            if(score > alpha && reduction && !search->stopped) // A reduced move beat alpha, look again at full depth
+            {
+
+                CountStat(search, researches, 1);
+                score = -Negamax(search, depth - 1, -window, -alpha, ply + 1);
+
+            }
+
+            if(score > alpha && score < beta && window != beta && !search->stopped) // Beat the null window, get its real score
+            {
+
+                CountStat(search, researches, 1);
+                score = -Negamax(search, depth - 1, -beta, -alpha, ply + 1);
+
+            }
+
+        }
+
+        UnmakePositionMove(position, move, &undo);
+
+        if(search->stopped) return 0; // Don't trust anything from an unfinished subtree
+
+        if(score > best) best = score;
+
+        if(score > alpha) // New best line, copy the child's line behind the move
+        {
+
+            alpha = score;
+            bestmove = move;
+
+            search->pv[ply][ply] = move;
+
+            for(uint8_t next = ply + 1; next < search->pvlength[ply + 1]; next++)
+                search->pv[ply][next] = search->pv[ply + 1][next];
+
+            search->pvlength[ply] = search->pvlength[ply + 1];
+
+            if(alpha >= beta) // The opponent won't allow this line
+            {
+
+                CountStat(search, cutoffs, 1);
+                CountStat(search, firstcutoffs, legal == 1);
+
+                if(quiet) UpdateMoveOrder(&search->order, position, move, previous, ply, depth, quiets, quietcount);
+
+                break;
+
+            }
+        }
+
+        if(quiet) quiets[quietcount++] = move; // Tried without a cutoff
+
+    }
+
+    if(!legal) best = check? -MATE_SCORE + ply: 0; // Checkmate or stalemate
+
+    if(search->table && (ply || !search->excluded)) // Upper bounds don't know which move is best, a root missing moves isn't the real root
+    {
+
+        entry.move = bestmove;
+        entry.score = ScoreToTable(best, ply);
+        entry.depth = depth;
+        entry.bound = (best >= beta)? BoundLower: (best > start || !legal)? BoundExact: BoundUpper;
+
+        StoreTable(search->table, position->key, &entry, &search->tablestats);
+
+    }
+
+    return best;
+
+}
+
+/*!
+ * \brief Checks if a root move is one of the moves the search was told to leave out
+ * \param search: Search state with the excluded moves
+ * \param move: Root move to check
+ * \returns bool: True if the move is skipped
+ */
+static inline bool IsExcludedMove(const SearchData* const search, const Move move)
+{
+
+    for(uint8_t i = 0; i < search->excluded; i++)
+        if(IsSameMove(search->exclude[i], move)) return true;
+
+    return false;
+
+}
+
+/*!
+ * \brief Runs iterative deepening on one thread
+ * \details The main thread owns the limits and halts the helpers once it is done, helpers skip some depths so the threads spread out
+ * \param thread: Thread to run, its result is filled with the last finished iteration
+ */
+static void IterativeDeepening(SearchThread* const thread)
+{
+
+    static __thread SearchData search[1]; // Large enough to not belong on the stack, one per thread so searches can run side by side
+
+    const SearchLimits* limits = &thread->limits;
+    uint8_t maxdepth = (limits->depth && limits->depth < MAX_PLY)? limits->depth: MAX_PLY - 1;
+    uint8_t helper = thread->id? (thread->id - 1) % 20: 0; // Row of the skip tables
+
+    SearchResult* result = &thread->result;
+
+    result->best = CreateMove(EMPTY, INDEX_MAX, INDEX_MAX);
+    result->score = 0;
+    result->depth = 0;
+    result->pvlength = 0;
+
+    search->position[0] = *thread->position;
+    search->nodes = 0;
+    search->qnodes = 0;
+    search->tbhits = 0;
+    search->maxnodes = limits->nodes; // Helpers normally stop when the main thread does, the limits are a backstop
+    search->deadline = limits->time? thread->start + (uint64_t)limits->time * 1000000ull: 0;
+    search->stopped = false;
+    search->stoppable = thread->id; // Helpers don't have to finish anything
+    search->halt = thread->halt;
+    search->stop = limits->stop;
+    search->table = thread->table;
+    search->network = limits->network;
+    search->pruning = limits->pruning;
+    search->verifying = false;
+    search->tablebase = limits->tablebase;
+    search->exclude = limits->exclude;
+    search->excluded = limits->exclude? limits->excluded: 0;
+    search->noise = limits->noise;
+    search->seed = limits->seed;
+
+    uint16_t keep = limits->keys? limits->keycount: 0; // Only the keys since the last capture or pawn move can repeat
+
+    if(keep > search->position->halfmove) keep = search->position->halfmove;
+    if(keep > SEARCH_MAX_HISTORY) keep = SEARCH_MAX_HISTORY;
+
+    if(keep) memcpy(search->keys, limits->keys + limits->keycount - keep, keep * sizeof(uint64_t));
+
+    search->rootkey = keep;
+    search->keys[keep] = search->position->key;
+
+    if(search->network) RefreshAccumulator(search->network, search->position, &search->accumulators[0]);
+
+    memset(&search->tablestats, 0, sizeof(TableStats));
+    memset(&search->stats, 0, sizeof(SearchStats));
+
+    ClearMoveOrder(&search->order); // Killers and history from another position would only mislead
+
+    for(uint8_t depth = 1; depth <= maxdepth; depth++)
+    {
+
+        if(thread->id && ((depth + SkipPhase[helper]) / SkipSize[helper]) % 2) continue; // Leave this depth to other threads
+
+        uint64_t nodes = search->nodes;
+        int32_t window = ASPIRATION_WINDOW;
+        int32_t alpha = -INFINITE_SCORE;
+        int32_t beta = INFINITE_SCORE;
+        int32_t score;
+
+        if((search->pruning & PRUNE_ASPIRATION) && depth >= ASPIRATION_DEPTH && result->depth && abs(result->score) < MATE_BOUND) // Expect about the last score
+        {
+
+            alpha = result->score - window;
+            beta = result->score + window;
+
+        }
+
+        while(true) // Widen the side the score fell out of until it lands inside
+        {
+
+            score = Negamax(search, depth, alpha, beta, 0);
+
+            if(search->stopped) break;
+
+            if(score <= alpha) alpha = (alpha - window > -INFINITE_SCORE)? alpha - window: -INFINITE_SCORE;
+            else if(score >= beta) beta = (beta + window < INFINITE_SCORE)? beta + window: INFINITE_SCORE;
+            else break;
+
+            CountStat(search, aspirations, 1);
+            window *= 2;
+
+        }
+
+        if(search->stopped) break;
+
+        search->stats.iterations[0] = search->stats.iterations[1];
+        search->stats.iterations[1] = search->nodes - nodes;
+
+        result->score = score;
+        result->depth = depth;
+        result->pvlength = search->pvlength[0];
+
+        for(uint8_t i = 0; i < result->pvlength; i++)
+            result->pv[i] = search->pv[0][i];
+
+        if(result->pvlength) result->best = result->pv[0];
+
+        search->stoppable = true;
+
+        if(!thread->id && limits->report) // Only the main thread's own nodes are known until the helpers are done
+        {
+
+            result->nodes = search->nodes;
+            result->qnodes = search->qnodes;
+            result->tbhits = search->tbhits;
+            result->time = (uint32_t)((GetMonotonicTime() - thread->start) / 1000000ull);
+            result->stats.seldepth = search->stats.seldepth;
+
+            limits->report(result);
+
+        }
+
+        if(!result->pvlength || MATE_SCORE - abs(score) <= depth) break; // No legal moves or a mate that deeper searches won't change
+
+        if(!thread->id && search->deadline && (GetMonotonicTime() - thread->start) * 2 > search->deadline - thread->start) break; // The next iteration won't finish in time
+
+    }
+
+    if(!thread->id) __atomic_store_n(thread->halt, true, __ATOMIC_RELAXED); // Tell the helpers to stop
+
+    if(search->table) AddTableStats(search->table, &search->tablestats);
+
+    result->nodes = search->nodes;
+    result->qnodes = search->qnodes;
+    result->tbhits = search->tbhits;
+    result->stats = search->stats;
+    result->stats.table = search->tablestats;
+
+}
+
+/*!
+ * \brief Adds the counters of one thread to the totals of the search
+ * \param total: Totals to add to, the iteration sizes are left alone
+ * \param stats: Counters of the thread
+ */
+static void AddSearchStats(SearchStats* const total, const SearchStats* const stats)
+{
+
+    if(stats->seldepth > total->seldepth) total->seldepth = stats->seldepth;
+
+    total->cutoffs += stats->cutoffs;
+    total->firstcutoffs += stats->firstcutoffs;
+    total->nullmoves += stats->nullmoves;
+    total->nullcutoffs += stats->nullcutoffs;
+    total->reductions += stats->reductions;
+    total->researches += stats->researches;
+    total->futility += stats->futility;
+    total->razors += stats->razors;
+    total->aspirations += stats->aspirations;
+
+    total->table.probes += stats->table.probes;
+    total->table.hits += stats->table.hits;
+    total->table.collisions += stats->table.collisions;
+    total->table.stores += stats->table.stores;
+
+}
+
+/*!
+ * \brief Runs a helper thread on the pool
+ * \param thread: SearchThread of the helper
+ * \returns void*: NULL
+ */
+static void* SearchHelper(void* thread)
+{
+
+    IterativeDeepening((SearchThread*)thread);
+
+    return NULL;
+
+}
+
+/*!
+ * \brief Searches a position with iterative deepening
+ * \details Each iteration searches one ply deeper than the last, when a limit is reached the unfinished iteration is dropped
+ * The first iteration always finishes so there is a move to play no matter how small the budget is
+ * With more than one thread the helpers search the same root at staggered depths sharing only the table, and the deepest finished result is used
+ * \param position: Position to search, it is copied so it isn't changed
+ * \param limits: Depth, node, time and thread budget of the search, the node budget is per thread
+ * \param table: Table kept between searches, NULL to search without one
+ * \returns SearchResult: The best move, its score and the principal variation of the deepest finished iteration
+ */
+SearchResult SearchPosition(const Position* const position, const SearchLimits limits, TranspositionTable* const table)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    SearchThread threads[SEARCH_MAX_THREADS];
+    Task helpers[SEARCH_MAX_THREADS];
+    ThreadPool* pool = GetThreadPool();
+    uint8_t count = limits.threads? limits.threads: 1;
+    bool halt = false;
+    uint64_t start = GetMonotonicTime();
+
+    if(count > SEARCH_MAX_THREADS) count = SEARCH_MAX_THREADS;
+
+    if(count > 1) // Enough workers for every helper to run at once, fewer helpers if the threads can't be made
+    {
+
+        uint8_t workers = ReserveWorkers(pool, count - 1);
+
+        if(workers < count - 1) count = workers + 1;
+
+    }
+
+    if(table) AgeTable(table);
+
+    for(uint8_t i = 0; i < count; i++) // The results are filled by the threads
+    {
+
+        threads[i].position = position;
+        threads[i].limits = limits;
+        threads[i].table = table;
+        threads[i].id = i;
+        threads[i].halt = &halt;
+        threads[i].start = start;
+
+    }
+
+    for(uint8_t i = 1; i < count; i++) // Helpers first so they are running while the main thread searches
+        SubmitTask(pool, &helpers[i], SearchHelper, &threads[i]);
+
+    IterativeDeepening(&threads[0]);
+
+    SearchResult result = threads[0].result;
+    SearchStats stats = result.stats; // The iteration sizes stay the main thread's
+
+    for(uint8_t i = 1; i < count; i++)
+    {
+
+        WaitTask(pool, &helpers[i]); // A helper that never started runs here and stops right away
+
+        AddSearchStats(&stats, &threads[i].result.stats);
+
+        if(threads[i].result.depth > result.depth && threads[i].result.pvlength) // Deeper finished iterations win
+        {
+
+            uint64_t nodes = result.nodes;
+            uint64_t qnodes = result.qnodes;
+            uint64_t tbhits = result.tbhits;
+
+            result = threads[i].result;
+            result.nodes = nodes;
+            result.qnodes = qnodes;
+            result.tbhits = tbhits;
+
+        }
+
+        result.nodes += threads[i].result.nodes;
+        result.qnodes += threads[i].result.qnodes;
+        result.tbhits += threads[i].result.tbhits;
+
+    }
+
+    result.stats = stats;
+    result.time = (uint32_t)((GetMonotonicTime() - start) / 1000000ull);
+
+    return result;
+
+}
+
+/*!
+ * \brief Prints the counters of a search
+ * \details The counters kept inside the tree are only printed when compiled with SEARCH_STATS
+ * \param file: File to print to
+ * \param result: Result of the search
+ */
+void PrintSearchStats(FILE* const file, const SearchResult* const result)
+{
+
+    STATIC_ASSERT(file, "Invalid File Pointer");
+    STATIC_ASSERT(result, "Invalid Result Pointer");
+
+    const SearchStats* stats = &result->stats;
+    uint32_t time = result->time? result->time: 1;
+
+    fprintf(file, "depth %u seldepth %u score %d time %u ms nodes %llu qnodes %.1f%% knps %llu branching %.2f\n", result->depth, stats->seldepth, result->score,
+        result->time, (unsigned long long)result->nodes, 100.0 * result->qnodes / (result->nodes? result->nodes: 1), (unsigned long long)(result->nodes / time),
+        stats->iterations[0]? (double)stats->iterations[1] / stats->iterations[0]: 0.0);
+
+    fprintf(file, "hash probes %llu hits %.1f%% collisions %llu stores %llu tbhits %llu\n", (unsigned long long)stats->table.probes,
+        100.0 * stats->table.hits / (stats->table.probes? stats->table.probes: 1), (unsigned long long)stats->table.collisions,
+        (unsigned long long)stats->table.stores, (unsigned long long)result->tbhits);
+
+    #ifdef SEARCH_STATS
+
+    fprintf(file, "cutoffs %llu first move %.1f%% null moves %llu cut %llu reduced %llu researched %llu futility %llu razored %llu aspiration fails %llu\n",
+        (unsigned long long)stats->cutoffs, 100.0 * stats->firstcutoffs / (stats->cutoffs? stats->cutoffs: 1), (unsigned long long)stats->nullmoves,
+        (unsigned long long)stats->nullcutoffs, (unsigned long long)stats->reductions, (unsigned long long)stats->researches,
+        (unsigned long long)stats->futility, (unsigned long long)stats->razors, (unsigned long long)stats->aspirations);
+
+    #endif
+
+}
+
+/*!
+ * \brief Gets limits that only stop at a depth
+ * \param depth: Plies to search
+ * \returns SearchLimits: Limits with no node or time budget on one thread and every pruning technique
+ */
+SearchLimits GetDepthLimits(const uint8_t depth)
+{
+
+    return (SearchLimits){depth, 0, 0, 1, PRUNE_ALL, NULL, NULL, NULL, NULL, 0, NULL, 0, 0, NULL, 0};
+
+}
+
+// EOF //
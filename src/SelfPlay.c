@@ -0,0 +1,526 @@
+/*!
+ * \file SelfPlay.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the SelfPlay Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#define _POSIX_C_SOURCE 200809L // clock_gettime isn't part of plain C99
+
+#include "SelfPlay.h"
+
+#include <math.h>
+#include <time.h>
+
+// ------------------------- Tables ------------------------- //
+
+/// Names of the ways a game can end
+static const char* const GameEndNames[] = {"checkmate", "stalemate", "repetition", "fifty moves", "material", "adjudicated"};
+
+// ------------------------- Functions ------------------------- //
+
+/// Steps the random number generator of the openings
+static inline uint64_t NextRandom(uint64_t* const state);
+
+/// Packs a move into 16 bits for the game records
+static inline uint16_t PackMove(const Move move);
+
+/// Plays random legal plies from the start
+static uint8_t PlayOpening(Position* const position, uint64_t seed, const uint8_t plies, uint16_t* const moves, uint64_t* const keys);
+
+/// Checks if the position came up twice before
+static bool IsThreefold(const uint64_t* const keys, const uint16_t ply, const uint8_t halfmove);
+
+/// Checks if neither side can mate
+static bool IsDeadPosition(const Position* const position);
+
+/// Writes the record of a finished game
+static void WriteRecord(FILE* const file, const uint32_t game, const bool firstwhite, const int8_t result, const GameEnd end,
+    const uint8_t random, const uint16_t plies, const uint16_t* const moves);
+
+/// Plays games until the match has enough
+static void* SelfPlayWorker(void* match);
+
+/// Converts a score fraction to an Elo difference
+static double ScoreToElo(const double score);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Steps a xorshift64* generator
+ * \param state: Generator state, never zero
+ * \returns uint64_t: The next number
+ */
+static inline uint64_t NextRandom(uint64_t* const state)
+{
+
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545F4914F6CDD1Dull;
+
+}
+
+/*!
+ * \brief Packs a move for the game records, the start square, then the end square, then the promotion from 1 for a knight to 4 for a queen
+ * \param move: Move to pack
+ * \returns uint16_t: Packed move
+ */
+static inline uint16_t PackMove(const Move move)
+{
+
+    const char* promotion = move.promotion? strchr("NBRQ", move.promotion): NULL;
+
+    return (uint16_t)(move.start | (move.end << 6) | ((promotion? promotion - "NBRQ" + 1: 0) << 12));
+
+}
+
+/*!
+ * \brief Plays random legal plies from the start so the games of a match differ
+ * \details An opening that ends the game is thrown away and another one is tried
+ * \param position: Filled with the position after the opening
+ * \param seed: Seed of the opening, the same seed always plays the same opening
+ * \param plies: Random plies to play
+ * \param moves: Filled with the moves played
+ * \param keys: Filled with the key of the position before each move
+ * \returns uint8_t: Plies played, only fewer than asked if no opening of that length could be found
+ */
+static uint8_t PlayOpening(Position* const position, uint64_t seed, const uint8_t plies, uint16_t* const moves, uint64_t* const keys)
+{
+
+    PositionMoveList list[1];
+    PositionUndo undo;
+    uint64_t state = seed * 0x9E3779B97F4A7C15ull + 1; // Never zero for the generator
+
+    for(uint8_t attempt = 0; attempt < 100; attempt++)
+    {
+
+        uint8_t played = 0;
+
+        ResetPosition(position);
+
+        for(; played < plies; played++)
+        {
+
+            if(!GenerateLegalMoves(position, list)) break;
+
+            Move move = list->move[NextRandom(&state) % list->size];
+
+            moves[played] = PackMove(move);
+            keys[played] = position->key;
+            MakePositionMove(position, move, &undo);
+
+        }
+
+        if(played == plies && HasLegalMoves(position)) return played;
+
+    }
+
+    ResetPosition(position); // Every try ended the game, just play from the start
+
+    return 0;
+
+}
+
+/*!
+ * \brief Checks if the position came up at least twice before with the same side to move
+ * \param keys: Key of the position at every ply so far
+ * \param ply: Ply of the current position
+ * \param halfmove: Plies since the last capture or pawn move, nothing before it can repeat
+ * \returns bool: True on the third time
+ */
+static bool IsThreefold(const uint64_t* const keys, const uint16_t ply, const uint8_t halfmove)
+{
+
+    uint8_t seen = 0;
+
+    for(uint16_t back = 4; back <= halfmove && back <= ply; back += 2)
+        if(keys[ply - back] == keys[ply] && ++seen == 2) return true;
+
+    return false;
+
+}
+
+/*!
+ * \brief Checks if neither side has the material to mate, only a lone minor piece or less
+ * \param position: Position to look at
+ * \returns bool: True if the game is a dead draw
+ */
+static bool IsDeadPosition(const Position* const position)
+{
+
+    Bitboard minors = 0;
+
+    for(uint8_t color = 0; color < 2; color++)
+    {
+
+        if(position->pieces[color][PawnType] | position->pieces[color][RookType] | position->pieces[color][QueenType]) return false;
+
+        minors |= position->pieces[color][KnightType] | position->pieces[color][BishopType];
+
+    }
+
+    return CountSquares(minors) <= 1;
+
+}
+
+/*!
+ * \brief Writes the record of a game, every number is little endian
+ * \details The header is the game number as 32 bits, then a byte each for the color of the first engine, the result for white
+ * (0 draw, 1 white won, 2 black won), how it ended and the random plies, then the plies and a reserved zero as 16 bits
+ * \param file: File to write to, the caller holds the lock
+ * \param game: Number of the game
+ * \param firstwhite: True if the first engine had white
+ * \param result: 1 if white won, -1 if black won, 0 for a draw
+ * \param end: How the game ended
+ * \param random: Random plies at the start of the moves
+ * \param plies: Plies played
+ * \param moves: Packed moves, random plies included
+ */
+static void WriteRecord(FILE* const file, const uint32_t game, const bool firstwhite, const int8_t result, const GameEnd end,
+    const uint8_t random, const uint16_t plies, const uint16_t* const moves)
+{
+
+    uint8_t header[SELFPLAY_RECORD_HEADER] = {game & 0xFF, (game >> 8) & 0xFF, (game >> 16) & 0xFF, game >> 24, firstwhite,
+        (result < 0)? 2: (uint8_t)result, end, random, plies & 0xFF, plies >> 8, 0, 0};
+
+    fwrite(header, 1, sizeof(header), file);
+
+    for(uint16_t i = 0; i < plies; i++)
+    {
+
+        uint8_t bytes[2] = {moves[i] & 0xFF, moves[i] >> 8};
+
+        fwrite(bytes, 1, sizeof(bytes), file);
+
+    }
+}
+
+/*!
+ * \brief Plays games until the match has enough
+ * \details Each worker has a table for each engine, cleared before every game so games don't leak into each other
+ * The game is played on a position alone, nothing is printed
+ * \param match: Match to play games of
+ * \returns void*: NULL
+ */
+static void* SelfPlayWorker(void* match)
+{
+
+    SelfPlay* run = match;
+    TranspositionTable* tables[2] = {CreateTable(run->engines[0].hash), CreateTable(run->engines[1].hash)};
+    Position position[1];
+    PositionUndo undo;
+
+    static __thread uint16_t moves[SELFPLAY_MAX_PLIES]; // Too big for the stack of a worker
+    static __thread uint64_t keys[SELFPLAY_MAX_PLIES + 1];
+
+    while(true)
+    {
+
+        pthread_mutex_lock(&run->lock);
+        uint32_t game = run->next++;
+        pthread_mutex_unlock(&run->lock);
+
+        if(game >= run->games) break;
+
+        bool firstwhite = !(game & 1); // Both games of a pair have the same opening
+        uint16_t ply = PlayOpening(position, run->seed ^ (game >> 1), run->random, moves, keys);
+        uint8_t random = (uint8_t)ply;
+        int8_t result = 0;
+        GameEnd end;
+
+        for(uint8_t i = 0; i < 2; i++)
+            if(tables[i]) ClearTable(tables[i]);
+
+        while(true)
+        {
+
+            keys[ply] = position->key;
+
+            if(!HasLegalMoves(position))
+            {
+
+                bool mated = IsPositionInCheck(position);
+
+                end = mated? EndCheckmate: EndStalemate;
+                result = mated? (position->isWhite? -1: 1): 0;
+                break;
+
+            }
+
+            if(position->halfmove >= 100) end = EndFiftyMoves;
+            else if(IsThreefold(keys, ply, position->halfmove)) end = EndRepetition;
+            else if(IsDeadPosition(position)) end = EndMaterial;
+            else if(ply >= SELFPLAY_MAX_PLIES) end = EndAdjudicated;
+
+            else // Still going, the engine of the side to move plays
+            {
+
+                uint8_t side = (position->isWhite == firstwhite)? 0: 1;
+                SearchLimits limits = run->engines[side].limits;
+
+                limits.seed = run->seed ^ ((uint64_t)game << 16) ^ ply; // Noise differs from move to move and game to game but replays with the seed
+                limits.keys = keys;
+                limits.keycount = ply; // The search sees the game so far and steers into or away from repeating it
+
+                SearchResult search = SearchPosition(position, limits, tables[side]);
+
+                moves[ply++] = PackMove(search.best);
+                MakePositionMove(position, search.best, &undo);
+                continue;
+
+            }
+
+            break; // Drawn
+
+        }
+
+        pthread_mutex_lock(&run->lock);
+
+        if(!result) run->draws++;
+        else if((result > 0) == firstwhite) run->wins++;
+        else run->losses++;
+
+        run->ends[end]++;
+        run->plies += ply;
+
+        if(run->records) WriteRecord(run->records, game, firstwhite, result, end, random, ply, moves);
+
+        pthread_mutex_unlock(&run->lock);
+
+    }
+
+    DeleteTable(tables[0]);
+    DeleteTable(tables[1]);
+
+    return NULL;
+
+}
+
+/*!
+ * \brief Converts the fraction of the points scored to an Elo difference
+ * \param score: Points over games, from 0 to 1
+ * \returns double: Elo difference, infinite for a clean sweep
+ */
+static double ScoreToElo(const double score)
+{
+
+    if(score <= 0) return -INFINITY;
+
+    if(score >= 1) return INFINITY;
+
+    return -400.0 * log10(1.0 / score - 1.0);
+
+}
+
+/*!
+ * \brief Sets an engine up to play like the settings say
+ * \param engine: Engine to reset
+ * \param settings: Settings with the hash size, pruning, network and tablebase
+ */
+void ResetSelfPlayEngine(SelfPlayEngine* const engine, const Settings* const settings)
+{
+
+    STATIC_ASSERT(engine, "Invalid Engine Pointer");
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    engine->limits = GetDepthLimits(0); // No limit yet, SELFPLAY_DEFAULT_NODES if none is given
+    engine->limits.pruning = GetSearchPruning(settings);
+    engine->hash = GetHashSize(settings);
+
+    strncpy(engine->network, GetNetworkFile(settings), SETTINGS_PATH_MAX - 1);
+    strncpy(engine->tablebase, GetTablebaseDirectory(settings), SETTINGS_PATH_MAX - 1);
+
+    engine->network[SETTINGS_PATH_MAX - 1] = '\0';
+    engine->tablebase[SETTINGS_PATH_MAX - 1] = '\0';
+
+}
+
+/*!
+ * \brief Changes an engine with a spec like "depth=8,nodes=0,time=0,threads=1,pruning=31,noise=0,hash=16,nnue=FILE,tb=DIR"
+ * \param engine: Engine to change
+ * \param spec: Comma separated key=value pairs
+ * \returns bool: True if every key was known
+ */
+bool ParseSelfPlayEngine(SelfPlayEngine* const engine, const char* const spec)
+{
+
+    STATIC_ASSERT(engine, "Invalid Engine Pointer");
+    STATIC_ASSERT(spec, "Invalid Spec Pointer");
+
+    for(const char* c = spec; *c; )
+    {
+
+        const char* equals = strchr(c, '=');
+        const char* comma = strchr(c, ',');
+
+        if(!comma) comma = c + strlen(c);
+
+        if(!equals || equals > comma) return false;
+
+        size_t key = equals - c;
+        size_t length = comma - equals - 1;
+        unsigned long long value = strtoull(equals + 1, NULL, 0);
+
+        if(key == 5 && !strncmp(c, "depth", 5)) engine->limits.depth = (value < MAX_PLY)? (uint8_t)value: MAX_PLY - 1;
+        else if(key == 5 && !strncmp(c, "nodes", 5)) engine->limits.nodes = value;
+        else if(key == 4 && !strncmp(c, "time", 4)) engine->limits.time = (uint32_t)value;
+        else if(key == 7 && !strncmp(c, "threads", 7)) engine->limits.threads = (uint8_t)value;
+        else if(key == 7 && !strncmp(c, "pruning", 7)) engine->limits.pruning = (uint8_t)value & PRUNE_ALL;
+        else if(key == 5 && !strncmp(c, "noise", 5)) engine->limits.noise = (uint16_t)value;
+        else if(key == 4 && !strncmp(c, "hash", 4)) engine->hash = (uint16_t)value;
+
+        else if((key == 4 && !strncmp(c, "nnue", 4)) || (key == 2 && !strncmp(c, "tb", 2)))
+        {
+
+            char* path = (key == 4)? engine->network: engine->tablebase;
+
+            if(length >= SETTINGS_PATH_MAX) return false;
+
+            memcpy(path, equals + 1, length);
+            path[length] = '\0';
+
+        }
+
+        else return false;
+
+        c = *comma? comma + 1: comma;
+
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief Plays a match between two engines and prints the results for the first one
+ * \details The games are shared out to tasks on the shared thread pool, each game runs on one task from start to end with no output
+ * The Elo difference comes with a 95% interval from the spread of the game results
+ * \param match: Match with the engines, games, random plies and seed filled in
+ * \param concurrency: Games played at once, zero for one per processor
+ * \param records: File to write the game records to, NULL for none
+ * \param file: File to print the results to
+ * \returns bool: True if the match was played
+ */
+bool RunSelfPlay(SelfPlay* const match, const uint8_t concurrency, const char* const records, FILE* const file)
+{
+
+    STATIC_ASSERT(match, "Invalid Match Pointer");
+    STATIC_ASSERT(file, "Invalid File Pointer");
+
+    Task workers[SEARCH_MAX_THREADS];
+    ThreadPool* pool = GetThreadPool();
+    uint8_t count = concurrency? concurrency: GetOnlineProcessors();
+    struct timespec start, end;
+
+    if(count > SEARCH_MAX_THREADS) count = SEARCH_MAX_THREADS;
+
+    if(count > 1) // A worker of the pool for every game at once but the one played here, fewer at once if the workers can't be made
+    {
+
+        uint8_t reserved = ReserveWorkers(pool, count - 1);
+
+        if(reserved < count - 1) count = reserved + 1;
+
+    }
+
+    match->records = records? fopen(records, "wb"): NULL;
+
+    if(records && !match->records)
+    {
+
+        fprintf(stderr, "Can't open %s\n", records);
+        return false;
+
+    }
+
+    if(match->records) // The version and every number after it are little endian
+    {
+
+        uint8_t version[4] = {SELFPLAY_VERSION, 0, 0, 0};
+
+        fwrite(SELFPLAY_MAGIC, 1, 4, match->records);
+        fwrite(version, 1, sizeof(version), match->records);
+
+    }
+
+    for(uint8_t i = 0; i < 2; i++)
+    {
+
+        SearchLimits* limits = &match->engines[i].limits;
+
+        if(!limits->depth && !limits->nodes && !limits->time) limits->nodes = SELFPLAY_DEFAULT_NODES;
+
+        if(!limits->threads) limits->threads = 1; // The games are the parallelism
+
+        limits->network = CreateNetwork(match->engines[i].network);
+        limits->tablebase = CreateTablebase(match->engines[i].tablebase);
+
+    }
+
+    match->next = 0;
+    match->wins = match->draws = match->losses = 0;
+    match->plies = 0;
+    memset(match->ends, 0, sizeof(match->ends));
+
+    pthread_mutex_init(&match->lock, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for(uint8_t i = 1; i < count; i++) // Each task plays games off the shared counter until there are none left
+        SubmitTask(pool, &workers[i], SelfPlayWorker, match);
+
+    SelfPlayWorker(match);
+
+    for(uint8_t i = 1; i < count; i++)
+        WaitTask(pool, &workers[i]);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    pthread_mutex_destroy(&match->lock);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    uint32_t games = match->wins + match->draws + match->losses;
+    double score = games? (match->wins + 0.5 * match->draws) / games: 0.5;
+    double deviation = 0;
+
+    if(games) // Spread of a single game's points around the mean, over the square root of the games for the mean itself
+    {
+
+        double variance = (match->wins * (1 - score) * (1 - score) + match->draws * (0.5 - score) * (0.5 - score) + match->losses * score * score) / games;
+
+        deviation = sqrt(variance / games);
+
+    }
+
+    double low = ScoreToElo(score - 1.96 * deviation);
+    double high = ScoreToElo(score + 1.96 * deviation);
+
+    fprintf(file, "Games %u: %u wins, %u draws, %u losses for the first engine, %.1f%%\n", games, match->wins, match->draws, match->losses, 100 * score);
+    fprintf(file, "Elo difference %+.1f +/- %.1f (95%%)\n", ScoreToElo(score), (high - low) / 2);
+    fprintf(file, "Ends:");
+
+    for(GameEnd i = EndCheckmate; i <= EndAdjudicated; i++)
+        fprintf(file, " %s %u%s", GameEndNames[i], match->ends[i], (i < EndAdjudicated)? ",": "\n");
+
+    fprintf(file, "%.1f plies a game, %.1f games an hour with %u at once\n", games? (double)match->plies / games: 0.0,
+        seconds > 0? games * 3600 / seconds: 0.0, count);
+
+    for(uint8_t i = 0; i < 2; i++)
+    {
+
+        DeleteNetwork((Network*)match->engines[i].limits.network);
+        DeleteTablebase((Tablebase*)match->engines[i].limits.tablebase);
+
+    }
+
+    if(match->records) fclose(match->records);
+
+    return true;
+
+}
+
+// EOF //
@@ -10,6 +10,9 @@
 // ------------------------- Dependencies ------------------------- //
 
 #include "Settings.h"
+#include "TranspositionTable.h"
+#include "Search.h"
+#include "AI.h"
 
 // ------------------------- Definintions ------------------------- //
 
@@ -26,6 +29,14 @@ void ResetSettings(Settings* const settings)
     settings->whitecolor = White;
     settings->mode = HumanVHuman;
     settings->connect = connection;
+    settings->hashsize = TABLE_DEFAULT_MB;
+    settings->threads = 0;
+    settings->pruning = PRUNE_ALL;
+    settings->stats = false;
+    settings->difficulty = Novice;
+    settings->network[0] = '\0';
+    settings->book[0] = '\0';
+    settings->tablebase[0] = '\0';
 
 }
 
@@ -131,4 +142,231 @@ void SetConnection(Settings* const settings, Connection connection)
 
 }
 
+/*!
+ * \brief Gets the transposition table size
+ * \param settings: Settings to look at
+ * \returns uint16_t: Size of each AI's table in MB
+ */
+uint16_t GetHashSize(const Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    return settings->hashsize;
+
+}
+
+/*!
+ * \brief Sets the transposition table size used by the next game
+ * \param settings: Settings to modify
+ * \param megabytes: Size of each AI's table in MB
+ */
+void SetHashSize(Settings* const settings, const uint16_t megabytes)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    settings->hashsize = megabytes;
+
+}
+
+/*!
+ * \brief Gets how many threads the harder AIs search with
+ * \param settings: Settings to look at
+ * \returns uint8_t: Number of threads, zero for one per processor
+ */
+uint8_t GetSearchThreads(const Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    return settings->threads;
+
+}
+
+/*!
+ * \brief Sets how many threads the harder AIs search with
+ * \param settings: Settings to modify
+ * \param threads: Number of threads, zero for one per processor
+ */
+void SetSearchThreads(Settings* const settings, const uint8_t threads)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    settings->threads = threads;
+
+}
+
+/*!
+ * \brief Gets which pruning techniques the AIs search with
+ * \param settings: Settings to look at
+ * \returns uint8_t: PRUNE flags of the techniques that are on
+ */
+uint8_t GetSearchPruning(const Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    return settings->pruning;
+
+}
+
+/*!
+ * \brief Sets which pruning techniques the AIs search with
+ * \param settings: Settings to modify
+ * \param pruning: PRUNE flags of the techniques to turn on
+ */
+void SetSearchPruning(Settings* const settings, const uint8_t pruning)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    settings->pruning = pruning & PRUNE_ALL;
+
+}
+
+/*!
+ * \brief Gets the difficulty every AI of a game plays at
+ * \param settings: Settings to look at
+ * \returns uint8_t: Difficulty from Novice to Impossible
+ */
+uint8_t GetAIDifficulty(const Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    return settings->difficulty;
+
+}
+
+/*!
+ * \brief Sets the difficulty every AI of a game plays at
+ * \param settings: Settings to modify
+ * \param difficulty: Difficulty from Novice to Impossible, anything higher is Impossible
+ */
+void SetAIDifficulty(Settings* const settings, const uint8_t difficulty)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    settings->difficulty = (difficulty > Impossible)? Impossible: difficulty;
+
+}
+
+/*!
+ * \brief Gets if the counters of every AI search are printed
+ * \param settings: Settings to look at
+ * \returns bool: True if they are printed to stderr
+ */
+bool GetPrintStats(const Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    return settings->stats;
+
+}
+
+/*!
+ * \brief Sets if the counters of every AI search are printed
+ * \param settings: Settings to modify
+ * \param stats: True to print them to stderr
+ */
+void SetPrintStats(Settings* const settings, const bool stats)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    settings->stats = stats;
+
+}
+
+/*!
+ * \brief Gets the weights file of the Impossible AI's network
+ * \param settings: Settings to look at
+ * \returns const char*: Path of the file, empty for none
+ */
+const char* GetNetworkFile(const Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    return settings->network;
+
+}
+
+/*!
+ * \brief Sets the weights file of the Impossible AI's network
+ * \param settings: Settings to modify
+ * \param path: Path of the file, NULL or empty for none, cut off at SETTINGS_PATH_MAX
+ */
+void SetNetworkFile(Settings* const settings, const char* const path)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    strncpy(settings->network, path? path: "", SETTINGS_PATH_MAX - 1);
+    settings->network[SETTINGS_PATH_MAX - 1] = '\0';
+
+}
+
+/*!
+ * \brief Gets the opening book every AI plays from
+ * \param settings: Settings to look at
+ * \returns const char*: Path of the book, empty for none
+ */
+const char* GetBookFile(const Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    return settings->book;
+
+}
+
+/*!
+ * \brief Sets the opening book every AI plays from
+ * \param settings: Settings to modify
+ * \param path: Path of the book, NULL or empty for none, cut off at SETTINGS_PATH_MAX
+ */
+void SetBookFile(Settings* const settings, const char* const path)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    strncpy(settings->book, path? path: "", SETTINGS_PATH_MAX - 1);
+    settings->book[SETTINGS_PATH_MAX - 1] = '\0';
+
+}
+
+/*!
+ * \brief Gets the directory of the endgame tables every AI uses
+ * \param settings: Settings to look at
+ * \returns const char*: Path of the directory, empty for none
+ */
+const char* GetTablebaseDirectory(const Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    return settings->tablebase;
+
+}
+
+/*!
+ * \brief Sets the directory of the endgame tables every AI uses
+ * \param settings: Settings to modify
+ * \param path: Path of the directory, NULL or empty for none, cut off at SETTINGS_PATH_MAX
+ */
+void SetTablebaseDirectory(Settings* const settings, const char* const path)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    strncpy(settings->tablebase, path? path: "", SETTINGS_PATH_MAX - 1);
+    settings->tablebase[SETTINGS_PATH_MAX - 1] = '\0';
+
+}
+
 // EOF //
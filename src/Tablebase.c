@@ -0,0 +1,623 @@
+/*!
+ * \file Tablebase.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the Tablebase Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#define _POSIX_C_SOURCE 200809L // mmap and directory listing aren't part of plain C99
+
+#include "Tablebase.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ------------------------- Tables ------------------------- //
+
+/// Order the piece types are listed in, both in file names and in the index
+static const PieceType TypeOrder[6] = {KingType, QueenType, RookType, BishopType, KnightType, PawnType};
+
+/// Letter of each piece type in file names, indexed by type
+static const char TypeLetters[6] = {'P', 'N', 'B', 'R', 'Q', 'K'};
+
+/// Pair of each placement of the first and second king, -1 if the placement is left out, for tables without and with pawns
+static int16_t KingPairs[2][64][64];
+
+/// Squares of the first and second king of each pair, for tables without and with pawns
+static Index PairSquares[2][TABLEBASE_KING_PAIRS][2];
+
+/// Number of king pairs, for tables without and with pawns
+static uint16_t PairCount[2];
+
+/// Ways to pick some squares out of a number of squares, indexed by squares then picks
+static size_t Binomials[65][TABLEBASE_MAX_PIECES + 1];
+
+/// Makes sure the index tables are only built once
+static pthread_once_t IndexOnce = PTHREAD_ONCE_INIT;
+
+// ------------------------- Functions ------------------------- //
+
+/// Fills the king pair and binomial tables
+static void InitTablebaseIndex();
+
+/// Moves a square by one of the eight symmetries of the board
+static inline Index TransformSquare(Index square, const uint8_t symmetry);
+
+/// Gets the material key of a table from its file name
+static bool ParseMaterial(const char* const name, uint64_t* const material, uint8_t* const pieces);
+
+/// Maps one file of a table
+static const uint8_t* MapTable(const char* const path, const char* const magic, const uint8_t pieces, const size_t size);
+
+/// Finds the table of a position
+static const TablebaseFile* FindTablebaseFile(const Tablebase* const tablebase, const Position* const position, bool* const flipped);
+
+/// Reads the value of an entry
+static bool ReadTablebaseValue(const TablebaseFile* const file, const size_t index, int8_t* const value);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Fills the king pair and binomial tables
+ * \details Without pawns the first king is moved into the a1-d1-d4 triangle, and when it is on the diagonal the second king
+ * is moved on or below the diagonal, which leaves 462 pairs. With pawns only the files can be mirrored so the first king
+ * is kept on files a to d, which leaves 1806 pairs. Kings next to each other are never a position so they get no pair
+ */
+static void InitTablebaseIndex()
+{
+
+    for(uint8_t pawns = 0; pawns < 2; pawns++)
+    {
+
+        memset(KingPairs[pawns], 0xff, sizeof(KingPairs[pawns]));
+
+        for(Index first = 0; first < 64; first++)
+        {
+
+            uint8_t row = GetRow(first);
+            uint8_t column = GetColumn(first);
+
+            if(column > 3 || (!pawns && row > column)) continue;
+
+            for(Index second = 0; second < 64; second++)
+            {
+
+                if(abs(GetRow(second) - row) <= 1 && abs(GetColumn(second) - column) <= 1) continue; // Touching or on the same square
+
+                if(!pawns && row == column && GetRow(second) > GetColumn(second)) continue; // The diagonal mirror of a pair that is kept
+
+                PairSquares[pawns][PairCount[pawns]][0] = first;
+                PairSquares[pawns][PairCount[pawns]][1] = second;
+                KingPairs[pawns][first][second] = (int16_t)PairCount[pawns]++;
+
+            }
+        }
+    }
+
+    for(uint8_t squares = 0; squares <= 64; squares++)
+    {
+
+        Binomials[squares][0] = 1;
+
+        for(uint8_t picks = 1; picks <= TABLEBASE_MAX_PIECES; picks++)
+            Binomials[squares][picks] = squares? Binomials[squares - 1][picks - 1] + Binomials[squares - 1][picks]: 0;
+
+    }
+}
+
+/*!
+ * \brief Moves a square by one of the eight symmetries of the board
+ * \param square: Square to move
+ * \param symmetry: One to mirror the files, two to mirror the ranks and four to mirror along the a1-h8 diagonal first
+ * \returns Index: The moved square
+ */
+static inline Index TransformSquare(Index square, const uint8_t symmetry)
+{
+
+    if(symmetry & 4) square = (Index)((square >> 3) | ((square & 7) << 3));
+    if(symmetry & 2) square ^= 56;
+    if(symmetry & 1) square ^= 7;
+
+    return square;
+
+}
+
+/*!
+ * \brief Reads the material of a table from its name, like KRvK.uctb
+ * \param name: File name
+ * \param material: Filled with the material key, the pieces before the v are white
+ * \param pieces: Filled with the number of pieces
+ * \returns bool: True if the name is a table with one king on each side
+ */
+static bool ParseMaterial(const char* const name, uint64_t* const material, uint8_t* const pieces)
+{
+
+    size_t length = strlen(name);
+    size_t extension = strlen(TABLEBASE_EXTENSION);
+    uint8_t side = 0;
+
+    if(length <= extension || length >= TABLEBASE_NAME_MAX || strcmp(name + length - extension, TABLEBASE_EXTENSION)) return false;
+
+    *material = 0;
+    *pieces = 0;
+
+    for(size_t i = 0; i < length - extension; i++)
+    {
+
+        if(name[i] == 'v' && !side)
+        {
+
+            side = 1;
+            continue;
+
+        }
+
+        const char* letter = memchr(TypeLetters, name[i], sizeof(TypeLetters));
+
+        if(!letter || ++*pieces > TABLEBASE_MAX_PIECES) return false;
+
+        *material += (uint64_t)1 << (4 * (side * 6 + (letter - TypeLetters)));
+
+    }
+
+    return side && ((*material >> (4 * KingType)) & 15) == 1 && ((*material >> (4 * (6 + KingType))) & 15) == 1;
+
+}
+
+/*!
+ * \brief Maps one file of a table and checks its header and size
+ * \param path: Path of the file
+ * \param magic: Magic the file has to start with
+ * \param pieces: Pieces of the table
+ * \param size: Bytes the file has to have, header included
+ * \returns const uint8_t*: The entries past the header, NULL if the file isn't there or doesn't match
+ */
+static const uint8_t* MapTable(const char* const path, const char* const magic, const uint8_t pieces, const size_t size)
+{
+
+    int descriptor = open(path, O_RDONLY);
+
+    if(descriptor < 0) return NULL;
+
+    struct stat info;
+    void* data = MAP_FAILED;
+
+    if(!fstat(descriptor, &info) && (size_t)info.st_size == size)
+        data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    close(descriptor);
+
+    if(data == MAP_FAILED) return NULL;
+
+    uint32_t header[2];
+
+    memcpy(header, (const uint8_t*)data + 4, sizeof(header));
+
+    if(memcmp(data, magic, 4) || header[0] != TABLEBASE_VERSION || header[1] != pieces)
+    {
+
+        munmap(data, size);
+        return NULL;
+
+    }
+
+    posix_madvise(data, size, POSIX_MADV_RANDOM); // The search probes all over the table
+
+    return (const uint8_t*)data + TABLEBASE_HEADER;
+
+}
+
+/*!
+ * \brief Maps every table in a directory, each result file along with its distance file if there is one
+ * \param directory: Directory with the tables, NULL or empty for none
+ * \returns Tablebase*: The tables, NULL if there are none
+ */
+Tablebase* CreateTablebase(const char* const directory)
+{
+
+    if(!directory || !*directory) return NULL;
+
+    DIR* listing = opendir(directory);
+
+    if(!listing) return NULL;
+
+    Tablebase* tablebase = calloc(1, sizeof(Tablebase));
+    struct dirent* item;
+
+    while(tablebase && tablebase->count < TABLEBASE_MAX_FILES && (item = readdir(listing)))
+    {
+
+        TablebaseFile* file = &tablebase->files[tablebase->count];
+        char path[SETTINGS_PATH_MAX + TABLEBASE_NAME_MAX];
+
+        if(!ParseMaterial(item->d_name, &file->material, &file->pieces)) continue;
+
+        int length = (int)(strlen(item->d_name) - strlen(TABLEBASE_EXTENSION));
+
+        file->entries = GetTablebaseEntries(file->material);
+        file->resultsize = TABLEBASE_HEADER + (file->entries + 3) / 4;
+        file->distancesize = TABLEBASE_HEADER + file->entries;
+
+        snprintf(path, sizeof(path), "%s/%s", directory, item->d_name);
+
+        if(!(file->results = MapTable(path, TABLEBASE_MAGIC, file->pieces, file->resultsize))) continue;
+
+        snprintf(path, sizeof(path), "%s/%.*s%s", directory, length, item->d_name, TABLEBASE_DTZ_EXTENSION);
+
+        file->distances = MapTable(path, TABLEBASE_DTZ_MAGIC, file->pieces, file->distancesize);
+
+        if(file->pieces > tablebase->pieces) tablebase->pieces = file->pieces;
+
+        tablebase->count++;
+
+    }
+
+    closedir(listing);
+
+    if(tablebase && !tablebase->count)
+    {
+
+        free(tablebase);
+        return NULL;
+
+    }
+
+    return tablebase;
+
+}
+
+/*!
+ * \brief Unmaps every table
+ * \param tablebase: Tables to delete, NULL is ignored
+ */
+void DeleteTablebase(Tablebase* const tablebase)
+{
+
+    if(!tablebase) return;
+
+    for(uint8_t i = 0; i < tablebase->count; i++)
+    {
+
+        const TablebaseFile* file = &tablebase->files[i];
+
+        munmap((void*)(file->results - TABLEBASE_HEADER), file->resultsize);
+
+        if(file->distances) munmap((void*)(file->distances - TABLEBASE_HEADER), file->distancesize);
+
+    }
+
+    free(tablebase);
+
+}
+
+/*!
+ * \brief Gets the material key of a position, four bits for the count of each piece type of each side
+ * \param position: Position to look at
+ * \param flipped: True to swap the colors, so the black pieces come first like white's do in a table name
+ * \returns uint64_t: Material key
+ */
+uint64_t GetMaterialKey(const Position* const position, const bool flipped)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    uint64_t material = 0;
+
+    for(uint8_t side = 0; side < 2; side++)
+        for(PieceType type = PawnType; type < NoType; type++)
+            material |= (uint64_t)CountSquares(position->pieces[(side == 0) != flipped][type]) << (4 * (side * 6 + type));
+
+    return material;
+
+}
+
+/*!
+ * \brief Gets the number of entries in the table of a material
+ * \details Either side to move, every king pair, then for each group of like pieces every set of squares they can stand on
+ * \param material: Material key of the table
+ * \returns size_t: Entries in the table
+ */
+size_t GetTablebaseEntries(const uint64_t material)
+{
+
+    pthread_once(&IndexOnce, InitTablebaseIndex);
+
+    bool pawns = (material >> (4 * PawnType)) & 15 || (material >> (4 * (6 + PawnType))) & 15;
+    size_t entries = 2 * (size_t)PairCount[pawns];
+
+    for(uint8_t side = 0; side < 2; side++)
+        for(PieceType type = PawnType; type < KingType; type++)
+            entries *= Binomials[(type == PawnType)? 48: 64][(material >> (4 * (side * 6 + type))) & 15];
+
+    return entries;
+
+}
+
+/*!
+ * \brief Gets the entry of a position in its table
+ * \details The side to move is the highest digit and the king pair the next, then every group of like pieces adds the
+ * combination of its squares, the first side of the name first and each side from the queens down to the pawns.
+ * The board is turned by a symmetry first so that every position of a table has one entry, see InitTablebaseIndex,
+ * and like pieces are a combination rather than a square each so swapping two of them isn't another entry.
+ * Pawns only count the 48 squares they can stand on
+ * \param position: Position to look at
+ * \param flipped: True if the table has the colors swapped, the board is mirrored so black plays up the board
+ * \returns size_t: Entry of the position
+ */
+size_t GetTablebaseIndex(const Position* const position, const bool flipped)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    pthread_once(&IndexOnce, InitTablebaseIndex);
+
+    bool pawns = position->pieces[WHITE][PawnType] || position->pieces[BLACK][PawnType];
+    Index first = FirstSquare(position->pieces[!flipped][KingType]) ^ (flipped? 56: 0);
+    Index second = FirstSquare(position->pieces[flipped][KingType]) ^ (flipped? 56: 0);
+    uint8_t symmetry = 0;
+
+    if(pawns) symmetry = (GetColumn(first) > 3)? 1: 0;
+
+    else
+        while(KingPairs[0][TransformSquare(first, symmetry)][TransformSquare(second, symmetry)] < 0) symmetry++;
+
+    size_t index = position->isWhite != flipped; // One if the first side of the name is to move
+
+    index = index * PairCount[pawns] + (size_t)KingPairs[pawns][TransformSquare(first, symmetry)][TransformSquare(second, symmetry)];
+
+    for(uint8_t side = 0; side < 2; side++)
+    {
+
+        bool color = (side == 0) != flipped;
+
+        for(uint8_t i = 1; i < 6; i++)
+        {
+
+            PieceType type = TypeOrder[i];
+            Index squares[TABLEBASE_MAX_PIECES];
+            uint8_t count = 0;
+            size_t combination = 0;
+
+            for(Bitboard pieces = position->pieces[color][type]; pieces; pieces &= pieces - 1)
+            {
+
+                Index square = TransformSquare(FirstSquare(pieces) ^ (flipped? 56: 0), symmetry) - ((type == PawnType)? 8: 0);
+                uint8_t j = count++;
+
+                for(; j && squares[j - 1] > square; j--) squares[j] = squares[j - 1]; // Kept lowest first
+
+                squares[j] = square;
+
+            }
+
+            for(uint8_t j = 0; j < count; j++) combination += Binomials[squares[j]][j + 1];
+
+            index = index * Binomials[(type == PawnType)? 48: 64][count] + combination;
+
+        }
+    }
+
+    return index;
+
+}
+
+/*!
+ * \brief Sets up the position of an entry of a table, undoing GetTablebaseIndex
+ * \details The position is the one the entry was made from up to the symmetry, so it has the same value as any position with that entry
+ * \param position: Filled with the position, white being the first side of the name
+ * \param material: Material key of the table
+ * \param index: Entry to set up
+ * \returns bool: False if the entry puts two pieces on one square or the side not to move in check, it is never looked up
+ */
+bool SetTablebasePosition(Position* const position, const uint64_t material, size_t index)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    pthread_once(&IndexOnce, InitTablebaseIndex);
+
+    bool pawns = (material >> (4 * PawnType)) & 15 || (material >> (4 * (6 + PawnType))) & 15;
+    Piece pieces[TABLEBASE_MAX_PIECES];
+    Index squares[TABLEBASE_MAX_PIECES];
+    uint8_t count = 2;
+
+    for(uint8_t slot = 12; slot--;) // The groups from the last digit back, skipping the kings
+    {
+
+        uint8_t side = slot / 6;
+        PieceType type = TypeOrder[slot % 6];
+        uint8_t group = (material >> (4 * (side * 6 + type))) & 15;
+        size_t radix = Binomials[(type == PawnType)? 48: 64][group];
+
+        if(type == KingType || !group) continue;
+
+        if(count + group > TABLEBASE_MAX_PIECES) return false;
+
+        size_t combination = index % radix;
+
+        index /= radix;
+
+        for(uint8_t j = group; j--;) // The highest square takes the biggest share of the combination
+        {
+
+            Index square = (type == PawnType)? 47: 63;
+
+            while(Binomials[square][j + 1] > combination) square--;
+
+            combination -= Binomials[square][j + 1];
+            pieces[count] = CreatePiece(!side, GetTypeID(type), j);
+            squares[count++] = square + ((type == PawnType)? 8: 0);
+
+        }
+    }
+
+    if(index >= 2 * (size_t)PairCount[pawns]) return false;
+
+    pieces[0] = CreatePiece(WHITE, KING, 0);
+    pieces[1] = CreatePiece(BLACK, KING, 0);
+    squares[0] = PairSquares[pawns][index % PairCount[pawns]][0];
+    squares[1] = PairSquares[pawns][index % PairCount[pawns]][1];
+
+    return SetPositionFromPieces(position, pieces, squares, count, index / PairCount[pawns]);
+
+}
+
+/*!
+ * \brief Finds the table of a position, with the colors as they are or swapped
+ * \details Positions with castling rights or an en passant capture aren't in the tables
+ * \param tablebase: Tables to look in, NULL for none
+ * \param position: Position to look for
+ * \param flipped: Filled with true if the table has the colors swapped
+ * \returns const TablebaseFile*: The table, NULL if there is none
+ */
+static const TablebaseFile* FindTablebaseFile(const Tablebase* const tablebase, const Position* const position, bool* const flipped)
+{
+
+    if(!tablebase || CountSquares(position->occupancy[WHITE] | position->occupancy[BLACK]) > tablebase->pieces) return NULL;
+
+    if(position->castling || position->enpassant < 64) return NULL;
+
+    uint64_t material[2] = {GetMaterialKey(position, false), GetMaterialKey(position, true)};
+
+    for(uint8_t i = 0; i < tablebase->count; i++)
+    {
+
+        for(uint8_t side = 0; side < 2; side++)
+        {
+
+            if(tablebase->files[i].material != material[side]) continue;
+
+            *flipped = side;
+            return &tablebase->files[i];
+
+        }
+    }
+
+    return NULL;
+
+}
+
+/*!
+ * \brief Reads the value of an entry, the result with the distance to zeroing if the table has its distance file
+ * \param file: Table to read
+ * \param index: Entry to read
+ * \param value: Filled with zero for a draw, otherwise the distance plus one, negative for a loss, one if the distance isn't known
+ * \returns bool: False if the entry isn't a legal position
+ */
+static bool ReadTablebaseValue(const TablebaseFile* const file, const size_t index, int8_t* const value)
+{
+
+    uint8_t result = TablebaseResult(file->results, index);
+    int8_t distance = file->distances? (int8_t)(file->distances[index] + 1): 1;
+
+    if(result == TABLEBASE_BROKEN) return false;
+
+    *value = (result == TABLEBASE_DRAW)? 0: (result == TABLEBASE_WIN)? distance: -distance;
+
+    return true;
+
+}
+
+/*!
+ * \brief Looks up a position in the tables
+ * \param tablebase: Tables to look in, NULL for none
+ * \param position: Position to look up
+ * \param value: Filled with the value for the side to move, a win or loss is one if its table has no distances
+ * \returns bool: True if the position was found
+ */
+bool ProbeTablebase(const Tablebase* const tablebase, const Position* const position, int8_t* const value)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+
+    bool flipped;
+    const TablebaseFile* file = FindTablebaseFile(tablebase, position, &flipped);
+
+    return file && ReadTablebaseValue(file, GetTablebaseIndex(position, flipped), value);
+
+}
+
+/*!
+ * \brief Picks a root move straight from the tables
+ * \details A win takes the move that reaches a capture, pawn move or mate the soonest so it always makes progress
+ * A draw takes any move that keeps the draw and a loss takes the move that holds out the longest
+ * Moves that can't be ranked, into a table that isn't loaded or a quiet win whose table has no distances, are left out,
+ * and the pick is only played if it keeps the result of the position, and for a win its distance, otherwise the search decides
+ * \param tablebase: Tables to look in, NULL for none
+ * \param position: Position to pick a move for, left as it was
+ * \param move: Filled with the move
+ * \returns bool: True if a move that keeps the result of the position was found
+ */
+bool ProbeTablebaseRoot(const Tablebase* const tablebase, Position* const position, Move* const move)
+{
+
+    STATIC_ASSERT(position, "Invalid Position Pointer");
+    STATIC_ASSERT(move, "Invalid Move Pointer");
+
+    int8_t value;
+
+    if(!ProbeTablebase(tablebase, position, &value)) return false;
+
+    PositionMoveList list[1];
+    PositionUndo undo;
+    int32_t best = INT32_MIN;
+
+    GenerateLegalMoves(position, list);
+
+    for(size_t i = 0; i < list->size; i++)
+    {
+
+        bool zeroing = IsCaptureMove(position, list->move[i]) || GetPieceType(list->move[i].piece) == PawnType;
+        const TablebaseFile* file;
+        bool flipped;
+        int32_t rank;
+        int8_t after;
+
+        MakePositionMove(position, list->move[i], &undo);
+
+        if(!HasLegalMoves(position)) rank = IsPositionInCheck(position)? 1000: 0; // Mate beats everything, stalemate is a draw
+
+        else if(CountSquares(position->occupancy[WHITE] | position->occupancy[BLACK]) == 2) rank = 0; // Bare kings are a draw without a table
+
+        else if(!(file = FindTablebaseFile(tablebase, position, &flipped)) || !ReadTablebaseValue(file, GetTablebaseIndex(position, flipped), &after))
+            rank = INT32_MIN; // A promotion to a table that isn't loaded
+
+        else if(!after) rank = 0;
+
+        else if(!zeroing && !file->distances) rank = (after < 0)? INT32_MIN: -500; // A win could go nowhere without its distance, a loss is a loss
+
+        else // The opponent's loss is a win, counted in plies from here
+        {
+
+            int32_t distance = zeroing? 0: TablebaseDTZ(after) + 1;
+
+            rank = (after < 0)? 500 - distance: -500 + distance;
+
+        }
+
+        UnmakePositionMove(position, list->move[i], &undo);
+
+        if(rank > best)
+        {
+
+            best = rank;
+            *move = list->move[i];
+
+        }
+    }
+
+    if(best == INT32_MIN || TablebaseWDL(best) < TablebaseWDL(value)) return false; // The moves that keep the result were left out
+
+    return value <= 0 || 500 - best <= TablebaseDTZ(value); // A win has to be as close to zeroing as the table says, or it may never get there
+
+}
+
+// EOF //
@@ -0,0 +1,333 @@
+/*!
+ * \file ThreadPool.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the ThreadPool Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#define _POSIX_C_SOURCE 200809L // sysconf isn't part of plain C99
+
+#include "ThreadPool.h"
+#include <unistd.h>
+
+// ------------------------- Globals ------------------------- //
+
+/// Pool shared by the whole program
+static ThreadPool* SharedPool;
+
+/// Makes sure the shared pool is only created once
+static pthread_once_t SharedPoolOnce = PTHREAD_ONCE_INIT;
+
+// ------------------------- Functions ------------------------- //
+
+/// Creates the shared pool
+static void CreateSharedPool();
+
+/// Takes the oldest task off the queue, the lock has to be held
+static inline Task* PopTask(ThreadPool* const pool);
+
+/// Runs a task and wakes up anyone waiting on it
+static void RunTask(ThreadPool* const pool, Task* const task);
+
+/// Entry point of the worker threads
+static void* Worker(void* pool);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Creates the shared pool with a worker per processor
+ */
+static void CreateSharedPool()
+{
+
+    SharedPool = CreateThreadPool(0);
+
+}
+
+/*!
+ * \brief Takes the oldest task off the queue
+ * \param pool: Pool to take from, its lock has to be held
+ * \returns Task*: The task, NULL if the queue is empty
+ */
+static inline Task* PopTask(ThreadPool* const pool)
+{
+
+    if(!pool->size) return NULL;
+
+    Task* task = pool->queue[pool->head];
+
+    pool->head = (pool->head + 1) % POOL_QUEUE_SIZE;
+    pool->size--;
+
+    return task;
+
+}
+
+/*!
+ * \brief Runs a task and marks it done
+ * \param pool: Pool the task came from
+ * \param task: Task to run
+ */
+static void RunTask(ThreadPool* const pool, Task* const task)
+{
+
+    task->result = task->function(task->argument);
+
+    pthread_mutex_lock(&pool->lock);
+
+    __atomic_store_n(&task->done, true, __ATOMIC_RELEASE); // The result is visible before the flag
+    pthread_cond_broadcast(&pool->finished);
+
+    pthread_mutex_unlock(&pool->lock);
+
+}
+
+/*!
+ * \brief Runs queued tasks until the pool stops
+ * \param pool: The ThreadPool the worker belongs to
+ * \returns void*: NULL
+ */
+static void* Worker(void* pool)
+{
+
+    ThreadPool* self = (ThreadPool*)pool;
+
+    pthread_mutex_lock(&self->lock);
+
+    for(;;)
+    {
+
+        Task* task = PopTask(self);
+
+        if(!task)
+        {
+
+            if(self->stopping) break; // Only exit once the queue is drained
+
+            pthread_cond_wait(&self->ready, &self->lock);
+            continue;
+
+        }
+
+        pthread_mutex_unlock(&self->lock);
+
+        RunTask(self, task);
+
+        pthread_mutex_lock(&self->lock);
+
+    }
+
+    pthread_mutex_unlock(&self->lock);
+
+    return NULL;
+
+}
+
+/*!
+ * \brief Creates a pool of worker threads
+ * \param workers: Number of workers to start, zero for one per processor
+ * \returns ThreadPool*: The pool, NULL if it couldn't be created
+ */
+ThreadPool* CreateThreadPool(const uint8_t workers)
+{
+
+    ThreadPool* pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+
+    if(!pool) return NULL;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->ready, NULL);
+    pthread_cond_init(&pool->finished, NULL);
+
+    ReserveWorkers(pool, workers? workers: GetOnlineProcessors());
+
+    return pool;
+
+}
+
+/*!
+ * \brief Deletes a pool once every queued task has run
+ * \param pool: Pool to delete, may be NULL
+ */
+void DeleteThreadPool(ThreadPool* const pool)
+{
+
+    if(!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->ready);
+
+    pthread_mutex_unlock(&pool->lock);
+
+    for(uint8_t i = 0; i < pool->count; i++)
+        pthread_join(pool->workers[i], NULL);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->ready);
+    pthread_cond_destroy(&pool->finished);
+
+    free(pool);
+
+}
+
+/*!
+ * \brief Gets the shared pool
+ * \returns ThreadPool*: The pool every module submits its work to
+ */
+ThreadPool* GetThreadPool()
+{
+
+    pthread_once(&SharedPoolOnce, CreateSharedPool);
+
+    return SharedPool;
+
+}
+
+/*!
+ * \brief Makes sure a pool has enough workers, the pool never shrinks
+ * \param pool: Pool to grow
+ * \param workers: Number of workers wanted, at most POOL_MAX_WORKERS
+ * \returns uint8_t: The number of workers the pool has
+ */
+uint8_t ReserveWorkers(ThreadPool* const pool, const uint8_t workers)
+{
+
+    STATIC_ASSERT(pool, "Invalid Pool Pointer");
+
+    pthread_mutex_lock(&pool->lock);
+
+    while(pool->count < workers && pool->count < POOL_MAX_WORKERS) // Stop early if the system is out of threads
+    {
+
+        if(pthread_create(&pool->workers[pool->count], NULL, Worker, pool)) break;
+
+        pool->count++;
+
+    }
+
+    uint8_t count = pool->count;
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return count;
+
+}
+
+/*!
+ * \brief Queues a task for the workers
+ * \details If the queue is full the task runs on the calling thread so submitting never blocks and workers can submit too
+ * \param pool: Pool to run the task on
+ * \param task: Task to fill, it has to stay alive until WaitTask returns
+ * \param function: Work to do
+ * \param argument: Argument handed to the function
+ */
+void SubmitTask(ThreadPool* const pool, Task* const task, const TaskFunction function, void* const argument)
+{
+
+    STATIC_ASSERT(pool, "Invalid Pool Pointer");
+    STATIC_ASSERT(task, "Invalid Task Pointer");
+
+    task->function = function;
+    task->argument = argument;
+    task->result = NULL;
+    task->done = false;
+
+    pthread_mutex_lock(&pool->lock);
+
+    if(pool->size == POOL_QUEUE_SIZE || !pool->count) // No room or no one to run it
+    {
+
+        pthread_mutex_unlock(&pool->lock);
+        RunTask(pool, task);
+
+        return;
+
+    }
+
+    pool->queue[(pool->head + pool->size) % POOL_QUEUE_SIZE] = task;
+    pool->size++;
+
+    pthread_cond_signal(&pool->ready);
+    pthread_mutex_unlock(&pool->lock);
+
+}
+
+/*!
+ * \brief Waits for a task, running queued tasks instead of sleeping while there are any
+ * \param pool: Pool the task was submitted to
+ * \param task: Task to wait for
+ * \returns void*: What the task returned
+ */
+void* WaitTask(ThreadPool* const pool, Task* const task)
+{
+
+    STATIC_ASSERT(pool, "Invalid Pool Pointer");
+    STATIC_ASSERT(task, "Invalid Task Pointer");
+
+    if(IsTaskDone(task)) return task->result;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while(!IsTaskDone(task))
+    {
+
+        Task* other = PopTask(pool);
+
+        if(!other) // Everything is running so sleep until something finishes
+        {
+
+            pthread_cond_wait(&pool->finished, &pool->lock);
+            continue;
+
+        }
+
+        pthread_mutex_unlock(&pool->lock);
+
+        RunTask(pool, other); // Likely the task being waited on
+
+        pthread_mutex_lock(&pool->lock);
+
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return task->result;
+
+}
+
+/*!
+ * \brief Checks if a task has finished
+ * \param task: Task to check
+ * \returns bool: True once the result can be read
+ */
+bool IsTaskDone(const Task* const task)
+{
+
+    STATIC_ASSERT(task, "Invalid Task Pointer");
+
+    return __atomic_load_n(&task->done, __ATOMIC_ACQUIRE);
+
+}
+
+/*!
+ * \brief Gets the number of processors that are online
+ * \returns uint8_t: Processors that can run threads, at most POOL_MAX_WORKERS
+ */
+uint8_t GetOnlineProcessors()
+{
+
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if(count < 1) return 1;
+
+    return (count > POOL_MAX_WORKERS)? POOL_MAX_WORKERS: (uint8_t)count;
+
+}
+
+// EOF //
@@ -0,0 +1,375 @@
+/*!
+ * \file TranspositionTable.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the TranspositionTable Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#define _POSIX_C_SOURCE 200809L // posix_memalign isn't part of plain C99
+
+#include "TranspositionTable.h"
+
+// ------------------------- Tables ------------------------- //
+
+/// Promotion piece IDs by their packed code
+static const uint8_t PromotionIDs[8] = {EMPTY, KNIGHT, BISHOP, ROOK, QUEEN, EMPTY, EMPTY, EMPTY};
+
+// ------------------------- Functions ------------------------- //
+
+/// Packs an entry into the bits of a slot
+static inline uint64_t PackEntry(const TableEntry* const entry, const uint8_t generation);
+
+/// Unpacks the bits of a slot
+static inline void UnpackEntry(const uint64_t data, TableEntry* const entry);
+
+/// Gets the bound of packed data, BoundNone for an empty slot
+static inline Bound GetPackedBound(const uint64_t data);
+
+/// Gets the generation of packed data
+static inline uint8_t GetPackedGeneration(const uint64_t data);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Packs an entry
+ * \details Bits 0-11 are the squares, 12 is set if there is a move, 13-15 the promotion, 16-31 the score,
+ * 32-39 the depth, 40-41 the bound and 42-47 the generation
+ * \param entry: Entry to pack
+ * \param generation: Generation of the search storing it
+ * \returns uint64_t: The packed data
+ */
+static inline uint64_t PackEntry(const TableEntry* const entry, const uint8_t generation)
+{
+
+    uint64_t data = 0;
+
+    if(entry->move.start < 64 && entry->move.end < 64) // Only real moves are stored
+    {
+
+        uint8_t promotion = 0;
+
+        while(promotion < 4 && PromotionIDs[promotion] != entry->move.promotion) promotion++;
+
+        data = (uint64_t)entry->move.start | (uint64_t)entry->move.end << 6 | (uint64_t)1 << 12 | (uint64_t)(promotion & 7) << 13;
+
+    }
+
+    data |= (uint64_t)(uint16_t)(int16_t)entry->score << 16;
+    data |= (uint64_t)entry->depth << 32;
+    data |= (uint64_t)(entry->bound & 3) << 40;
+    data |= (uint64_t)(generation & 63) << 42;
+
+    return data;
+
+}
+
+/*!
+ * \brief Unpacks an entry
+ * \param data: Packed data of a slot
+ * \param entry: Entry to fill
+ */
+static inline void UnpackEntry(const uint64_t data, TableEntry* const entry)
+{
+
+    entry->move = CreateMove(EMPTY, INDEX_MAX, INDEX_MAX);
+
+    if(data & ((uint64_t)1 << 12)) // The slot has a move
+    {
+
+        entry->move.start = data & 63;
+        entry->move.end = (data >> 6) & 63;
+        entry->move.promotion = PromotionIDs[(data >> 13) & 7];
+
+    }
+
+    entry->score = (int16_t)(uint16_t)(data >> 16);
+    entry->depth = (uint8_t)(data >> 32);
+    entry->bound = GetPackedBound(data);
+
+}
+
+/*!
+ * \brief Gets the bound of packed data
+ * \param data: Packed data of a slot
+ * \returns Bound: The bound, every stored entry has one so BoundNone means empty
+ */
+static inline Bound GetPackedBound(const uint64_t data)
+{
+
+    return (Bound)((data >> 40) & 3);
+
+}
+
+/*!
+ * \brief Gets the generation of packed data
+ * \param data: Packed data of a slot
+ * \returns uint8_t: The generation of the search that stored it
+ */
+static inline uint8_t GetPackedGeneration(const uint64_t data)
+{
+
+    return (uint8_t)((data >> 42) & 63);
+
+}
+
+/*!
+ * \brief Creates a table, halving the size until the memory can be found
+ * \param megabytes: Most memory to use, rounded down to a power of two buckets
+ * \returns TranspositionTable*: The empty table, NULL if not even a MB could be found
+ */
+TranspositionTable* CreateTable(const size_t megabytes)
+{
+
+    TranspositionTable* table = (TranspositionTable*)calloc(1, sizeof(TranspositionTable));
+
+    if(!table) return NULL;
+
+    size_t size = megabytes? megabytes: TABLE_DEFAULT_MB;
+    uint64_t buckets = 1;
+
+    if(size > TABLE_MAX_MB) size = TABLE_MAX_MB;
+
+    while(buckets * 2 * TABLE_BUCKET_SIZE * sizeof(TableSlot) <= size << 20) buckets *= 2; // Largest power of two that fits
+
+    for(; buckets * TABLE_BUCKET_SIZE * sizeof(TableSlot) >= (1 << 20); buckets /= 2) // Settle for less if the memory isn't there
+        if(!posix_memalign((void**)&table->slots, 64, buckets * TABLE_BUCKET_SIZE * sizeof(TableSlot))) break;
+
+    if(!table->slots)
+    {
+
+        free(table);
+        return NULL;
+
+    }
+
+    table->mask = buckets - 1;
+
+    ClearTable(table);
+
+    return table;
+
+}
+
+/*!
+ * \brief Deletes a table and its slots
+ * \param table: Table to delete, may be NULL
+ */
+void DeleteTable(TranspositionTable* const table)
+{
+
+    if(!table) return;
+
+    free(table->slots);
+    free(table);
+
+}
+
+/*!
+ * \brief Empties a table, only call it while no search is using it
+ * \param table: Table to clear
+ */
+void ClearTable(TranspositionTable* const table)
+{
+
+    STATIC_ASSERT(table, "Invalid Table Pointer");
+
+    memset(table->slots, 0, (table->mask + 1) * TABLE_BUCKET_SIZE * sizeof(TableSlot));
+    memset(&table->stats, 0, sizeof(TableStats));
+
+    table->generation = 0;
+
+}
+
+/*!
+ * \brief Starts a new generation, called once before each search
+ * \param table: Table to age
+ */
+void AgeTable(TranspositionTable* const table)
+{
+
+    STATIC_ASSERT(table, "Invalid Table Pointer");
+
+    table->generation = (table->generation + 1) & 63;
+
+}
+
+/*!
+ * \brief Looks up a position
+ * \param table: Table to look in
+ * \param key: Hash of the position
+ * \param entry: Filled with what was stored if found
+ * \param stats: Counters of the search doing the lookup
+ * \returns bool: True if the position was found
+ */
+bool ProbeTable(const TranspositionTable* const table, const uint64_t key, TableEntry* const entry, TableStats* const stats)
+{
+
+    const TableSlot* bucket = &table->slots[(key & table->mask) * TABLE_BUCKET_SIZE];
+    bool occupied = false;
+
+    stats->probes++;
+
+    for(uint8_t i = 0; i < TABLE_BUCKET_SIZE; i++)
+    {
+
+        uint64_t data = __atomic_load_n(&bucket[i].data, __ATOMIC_RELAXED);
+        uint64_t check = __atomic_load_n(&bucket[i].key, __ATOMIC_RELAXED);
+
+        if(GetPackedBound(data) == BoundNone) continue; // Empty slot
+
+        if((check ^ data) == key) // Only matches if both halves came from the same write
+        {
+
+            UnpackEntry(data, entry);
+            stats->hits++;
+
+            return true;
+
+        }
+
+        occupied = true;
+
+    }
+
+    if(occupied) stats->collisions++; // The bucket is holding other positions
+
+    return false;
+
+}
+
+/*!
+ * \brief Stores a position, replacing the least useful slot of its bucket
+ * \details A slot of the same position is always reused, otherwise an empty slot, otherwise the shallowest and oldest one
+ * \param table: Table to store in
+ * \param key: Hash of the position
+ * \param entry: What to store, the bound can't be BoundNone
+ * \param stats: Counters of the search doing the store
+ */
+void StoreTable(TranspositionTable* const table, const uint64_t key, const TableEntry* const entry, TableStats* const stats)
+{
+
+    TableSlot* bucket = &table->slots[(key & table->mask) * TABLE_BUCKET_SIZE];
+    TableSlot* replace = bucket;
+    int32_t worst = INT32_MAX;
+    uint64_t data = PackEntry(entry, table->generation);
+
+    for(uint8_t i = 0; i < TABLE_BUCKET_SIZE; i++)
+    {
+
+        uint64_t old = __atomic_load_n(&bucket[i].data, __ATOMIC_RELAXED);
+        uint64_t check = __atomic_load_n(&bucket[i].key, __ATOMIC_RELAXED);
+
+        if(GetPackedBound(old) != BoundNone && (check ^ old) == key) // Same position
+        {
+
+            if(!(data & ((uint64_t)1 << 12))) data |= old & 0xFFFF; // Keep the old move if there is no new one
+
+            replace = &bucket[i];
+            break;
+
+        }
+
+        int32_t value = (GetPackedBound(old) == BoundNone)? INT32_MIN: (int32_t)((old >> 32) & 0xFF) - 8 * ((table->generation - GetPackedGeneration(old)) & 63);
+
+        if(value < worst) // Empty slots come first, then shallow old ones
+        {
+
+            worst = value;
+            replace = &bucket[i];
+
+        }
+    }
+
+    __atomic_store_n(&replace->key, key ^ data, __ATOMIC_RELAXED);
+    __atomic_store_n(&replace->data, data, __ATOMIC_RELAXED);
+
+    stats->stores++;
+
+}
+
+/*!
+ * \brief Adds the counters of a finished search to the totals
+ * \param table: Table that was searched with
+ * \param stats: Counters of the search
+ */
+void AddTableStats(TranspositionTable* const table, const TableStats* const stats)
+{
+
+    STATIC_ASSERT(table, "Invalid Table Pointer");
+    STATIC_ASSERT(stats, "Invalid Stats Pointer");
+
+    __atomic_fetch_add(&table->stats.probes, stats->probes, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&table->stats.hits, stats->hits, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&table->stats.collisions, stats->collisions, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&table->stats.stores, stats->stores, __ATOMIC_RELAXED);
+
+}
+
+/*!
+ * \brief Gets the totals of the table
+ * \param table: Table to look at
+ * \returns TableStats: Counters of every finished search since the table was cleared
+ */
+TableStats GetTableStats(const TranspositionTable* const table)
+{
+
+    STATIC_ASSERT(table, "Invalid Table Pointer");
+
+    TableStats stats;
+
+    stats.probes = __atomic_load_n(&table->stats.probes, __ATOMIC_RELAXED);
+    stats.hits = __atomic_load_n(&table->stats.hits, __ATOMIC_RELAXED);
+    stats.collisions = __atomic_load_n(&table->stats.collisions, __ATOMIC_RELAXED);
+    stats.stores = __atomic_load_n(&table->stats.stores, __ATOMIC_RELAXED);
+
+    return stats;
+
+}
+
+/*!
+ * \brief Estimates how full the table is from the first thousand slots
+ * \param table: Table to look at
+ * \returns uint16_t: Slots used by the current generation per thousand
+ */
+uint16_t GetTableUsage(const TranspositionTable* const table)
+{
+
+    STATIC_ASSERT(table, "Invalid Table Pointer");
+
+    uint16_t used = 0;
+    uint64_t count = (table->mask + 1) * TABLE_BUCKET_SIZE;
+
+    if(count > 1000) count = 1000;
+
+    for(uint64_t i = 0; i < count; i++)
+    {
+
+        uint64_t data = __atomic_load_n(&table->slots[i].data, __ATOMIC_RELAXED);
+
+        if(GetPackedBound(data) != BoundNone && GetPackedGeneration(data) == table->generation) used++;
+
+    }
+
+    return (uint16_t)(used * 1000 / count);
+
+}
+
+/*!
+ * \brief Gets the size of the table
+ * \param table: Table to look at
+ * \returns size_t: Memory used by the slots in MB
+ */
+size_t GetTableSize(const TranspositionTable* const table)
+{
+
+    STATIC_ASSERT(table, "Invalid Table Pointer");
+
+    return (size_t)(((table->mask + 1) * TABLE_BUCKET_SIZE * sizeof(TableSlot)) >> 20);
+
+}
+
+// EOF //
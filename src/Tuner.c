@@ -0,0 +1,642 @@
+/*!
+ * \file Tuner.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the Tuner Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#include "Tuner.h"
+#include "PieceSquare.h"
+#include "PawnTable.h"
+#include "SelfPlay.h"
+#include "AIGameplay.h"
+#include "ThreadPool.h"
+
+#include <math.h>
+
+// ------------------------- Types ------------------------- //
+
+/*!
+ * \brief Share of the positions one thread works through
+ * \details Each thread adds up its own loss and gradient so nothing is shared until they are summed
+ */
+typedef struct
+{
+
+    const Tuner* tuner;          ///< Positions and weights
+    size_t start;                ///< First position of the share
+    size_t end;                  ///< Position after the last one
+    double scale;                ///< Scale from a score to a win chance
+
+    double loss;                 ///< Summed squared error of the share
+    double* gradient;            ///< Summed gradient of the share, NULL to only get the loss
+
+} TuningTask;
+
+// ------------------------- Tables ------------------------- //
+
+/// Piece IDs of the piece types
+static const char TypeIDs[6] = {PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING};
+
+/// Names of the piece types in the written tables
+static const char* const TypeNames[6] = {"Pawns", "Knights", "Bishops", "Rooks", "Queens", "King"};
+
+// ------------------------- Functions ------------------------- //
+
+/// Adds a position and its result to the run
+static bool AddTuningPosition(Tuner* const tuner, const Position* const position, const uint8_t result);
+
+/// Reads the result of an EPD line
+static uint8_t ParseTuningResult(const char* const rest);
+
+/// Finds the legal move a record packed
+static Move UnpackMove(Position* const position, const uint16_t packed);
+
+/// Loads the quiet positions of self-play records
+static size_t LoadTuningRecords(Tuner* const tuner, FILE* const file);
+
+/// Adds up the loss and gradient of a share of the positions
+static void* TuningWorker(void* task);
+
+/// Gets the mean loss and gradient of every position
+static double ComputeTuningLoss(const Tuner* const tuner, const uint8_t threads, const double scale, double* const gradient);
+
+/// Fits the scale from a score to a win chance
+static double FitTuningScale(const Tuner* const tuner, const uint8_t threads);
+
+/// Writes the weights as a header
+static bool WriteTunedWeights(const Tuner* const tuner, const char* const path);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Starts a tuning run from the values and tables the engine evaluates with now
+ * \returns Tuner*: The run, NULL if it couldn't be allocated
+ */
+Tuner* CreateTuner()
+{
+
+    Tuner* tuner = calloc(1, sizeof(Tuner));
+
+    if(!tuner) return NULL;
+
+    for(uint8_t type = 0; type < 6; type++)
+        for(Index square = 0; square < 64; square++) // The tables are drawn from white's side, so white flips the row
+        {
+
+            Piece piece = CreatePiece(WHITE, TypeIDs[type], 0);
+
+            tuner->weights[type * 64 + square] = GetPieceSquareValue(piece, square ^ 56, false);
+            tuner->weights[6 * 64 + type * 64 + square] = GetPieceSquareValue(piece, square ^ 56, true);
+
+        }
+
+    return tuner;
+
+}
+
+/*!
+ * \brief Frees a tuning run
+ * \param tuner: Run to free, NULL is ignored
+ */
+void DeleteTuner(Tuner* const tuner)
+{
+
+    if(!tuner) return;
+
+    free(tuner->positions);
+    free(tuner->features);
+    free(tuner);
+
+}
+
+/*!
+ * \brief Adds a position to the run, growing the arrays as needed
+ * \param tuner: Run to add to
+ * \param position: Position to add
+ * \param result: 0 if black won, 1 for a draw and 2 if white won
+ * \returns bool: False if there was no memory for it
+ */
+static bool AddTuningPosition(Tuner* const tuner, const Position* const position, const uint8_t result)
+{
+
+    if(tuner->count == tuner->capacity)
+    {
+
+        size_t capacity = tuner->capacity? tuner->capacity * 2: 1 << 16;
+        TuningPosition* positions = realloc(tuner->positions, capacity * sizeof(TuningPosition));
+
+        if(!positions) return false;
+
+        tuner->positions = positions;
+        tuner->capacity = capacity;
+
+    }
+
+    if(tuner->used + 32 > tuner->size)
+    {
+
+        size_t size = tuner->size? tuner->size * 2: 1 << 20;
+        uint16_t* features = realloc(tuner->features, size * sizeof(uint16_t));
+
+        if(!features) return false;
+
+        tuner->features = features;
+        tuner->size = size;
+
+    }
+
+    TuningPosition* entry = &tuner->positions[tuner->count++];
+    int32_t midgame = 0;
+    int32_t endgame = 0;
+
+    AddPawnScores(position, &midgame, &endgame); // Left out of the tuning, but part of the score
+
+    entry->offset = (uint32_t)tuner->used;
+    entry->count = 0;
+    entry->phase = (position->phase < PHASE_MAX)? position->phase: PHASE_MAX;
+    entry->result = result;
+    entry->midgame = (int16_t)midgame;
+    entry->endgame = (int16_t)endgame;
+
+    for(uint8_t color = 0; color < 2; color++)
+        for(PieceType type = PawnType; type < NoType; type++)
+            for(Bitboard pieces = position->pieces[color][type]; pieces; pieces &= pieces - 1)
+            {
+
+                Index square = color? FirstSquare(pieces) ^ 56: FirstSquare(pieces);
+
+                tuner->features[tuner->used++] = (uint16_t)((color << 9) | (type * 64 + square));
+                entry->count++;
+
+            }
+
+    return true;
+
+}
+
+/*!
+ * \brief Reads the result that follows the position of an EPD line
+ * \param rest: Line after the position, like c9 "1-0"; or [0.5]
+ * \returns uint8_t: 0 if black won, 1 for a draw, 2 if white won and UINT8_MAX if there is no result
+ */
+static uint8_t ParseTuningResult(const char* const rest)
+{
+
+    if(strstr(rest, "1/2") || strstr(rest, "0.5")) return 1;
+
+    if(strstr(rest, "1-0") || strstr(rest, "1.0")) return 2;
+
+    if(strstr(rest, "0-1") || strstr(rest, "0.0")) return 0;
+
+    return UINT8_MAX;
+
+}
+
+/*!
+ * \brief Finds the legal move a self-play record packed
+ * \param position: Position the move is played in
+ * \param packed: Start square, end square and promotion from 1 for a knight to 4 for a queen
+ * \returns Move: The move, with an EMPTY piece if it isn't legal
+ */
+static Move UnpackMove(Position* const position, const uint16_t packed)
+{
+
+    PositionMoveList list[1];
+    uint8_t promotion = (packed >> 12) & 7;
+
+    GenerateLegalMoves(position, list);
+
+    for(size_t i = 0; i < list->size; i++)
+        if(list->move[i].start == (packed & 63) && list->move[i].end == ((packed >> 6) & 63) &&
+            list->move[i].promotion == (promotion? "NBRQ"[promotion - 1]: EMPTY)) return list->move[i];
+
+    return CreateMove(EMPTY, INDEX_MAX, INDEX_MAX);
+
+}
+
+/*!
+ * \brief Loads the quiet positions of a self-play record file
+ * \details Skips the random opening, positions in check and positions whose next move captures or promotes, the rest are quiet enough to score statically
+ * \param tuner: Run to add to
+ * \param file: Record file past its magic
+ * \returns size_t: Positions added
+ */
+static size_t LoadTuningRecords(Tuner* const tuner, FILE* const file)
+{
+
+    uint8_t header[SELFPLAY_RECORD_HEADER];
+    uint8_t version[4];
+    size_t added = 0;
+
+    if(fread(version, 1, sizeof(version), file) != sizeof(version) || version[0] != SELFPLAY_VERSION) return 0;
+
+    while(fread(header, 1, sizeof(header), file) == sizeof(header))
+    {
+
+        const uint8_t results[3] = {1, 2, 0}; // Draw, white won and black won in the record
+        uint8_t random = header[7];
+        uint16_t plies = header[8] | (header[9] << 8);
+        uint8_t result = (header[5] < 3)? results[header[5]]: UINT8_MAX;
+        Position position[1];
+        PositionUndo undo;
+
+        ResetPosition(position);
+
+        for(uint16_t ply = 0; ply < plies; ply++)
+        {
+
+            uint8_t bytes[2];
+
+            if(fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes)) return added;
+
+            Move move = UnpackMove(position, bytes[0] | (bytes[1] << 8));
+
+            if(!move.piece) // A broken game, skip the rest of it
+            {
+
+                fseek(file, 2L * (plies - ply - 1), SEEK_CUR);
+                break;
+
+            }
+
+            bool quiet = !IsCaptureMove(position, move) && !move.promotion && !IsPositionInCheck(position);
+
+            if(ply >= random && quiet && result != UINT8_MAX)
+            {
+
+                if(!AddTuningPosition(tuner, position, result)) return added;
+
+                added++;
+
+            }
+
+            MakePositionMove(position, move, &undo);
+
+        }
+    }
+
+    return added;
+
+}
+
+/*!
+ * \brief Loads the positions of a file
+ * \details A file starting with SELFPLAY_MAGIC is read as self-play records, anything else as EPD or FEN lines each carrying
+ * the result of its game, which should already be quiet, lines without a result are skipped
+ * \param tuner: Run to add to
+ * \param path: File to read
+ * \returns size_t: Positions added
+ */
+size_t LoadTuningFile(Tuner* const tuner, const char* const path)
+{
+
+    STATIC_ASSERT(tuner, "Invalid Tuner Pointer");
+    STATIC_ASSERT(path, "Invalid Path Pointer");
+
+    FILE* file = fopen(path, "rb");
+    char line[TUNE_LINE_MAX];
+    char magic[4];
+    size_t added = 0;
+
+    if(!file) return 0;
+
+    if(fread(magic, 1, sizeof(magic), file) == sizeof(magic) && !memcmp(magic, SELFPLAY_MAGIC, 4))
+    {
+
+        added = LoadTuningRecords(tuner, file);
+        fclose(file);
+
+        return added;
+
+    }
+
+    rewind(file);
+
+    while(fgets(line, sizeof(line), file))
+    {
+
+        Position position[1];
+        const char* rest = SetPositionFromFEN(position, line);
+        uint8_t result = rest? ParseTuningResult(rest): UINT8_MAX;
+
+        if(result == UINT8_MAX) continue;
+
+        if(!AddTuningPosition(tuner, position, result)) break;
+
+        added++;
+
+    }
+
+    fclose(file);
+
+    return added;
+
+}
+
+/*!
+ * \brief Adds up the squared error of a share of the positions and, if asked, its gradient
+ * \details The score of a position is the phase blend of its features plus its pawn terms, and each feature gets back
+ * the error times the slope of the win chance times its share of the blend
+ * \param task: TuningTask to work through
+ * \returns void*: NULL
+ */
+static void* TuningWorker(void* task)
+{
+
+    TuningTask* share = task;
+    const Tuner* tuner = share->tuner;
+    const double* midweights = tuner->weights;
+    const double* endweights = tuner->weights + 6 * 64;
+
+    share->loss = 0;
+
+    for(size_t i = share->start; i < share->end; i++)
+    {
+
+        const TuningPosition* entry = &tuner->positions[i];
+        const uint16_t* features = tuner->features + entry->offset;
+        double midgame = entry->midgame;
+        double endgame = entry->endgame;
+        double phase = entry->phase / (double)PHASE_MAX;
+
+        for(uint8_t f = 0; f < entry->count; f++) // White adds, black takes away
+        {
+
+            double sign = (features[f] >> 9)? 1.0: -1.0;
+            uint16_t weight = features[f] & 511;
+
+            midgame += sign * midweights[weight];
+            endgame += sign * endweights[weight];
+
+        }
+
+        double chance = 1.0 / (1.0 + exp(-share->scale * (midgame * phase + endgame * (1 - phase))));
+        double error = entry->result * 0.5 - chance;
+
+        share->loss += error * error;
+
+        if(!share->gradient) continue;
+
+        double slope = -2.0 * error * chance * (1 - chance) * share->scale;
+
+        for(uint8_t f = 0; f < entry->count; f++)
+        {
+
+            double sign = (features[f] >> 9)? slope: -slope;
+            uint16_t weight = features[f] & 511;
+
+            share->gradient[weight] += sign * phase;
+            share->gradient[6 * 64 + weight] += sign * (1 - phase);
+
+        }
+    }
+
+    return NULL;
+
+}
+
+/*!
+ * \brief Gets the mean loss of every position, splitting them between tasks on the shared thread pool
+ * \param tuner: Positions and weights
+ * \param threads: Threads to use
+ * \param scale: Scale from a score to a win chance
+ * \param gradient: Filled with the mean gradient, NULL to only get the loss
+ * \returns double: Mean squared error of the win chances
+ */
+static double ComputeTuningLoss(const Tuner* const tuner, const uint8_t threads, const double scale, double* const gradient)
+{
+
+    TuningTask tasks[SEARCH_MAX_THREADS];
+    Task workers[SEARCH_MAX_THREADS];
+    ThreadPool* pool = GetThreadPool();
+    double loss = 0;
+
+    static double gradients[SEARCH_MAX_THREADS][TUNE_WEIGHTS]; // One per thread so they never write the same line
+
+    for(uint8_t i = 0; i < threads; i++)
+    {
+
+        tasks[i] = (TuningTask){tuner, tuner->count * i / threads, tuner->count * (i + 1) / threads, scale, 0, gradient? gradients[i]: NULL};
+
+        if(gradient) memset(gradients[i], 0, sizeof(gradients[i]));
+
+        if(i) SubmitTask(pool, &workers[i], TuningWorker, &tasks[i]); // The first share runs here
+
+    }
+
+    TuningWorker(&tasks[0]);
+
+    for(uint8_t i = 1; i < threads; i++)
+        WaitTask(pool, &workers[i]);
+
+    if(gradient) memset(gradient, 0, TUNE_WEIGHTS * sizeof(double));
+
+    for(uint8_t i = 0; i < threads; i++)
+    {
+
+        loss += tasks[i].loss;
+
+        if(gradient)
+            for(size_t w = 0; w < TUNE_WEIGHTS; w++)
+                gradient[w] += gradients[i][w] / tuner->count;
+
+    }
+
+    return loss / tuner->count;
+
+}
+
+/*!
+ * \brief Fits the scale from a score to a win chance to the weights the run starts with, by golden section search
+ * \param tuner: Positions and weights
+ * \param threads: Threads to use
+ * \returns double: Scale with the least loss
+ */
+static double FitTuningScale(const Tuner* const tuner, const uint8_t threads)
+{
+
+    const double ratio = 0.6180339887498949;
+    double low = 0.0;
+    double high = 0.05; // Past ten times the usual 1 / 400 in natural log units
+    double left = high - ratio * (high - low);
+    double right = low + ratio * (high - low);
+    double leftloss = ComputeTuningLoss(tuner, threads, left, NULL);
+    double rightloss = ComputeTuningLoss(tuner, threads, right, NULL);
+
+    for(uint8_t i = 0; i < 40; i++)
+    {
+
+        if(leftloss < rightloss)
+        {
+
+            high = right;
+            right = left;
+            rightloss = leftloss;
+            left = high - ratio * (high - low);
+            leftloss = ComputeTuningLoss(tuner, threads, left, NULL);
+
+        }
+
+        else
+        {
+
+            low = left;
+            left = right;
+            leftloss = rightloss;
+            right = low + ratio * (high - low);
+            rightloss = ComputeTuningLoss(tuner, threads, right, NULL);
+
+        }
+    }
+
+    return (low + high) / 2;
+
+}
+
+/*!
+ * \brief Writes the weights as the tables PieceSquare.c builds with when TUNED_WEIGHTS is defined
+ * \details The value of each type is the mean of its squares, pawns only counting the rows they can stand on, and the tables hold the rest
+ * The king keeps KINGVAL since both sides always have one
+ * \param tuner: Tuned run
+ * \param path: Header to write
+ * \returns bool: True if it was written
+ */
+static bool WriteTunedWeights(const Tuner* const tuner, const char* const path)
+{
+
+    FILE* file = fopen(path, "w");
+
+    if(!file) return false;
+
+    fprintf(file, "/*!\n * \\file TunedWeights.h\n * \\brief Piece values and piece square tables tuned on %zu positions, generated by --tune\n", tuner->count);
+    fprintf(file, " * \\details Included by PieceSquare.c in place of its own tables when built with TUNED_WEIGHTS\n */\n\n");
+    fprintf(file, "#ifndef TUNEDWEIGHTS_H\n#define TUNEDWEIGHTS_H\n");
+
+    for(uint8_t phase = 0; phase < 2; phase++)
+    {
+
+        const double* weights = tuner->weights + phase * 6 * 64;
+        int32_t values[6];
+
+        for(uint8_t type = 0; type < 6; type++)
+        {
+
+            uint8_t first = (type == PawnType)? 8: 0;
+            uint8_t last = (type == PawnType)? 56: 64;
+            double sum = 0;
+
+            for(uint8_t square = first; square < last; square++) sum += weights[type * 64 + square];
+
+            values[type] = (type == KingType)? KINGVAL: (int32_t)lround(sum / (last - first));
+
+        }
+
+        fprintf(file, "\n/// %s value of each piece type in centipawns\nstatic const int16_t %sValues[6] = {%d, %d, %d, %d, %d, %d};\n",
+            phase? "Endgame": "Midgame", phase? "Endgame": "Midgame", values[0], values[1], values[2], values[3], values[4], values[5]);
+
+        fprintf(file, "\n/// %s bonus of each piece type on each square in centipawns, drawn from white's side with the eighth row on top\n", phase? "Endgame": "Midgame");
+        fprintf(file, "static const int16_t %sTables[6][64] =\n{\n", phase? "Endgame": "Midgame");
+
+        for(uint8_t type = 0; type < 6; type++)
+        {
+
+            fprintf(file, "\n    { // %s\n", TypeNames[type]);
+
+            for(uint8_t square = 0; square < 64; square++)
+            {
+
+                bool unused = type == PawnType && (square < 8 || square >= 56); // Pawns never stand on the first or last row
+                int32_t bonus = unused? 0: (int32_t)lround(weights[type * 64 + square]) - values[type];
+
+                fprintf(file, "%s%4d%s", (square % 8)? " ": "        ", bonus, (square == 63)? "\n": (square % 8 == 7)? ",\n": ",");
+
+            }
+
+            fprintf(file, "    }%s\n", (type < 5)? ",": "");
+
+        }
+
+        fprintf(file, "\n};\n");
+
+    }
+
+    fprintf(file, "\n#endif\n\n// EOF //\n");
+
+    return !fclose(file);
+
+}
+
+/*!
+ * \brief Fits the weights to the game results and writes them as a header
+ * \details The scale is fitted first and then held, then every epoch takes one Adam step down the gradient of the mean squared error
+ * between the results and the win chances the scores predict, with the positions split between the threads
+ * \param tuner: Run with the positions loaded
+ * \param threads: Threads to use, zero for one per processor
+ * \param epochs: Passes over every position
+ * \param rate: Step size in centipawns
+ * \param output: Header to write the weights to
+ * \returns bool: True if there were positions and the header was written
+ */
+bool RunTuner(Tuner* const tuner, const uint8_t threads, const uint32_t epochs, const double rate, const char* const output)
+{
+
+    STATIC_ASSERT(tuner, "Invalid Tuner Pointer");
+    STATIC_ASSERT(output, "Invalid Output Pointer");
+
+    uint8_t count = threads? threads: GetOnlineProcessors();
+
+    static double gradient[TUNE_WEIGHTS];
+    static double moment[TUNE_WEIGHTS];
+    static double velocity[TUNE_WEIGHTS];
+
+    if(!tuner->count) return false;
+
+    if(count > SEARCH_MAX_THREADS) count = SEARCH_MAX_THREADS;
+
+    if(count > 1) // The pool's workers take every share but the first for every step, fewer shares if the workers can't be made
+    {
+
+        uint8_t reserved = ReserveWorkers(GetThreadPool(), count - 1);
+
+        if(reserved < count - 1) count = reserved + 1;
+
+    }
+
+    tuner->scale = FitTuningScale(tuner, count);
+
+    fprintf(stderr, "%zu positions, scale %.6f, loss %.6f\n", tuner->count, tuner->scale, ComputeTuningLoss(tuner, count, tuner->scale, NULL));
+
+    memset(moment, 0, sizeof(moment));
+    memset(velocity, 0, sizeof(velocity));
+
+    for(uint32_t epoch = 1; epoch <= epochs; epoch++)
+    {
+
+        double loss = ComputeTuningLoss(tuner, count, tuner->scale, gradient);
+        double first = 1 - pow(0.9, epoch); // Bias corrections of the running means
+        double second = 1 - pow(0.999, epoch);
+
+        for(size_t w = 0; w < TUNE_WEIGHTS; w++)
+        {
+
+            moment[w] = 0.9 * moment[w] + 0.1 * gradient[w];
+            velocity[w] = 0.999 * velocity[w] + 0.001 * gradient[w] * gradient[w];
+
+            tuner->weights[w] -= rate * (moment[w] / first) / (sqrt(velocity[w] / second) + 1e-12);
+
+        }
+
+        if(epoch % 10 == 0 || epoch == epochs) fprintf(stderr, "epoch %u loss %.6f\n", epoch, loss);
+
+    }
+
+    return WriteTunedWeights(tuner, output);
+
+}
+
+// EOF //
@@ -0,0 +1,462 @@
+/*!
+ * \file UCI.c
+ * \author Sunshine Jennings (smjennin@uci.edu)
+ * \brief Contains the implementation of the UCI Module of Ultimate Chess
+ * \version 1.0
+ * \date 2021-05-30
+ * \copyright Copyright (c) 2021
+ */
+
+// ------------------------- Dependencies ------------------------- //
+
+#define _POSIX_C_SOURCE 200809L // strtok_r isn't part of plain C99
+
+#include "UCI.h"
+#include "Notation.h"
+
+#include <stdarg.h>
+
+// ------------------------- Globals ------------------------- //
+
+/// Keeps the lines of the search thread and the command thread from mixing
+static pthread_mutex_t OutputLock = PTHREAD_MUTEX_INITIALIZER;
+
+// ------------------------- Functions ------------------------- //
+
+/// Sends a line to the GUI
+static void SendLine(const char* const format, ...);
+
+/// Writes a score the way UCI wants it
+static void FormatScore(char* const buffer, const size_t size, const int32_t score);
+
+/// Sends the info line of a finished iteration
+static void SendInfo(const SearchResult* const result);
+
+/// Runs a search on its own thread and sends the best move
+static void* UCISearch(void* engine);
+
+/// Stops the running search and waits for it
+static void StopSearching(UCIEngine* const engine);
+
+/// Handles a position command
+static void SetUCIPosition(UCIEngine* const engine, char* const arguments);
+
+/// Handles a go command
+static void StartSearching(UCIEngine* const engine, char* const arguments);
+
+/// Handles a setoption command
+static void SetUCIOption(UCIEngine* const engine, char* const arguments);
+
+// ------------------------- Definintions ------------------------- //
+
+/*!
+ * \brief Sends a line to the GUI, flushed right away since the GUI waits for it
+ * \param format: printf format of the line, without the newline
+ */
+static void SendLine(const char* const format, ...)
+{
+
+    va_list arguments;
+
+    va_start(arguments, format);
+    pthread_mutex_lock(&OutputLock);
+
+    vprintf(format, arguments);
+    putchar('\n');
+    fflush(stdout);
+
+    pthread_mutex_unlock(&OutputLock);
+    va_end(arguments);
+
+}
+
+/*!
+ * \brief Writes a score as centipawns, or as moves to mate
+ * \param buffer: Buffer to write to
+ * \param size: Size of the buffer
+ * \param score: Score for the side to move
+ */
+static void FormatScore(char* const buffer, const size_t size, const int32_t score)
+{
+
+    if(score >= MATE_BOUND) snprintf(buffer, size, "mate %d", (MATE_SCORE - score + 1) / 2);
+
+    else if(score <= -MATE_BOUND) snprintf(buffer, size, "mate %d", -(MATE_SCORE + score) / 2);
+
+    else snprintf(buffer, size, "cp %d", score);
+
+}
+
+/*!
+ * \brief Sends the info line of a finished iteration
+ * \param result: Result of the iteration with the nodes and time so far
+ */
+static void SendInfo(const SearchResult* const result)
+{
+
+    char line[64 + MAX_PLY * UCI_LENGTH];
+    char score[24];
+    size_t length;
+
+    FormatScore(score, sizeof(score), result->score);
+
+    length = (size_t)snprintf(line, sizeof(line), "info depth %u seldepth %u score %s nodes %llu nps %llu tbhits %llu time %u pv",
+        result->depth, result->stats.seldepth, score, (unsigned long long)result->nodes,
+        (unsigned long long)(result->nodes * 1000 / (result->time? result->time: 1)), (unsigned long long)result->tbhits, result->time);
+
+    for(uint8_t i = 0; i < result->pvlength && length + UCI_LENGTH + 1 < sizeof(line); i++)
+    {
+
+        line[length++] = ' ';
+        length += MoveToUCI(result->pv[i], line + length);
+
+    }
+
+    line[length] = '\0';
+
+    SendLine("%s", line);
+
+}
+
+/*!
+ * \brief Runs a search on its own thread and sends the best move once it is done
+ * \details An infinite search holds the best move back until it is told to stop
+ * \param engine: Engine with the position and limits to search
+ * \returns void*: NULL
+ */
+static void* UCISearch(void* engine)
+{
+
+    UCIEngine* uci = engine;
+    SearchResult result = SearchPosition(uci->position, uci->limits, uci->table);
+    char best[UCI_LENGTH] = "0000";
+    char ponder[UCI_LENGTH];
+
+    if(uci->infinite) // The GUI has to say stop first
+    {
+
+        pthread_mutex_lock(&uci->lock);
+
+        while(!uci->stop) pthread_cond_wait(&uci->stopped, &uci->lock);
+
+        pthread_mutex_unlock(&uci->lock);
+
+    }
+
+    if(uci->table) // Final line with every thread's nodes and how full the table is
+    {
+
+        char score[24];
+
+        FormatScore(score, sizeof(score), result.score);
+        SendLine("info depth %u seldepth %u score %s nodes %llu nps %llu tbhits %llu hashfull %u time %u", result.depth, result.stats.seldepth, score,
+            (unsigned long long)result.nodes, (unsigned long long)(result.nodes * 1000 / (result.time? result.time: 1)),
+            (unsigned long long)result.tbhits, GetTableUsage(uci->table), result.time);
+
+    }
+
+    if(result.best.piece) MoveToUCI(result.best, best);
+
+    if(result.pvlength > 1)
+    {
+
+        MoveToUCI(result.pv[1], ponder);
+        SendLine("bestmove %s ponder %s", best, ponder);
+
+    }
+
+    else SendLine("bestmove %s", best);
+
+    return NULL;
+
+}
+
+/*!
+ * \brief Stops the running search and waits for it to send its move
+ * \param engine: Engine to stop, nothing happens if it isn't searching
+ */
+static void StopSearching(UCIEngine* const engine)
+{
+
+    if(!engine->searching) return;
+
+    pthread_mutex_lock(&engine->lock);
+
+    __atomic_store_n(&engine->stop, true, __ATOMIC_RELAXED);
+    pthread_cond_signal(&engine->stopped);
+
+    pthread_mutex_unlock(&engine->lock);
+
+    pthread_join(engine->thread, NULL);
+
+    engine->searching = false;
+
+}
+
+/*!
+ * \brief Handles a position command, "startpos" or "fen ..." then optionally "moves ..."
+ * \param engine: Engine to set up
+ * \param arguments: Everything after the command
+ */
+static void SetUCIPosition(UCIEngine* const engine, char* const arguments)
+{
+
+    char* moves = strstr(arguments, "moves");
+    char* fen = strstr(arguments, "fen");
+    char* save;
+
+    if(moves) *moves = '\0'; // The FEN ends where the moves start
+
+    if(fen)
+    {
+
+        if(!SetPositionFromFEN(engine->position, fen + 3)) ResetPosition(engine->position); // Better a position than none
+
+    }
+
+    else ResetPosition(engine->position);
+
+    engine->keycount = 0;
+
+    if(!moves) return;
+
+    for(char* token = strtok_r(moves + 5, " \t\r\n", &save); token; token = strtok_r(NULL, " \t\r\n", &save))
+    {
+
+        PositionUndo undo;
+        Move move = UCIToMove(engine->position, NULL, token);
+
+        if(!move.piece) break; // Nothing after an illegal move can be played
+
+        if(engine->keycount == SEARCH_MAX_HISTORY) // Too old to repeat anyway, drop the oldest
+            memmove(engine->keys, engine->keys + 1, --engine->keycount * sizeof(uint64_t));
+
+        engine->keys[engine->keycount++] = engine->position->key;
+
+        MakePositionMove(engine->position, move, &undo);
+
+        if(!engine->position->halfmove) engine->keycount = 0; // Nothing before a capture or pawn move can come up again
+
+    }
+}
+
+/*!
+ * \brief Handles a go command and starts the search
+ * \details A movetime is used as is, a clock is spread over the moves to go and most of the increment is spent
+ * \param engine: Engine to search with
+ * \param arguments: Everything after the command
+ */
+static void StartSearching(UCIEngine* const engine, char* const arguments)
+{
+
+    SearchLimits limits = GetDepthLimits(0);
+    uint64_t clock[2] = {0, 0};
+    uint64_t increment[2] = {0, 0};
+    uint64_t movestogo = 0;
+    char* save;
+
+    StopSearching(engine);
+
+    engine->infinite = false;
+
+    for(char* token = strtok_r(arguments, " \t\r\n", &save); token; token = strtok_r(NULL, " \t\r\n", &save))
+    {
+
+        if(!strcmp(token, "infinite") || !strcmp(token, "ponder"))
+        {
+
+            engine->infinite = true;
+            continue;
+
+        }
+
+        char* value = strtok_r(NULL, " \t\r\n", &save); // Everything else takes a number
+
+        if(!value) break;
+
+        uint64_t number = strtoull(value, NULL, 10);
+
+        if(!strcmp(token, "depth")) limits.depth = (number < MAX_PLY)? (uint8_t)number: MAX_PLY - 1;
+        else if(!strcmp(token, "nodes")) limits.nodes = number;
+        else if(!strcmp(token, "movetime")) limits.time = (uint32_t)number;
+        else if(!strcmp(token, "wtime")) clock[WHITE] = number;
+        else if(!strcmp(token, "btime")) clock[BLACK] = number;
+        else if(!strcmp(token, "winc")) increment[WHITE] = number;
+        else if(!strcmp(token, "binc")) increment[BLACK] = number;
+        else if(!strcmp(token, "movestogo")) movestogo = number;
+
+    }
+
+    bool side = engine->position->isWhite;
+
+    if(!limits.time && clock[side] && !engine->infinite) // Playing on a clock
+    {
+
+        uint64_t left = (clock[side] > UCI_MOVE_OVERHEAD)? clock[side] - UCI_MOVE_OVERHEAD: 1;
+        uint64_t time = left / (movestogo? movestogo: UCI_MOVES_TO_GO) + increment[side] * 3 / 4;
+
+        limits.time = (uint32_t)((time < left)? time: left);
+
+        if(!limits.time) limits.time = 1;
+
+    }
+
+    if(engine->infinite) // Only stop ends it
+    {
+
+        limits.depth = 0;
+        limits.nodes = 0;
+        limits.time = 0;
+
+    }
+
+    limits.threads = engine->threads;
+    limits.pruning = engine->pruning;
+    limits.network = engine->network;
+    limits.tablebase = engine->tablebase;
+    limits.stop = &engine->stop;
+    limits.report = SendInfo;
+    limits.keys = engine->keys;
+    limits.keycount = engine->keycount;
+
+    engine->limits = limits;
+    engine->stop = false;
+
+    if(pthread_create(&engine->thread, NULL, UCISearch, engine)) // No thread to be had, search here and send the move right away
+    {
+
+        engine->infinite = false;
+        UCISearch(engine);
+        return;
+
+    }
+
+    engine->searching = true;
+
+}
+
+/*!
+ * \brief Handles a setoption command, only Hash and Threads are offered
+ * \param engine: Engine to change
+ * \param arguments: Everything after the command, "name X value Y"
+ */
+static void SetUCIOption(UCIEngine* const engine, char* const arguments)
+{
+
+    char* name = strstr(arguments, "name");
+    char* value = strstr(arguments, "value");
+
+    if(!name || !value) return;
+
+    long number = strtol(value + 5, NULL, 10);
+
+    name += 4;
+
+    while(*name == ' ') name++;
+
+    StopSearching(engine); // Nothing may change under a search
+
+    if(!strncmp(name, "Hash", 4) && number > 0)
+    {
+
+        engine->hash = (number > UCI_MAX_HASH)? UCI_MAX_HASH: (uint16_t)number;
+
+        DeleteTable(engine->table);
+        engine->table = CreateTable(engine->hash);
+
+    }
+
+    else if(!strncmp(name, "Threads", 7) && number > 0) engine->threads = (number > SEARCH_MAX_THREADS)? SEARCH_MAX_THREADS: (uint8_t)number;
+
+}
+
+/*!
+ * \brief Runs the engine over the UCI protocol
+ * \details Reads commands from stdin until quit or the end of the input, the search runs on its own thread while commands keep coming
+ * The hash size, thread count, pruning, network and tablebase of the settings are where the engine starts
+ * \param settings: Settings from the command line
+ */
+void RunUCI(const Settings* const settings)
+{
+
+    STATIC_ASSERT(settings, "Invalid Settings Pointer");
+
+    static UCIEngine engine[1]; // Holds a position and a full search result, too big for the stack
+    static char line[UCI_LINE_MAX];
+
+    engine->hash = GetHashSize(settings)? GetHashSize(settings): 1;
+    engine->threads = GetSearchThreads(settings)? GetSearchThreads(settings): 1;
+    engine->pruning = GetSearchPruning(settings);
+    engine->table = CreateTable(engine->hash);
+    engine->network = CreateNetwork(GetNetworkFile(settings));
+    engine->tablebase = CreateTablebase(GetTablebaseDirectory(settings));
+    engine->searching = false;
+
+    pthread_mutex_init(&engine->lock, NULL);
+    pthread_cond_init(&engine->stopped, NULL);
+
+    ResetPosition(engine->position);
+
+    while(fgets(line, sizeof(line), stdin))
+    {
+
+        char* command = line;
+
+        while(*command == ' ' || *command == '\t') command++;
+
+        char* arguments = command + strcspn(command, " \t\r\n");
+
+        if(*arguments) *arguments++ = '\0';
+
+        if(!strcmp(command, "uci"))
+        {
+
+            SendLine("id name Ultimate Chess");
+            SendLine("id author Team 14");
+            SendLine("option name Hash type spin default %u min 1 max %u", engine->hash, UCI_MAX_HASH);
+            SendLine("option name Threads type spin default %u min 1 max %u", engine->threads, SEARCH_MAX_THREADS);
+            SendLine("uciok");
+
+        }
+
+        else if(!strcmp(command, "isready")) SendLine("readyok");
+
+        else if(!strcmp(command, "ucinewgame"))
+        {
+
+            StopSearching(engine);
+
+            if(engine->table) ClearTable(engine->table); // Nothing from the last game applies
+
+        }
+
+        else if(!strcmp(command, "position"))
+        {
+
+            StopSearching(engine);
+            SetUCIPosition(engine, arguments);
+
+        }
+
+        else if(!strcmp(command, "go")) StartSearching(engine, arguments);
+
+        else if(!strcmp(command, "stop") || !strcmp(command, "ponderhit")) StopSearching(engine); // Pondering isn't offered, a hit just ends it
+
+        else if(!strcmp(command, "setoption")) SetUCIOption(engine, arguments);
+
+        else if(!strcmp(command, "quit")) break;
+
+    }
+
+    StopSearching(engine);
+
+    pthread_cond_destroy(&engine->stopped);
+    pthread_mutex_destroy(&engine->lock);
+
+    DeleteTable(engine->table);
+    DeleteNetwork((Network*)engine->network);
+    DeleteTablebase((Tablebase*)engine->tablebase);
+
+}
+
+// EOF //
@@ -28,6 +28,12 @@
 #include "Gameplay.h"
 #include "AI.h"
 #include "Moves.h"
+#include "Bench.h"
+#include "Analysis.h"
+#include "UCI.h"
+#include "SelfPlay.h"
+#include "Tuner.h"
+#include "Retrograde.h"
 
 // ------------------------- Definition ------------------------- //
 
@@ -94,6 +100,164 @@ int main(int argc, char** kwargs)
         GameData data;
         ResetGameData(&data);
 
+        for(int i = 1; i < argc; i++) // Command line options
+        {
+
+            if(!strcmp("--hash", kwargs[i]) && i + 1 < argc) SetHashSize(GetSettings(&data), (uint16_t)atoi(kwargs[++i])); // Transposition table size in MB
+            else if(!strcmp("--threads", kwargs[i]) && i + 1 < argc) SetSearchThreads(GetSettings(&data), (uint8_t)atoi(kwargs[++i])); // Search threads of the harder AIs
+            else if(!strcmp("--nnue", kwargs[i]) && i + 1 < argc) SetNetworkFile(GetSettings(&data), kwargs[++i]); // Weights of the Impossible AI's network
+            else if(!strcmp("--book", kwargs[i]) && i + 1 < argc) SetBookFile(GetSettings(&data), kwargs[++i]); // Opening book of every AI
+            else if(!strcmp("--tb", kwargs[i]) && i + 1 < argc) SetTablebaseDirectory(GetSettings(&data), kwargs[++i]); // Endgame tables of every AI
+            else if(!strcmp("--difficulty", kwargs[i]) && i + 1 < argc) SetAIDifficulty(GetSettings(&data), (uint8_t)atoi(kwargs[++i])); // Difficulty of every AI, 0 for Novice to 5 for Impossible
+            else if(!strcmp("--stats", kwargs[i])) SetPrintStats(GetSettings(&data), true); // Counters of every AI search on stderr
+            else if(!strcmp("--pruning", kwargs[i]) && i + 1 < argc) SetSearchPruning(GetSettings(&data), (uint8_t)strtol(kwargs[++i], NULL, 0)); // PRUNE flags of the AIs' searches
+
+            else if(!strcmp("--scaling", kwargs[i])) // Prints the time to depth from 1 to 32 threads instead of playing
+            {
+
+                RunScalingBench(stdout, (i + 1 < argc)? (uint8_t)atoi(kwargs[i + 1]): 0);
+                return 0;
+
+            }
+
+            else if(!strcmp("--bench", kwargs[i])) // Prints the nodes and time to depth with each pruning technique on and off instead of playing
+            {
+
+                RunPruningBench(stdout, (i + 1 < argc)? (uint8_t)atoi(kwargs[i + 1]): 0);
+                return 0;
+
+            }
+
+            else if(!strcmp("--perft", kwargs[i])) // Checks the move generator and notation against known perft counts instead of playing
+                return RunPerftCheck(stdout, (i + 1 < argc)? (uint8_t)atoi(kwargs[i + 1]): 0)? 0: 1;
+
+            else if(!strcmp("--bookkeys", kwargs[i])) // Checks the opening book keys against the Polyglot test positions instead of playing
+                return RunBookKeyCheck(stdout)? 0: 1;
+
+            else if(!strcmp("--tbcheck", kwargs[i]) && i + 1 < argc) // Checks the endgame table generator against the known longest distances instead of playing
+                return RunTablebaseCheck(stdout, kwargs[i + 1], GetSearchThreads(GetSettings(&data)))? 0: 1;
+
+            else if(!strcmp("--uci", kwargs[i])) // Talks UCI on stdin and stdout instead of showing the menu
+            {
+
+                RunUCI(GetSettings(&data));
+                return 0;
+
+            }
+
+            else if(!strcmp("--selfplay", kwargs[i]) && i + 1 < argc) // Plays a headless match between two engines instead of playing
+            {
+
+                static SelfPlay match; // Two engines with their paths, too big for the stack
+                const char* records = NULL;
+                uint8_t concurrency = 0;
+
+                ResetSelfPlayEngine(&match.engines[0], GetSettings(&data));
+                ResetSelfPlayEngine(&match.engines[1], GetSettings(&data));
+
+                match.games = (uint32_t)atoi(kwargs[++i]);
+                match.random = SELFPLAY_RANDOM_PLIES;
+                match.seed = 1;
+
+                for(i++; i < argc; i++) // Options of the match follow the game count
+                {
+
+                    if(!strcmp("--concurrency", kwargs[i]) && i + 1 < argc) concurrency = (uint8_t)atoi(kwargs[++i]);
+                    else if(!strcmp("--random", kwargs[i]) && i + 1 < argc) match.random = (uint8_t)atoi(kwargs[++i]);
+                    else if(!strcmp("--seed", kwargs[i]) && i + 1 < argc) match.seed = strtoull(kwargs[++i], NULL, 0);
+                    else if(!strcmp("--records", kwargs[i]) && i + 1 < argc) records = kwargs[++i];
+
+                    else if((!strcmp("--engine1", kwargs[i]) || !strcmp("--engine2", kwargs[i])) && i + 1 < argc)
+                    {
+
+                        if(!ParseSelfPlayEngine(&match.engines[kwargs[i][8] - '1'], kwargs[i + 1]))
+                        {
+
+                            fprintf(stderr, "Bad engine spec %s\n", kwargs[i + 1]);
+                            return 1;
+
+                        }
+
+                        i++;
+
+                    }
+                }
+
+                return RunSelfPlay(&match, concurrency, records, stdout)? 0: 1;
+
+            }
+
+            else if(!strcmp("--analyze", kwargs[i]) && i + 1 < argc) // Analyzes every EPD or FEN line of a file on every core instead of playing
+            {
+
+                const char* input = kwargs[++i];
+                const char* output = NULL;
+                AnalysisFormat format = AnalysisCSV;
+                SearchLimits limits = GetDepthLimits(0);
+
+                for(i++; i < argc; i++) // Options of the analysis follow the file
+                {
+
+                    if(!strcmp("--depth", kwargs[i]) && i + 1 < argc) limits.depth = (uint8_t)atoi(kwargs[++i]);
+                    else if(!strcmp("--movetime", kwargs[i]) && i + 1 < argc) limits.time = (uint32_t)atoi(kwargs[++i]);
+                    else if(!strcmp("--output", kwargs[i]) && i + 1 < argc) output = kwargs[++i];
+                    else if(!strcmp("--json", kwargs[i])) format = AnalysisJSON;
+
+                }
+
+                return RunAnalysis(GetSettings(&data), input, output, format, limits)? 0: 1;
+
+            }
+
+            else if(!strcmp("--tune", kwargs[i]) && i + 1 < argc) // Tunes the piece values and tables on the games of files instead of playing
+            {
+
+                Tuner* tuner = CreateTuner();
+                const char* output = TUNE_OUTPUT;
+                uint32_t epochs = TUNE_EPOCHS;
+                double rate = TUNE_RATE;
+                bool tuned;
+
+                if(!tuner) return 1;
+
+                for(i++; i < argc; i++) // Files and options of the run follow
+                {
+
+                    if(!strcmp("--epochs", kwargs[i]) && i + 1 < argc) epochs = (uint32_t)atoi(kwargs[++i]);
+                    else if(!strcmp("--rate", kwargs[i]) && i + 1 < argc) rate = atof(kwargs[++i]);
+                    else if(!strcmp("--output", kwargs[i]) && i + 1 < argc) output = kwargs[++i];
+                    else if(strncmp("--", kwargs[i], 2)) fprintf(stderr, "%zu positions from %s\n", LoadTuningFile(tuner, kwargs[i]), kwargs[i]);
+
+                }
+
+                tuned = RunTuner(tuner, GetSearchThreads(GetSettings(&data)), epochs, rate, output);
+                DeleteTuner(tuner);
+
+                return tuned? 0: 1;
+
+            }
+
+            else if(!strcmp("--tbgen", kwargs[i]) && i + 2 < argc) // Generates endgame tables instead of playing
+            {
+
+                const char* directory = kwargs[++i];
+                bool generated = true;
+
+                for(i++; i < argc && generated; i++) // Materials like KQvKR or piece counts like 4 follow the directory
+                {
+
+                    if(isdigit((unsigned char)kwargs[i][0])) generated = GenerateTablebases(directory, (uint8_t)atoi(kwargs[i]), GetSearchThreads(GetSettings(&data)), stdout);
+                    else generated = GenerateTablebase(directory, kwargs[i], GetSearchThreads(GetSettings(&data)), stdout);
+
+                    if(!generated) fprintf(stderr, "Couldn't generate %s into %s\n", kwargs[i], directory);
+
+                }
+
+                return generated? 0: 1;
+
+            }
+        }
+
         while(1) // Loops indefinitely
         {
         
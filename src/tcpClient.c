@@ -345,7 +345,7 @@ Move ReceiveMoveClient (char *hostname,int PortNo, int DataFD)
     char SendBuf[256];	/* message buffer for sending a message */
     char RecvBuf[256];	/* message buffer for receiving a response */
 
-	Move move;
+	Move move = CreateMove(EMPTY, 0, 0); // The promotion is asked for when the move is made
 
     SocketFD = DataFD;
 